@@ -0,0 +1,158 @@
+/*
+ * batch_predicates.cpp
+ * Demonstrates the batch isEven / isPowerOfTwo kernels from batch_predicates.h.
+ * Definition: clean_code_examples.cpp answers one question per call (isEven_Bitwise(n)). When a
+ * whole column of values must be filtered, the batch kernels answer 8 or 16 questions per
+ * instruction and hand back a bitmask, a count or the matching values themselves.
+ * Shows: masks, counts and compaction on a small array, then a benchmark of the per-element
+ * functions from clean_code_examples.cpp (modulus, bitwise, log2, iterative) against the batch
+ * kernels at every SIMD level this CPU supports.
+ * Values stay within +/- 2^30: isPowerOfTwo_Iterative doubles an int and never terminates above 2^30.
+ * Run this file independently to see batch predicates in action.
+ * Usage: ./batch_predicates [number_of_values]   (default 16000000)
+ */
+#define CLEAN_CODE_EXAMPLES_NO_MAIN
+#include "clean_code_examples.cpp"   // isEven_Modulus, isPowerOfTwo_Log, ...
+#include <vector>
+#include <algorithm>   // for equal
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include <cstdlib>
+#include "batch_predicates.h"
+
+// -------------------------------------------------
+// 1. BENCHMARK HELPERS
+// -------------------------------------------------
+
+using Clock = chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start) {
+    return chrono::duration<double, milli>(Clock::now() - start).count();
+}
+
+// Random values in +/- 2^30 with every fourth value a power of two, so both predicates hit often
+vector<int32_t> makeValues(size_t count) {
+    mt19937 rng(44);
+    uniform_int_distribution<int32_t> value(-(1 << 30), 1 << 30);
+    uniform_int_distribution<int> exponent(0, 30);
+    vector<int32_t> values(count);
+    for (size_t i = 0; i < count; ++i) values[i] = (i % 4 == 0) ? (1 << exponent(rng)) : value(rng);
+    return values;
+}
+
+// Count matches one call at a time, the way clean_code_examples.cpp is used
+size_t countPerElement(bool (*test)(int), const vector<int32_t>& values) {
+    size_t hits = 0;
+    for (int32_t x : values) hits += test(x);
+    return hits;
+}
+
+void printRow(const string& label, double ms, size_t count, size_t hits) {
+    cout << label << string(label.size() < 36 ? 36 - label.size() : 1, ' ') << ms << "  "
+         << count / ms / 1e3 << "  " << hits << endl;
+}
+
+// -------------------------------------------------
+// 2. BENCHMARK
+// -------------------------------------------------
+
+// Returns: false if the implementations disagree (also reported on cerr)
+bool runBenchmark(size_t count) {
+    cout << "\n=== BENCHMARK: " << count << " values ===" << endl;
+    vector<int32_t> values = makeValues(count);
+    vector<uint64_t> mask(maskWords(count));
+    vector<int32_t> compacted(count);   // touched before timing
+    bool same = true;
+
+    struct Scalar { const char* name; bool (*test)(int); BitPredicate predicate; };
+    const Scalar scalars[] = {
+        {"isEven_Modulus", isEven_Modulus, BitPredicate::EVEN},
+        {"isEven_Bitwise", isEven_Bitwise, BitPredicate::EVEN},
+        {"isPowerOfTwo_Log", isPowerOfTwo_Log, BitPredicate::POWER_OF_TWO},
+        {"isPowerOfTwo_Iterative", isPowerOfTwo_Iterative, BitPredicate::POWER_OF_TWO},
+        {"isPowerOfTwo_Bitwise", isPowerOfTwo_Bitwise, BitPredicate::POWER_OF_TWO},
+    };
+
+    cout << "Kernel                              ms  Melem/s  matches" << endl;
+    size_t expected[2] = {0, 0};
+    for (const Scalar& scalar : scalars) {
+        auto start = Clock::now();
+        size_t hits = countPerElement(scalar.test, values);
+        printRow(string("per element ") + scalar.name, elapsedMs(start), count, hits);
+        size_t& reference = expected[scalar.predicate == BitPredicate::EVEN ? 0 : 1];
+        if (reference == 0) reference = hits;
+        same = same && reference == hits;
+    }
+
+    const SimdLevel levels[] = {SimdLevel::SCALAR, SimdLevel::AVX2, SimdLevel::AVX512};
+    for (BitPredicate predicate : {BitPredicate::EVEN, BitPredicate::POWER_OF_TWO}) {
+        const char* name = (predicate == BitPredicate::EVEN) ? "even" : "power of two";
+        size_t reference = expected[predicate == BitPredicate::EVEN ? 0 : 1];
+        vector<int32_t> referenceValues;
+        for (SimdLevel level : levels) {
+            if (usableLevel(level) != level) continue;
+            string suffix = string(" ") + name + " (" + simdLevelName(level) + ")";
+
+            auto start = Clock::now();
+            size_t hits = predicateMask(predicate, values.data(), count, mask.data(), level);
+            printRow("mask" + suffix, elapsedMs(start), count, hits);
+            same = same && hits == reference && popcountMask(mask.data(), mask.size()) == reference;
+
+            start = Clock::now();
+            hits = countMatches(predicate, values.data(), count, level);
+            printRow("count" + suffix, elapsedMs(start), count, hits);
+            same = same && hits == reference;
+
+            start = Clock::now();
+            hits = compactMatches(predicate, values.data(), count, compacted.data(), level);
+            printRow("compact" + suffix, elapsedMs(start), count, hits);
+            same = same && hits == reference;
+            if (referenceValues.empty()) {
+                referenceValues.assign(compacted.begin(), compacted.begin() + hits);
+            } else {
+                same = same && equal(referenceValues.begin(), referenceValues.end(), compacted.begin());
+            }
+        }
+    }
+    if (!same) cerr << "Mismatch between implementations!" << endl;
+    return same;
+}
+
+int main(int argc, char* argv[]) {
+    vector<int32_t> values = {0, 1, 2, 3, 4, 6, 8, -8, 12, 16, 31, 32, -1, 64, 1 << 30, 1000};
+
+    // Bitmask: bit i is set when values[i] is even
+    vector<uint64_t> evenMask = predicateMask(BitPredicate::EVEN, values);
+    cout << "Values:     ";
+    for (int32_t x : values) cout << x << " ";
+    cout << "\nEven mask:  ";
+    for (size_t i = 0; i < values.size(); ++i) cout << ((evenMask[0] >> i) & 1);
+    cout << "  (" << popcountMask(evenMask.data(), evenMask.size()) << " even)" << endl;
+
+    // Count without storing anything
+    cout << "Powers of two: " << countMatches(BitPredicate::POWER_OF_TWO, values.data(), values.size()) << endl;
+
+    // Compaction: only the matching values, in their original order
+    cout << "Compacted powers of two: ";
+    for (int32_t x : compactMatches(BitPredicate::POWER_OF_TWO, values)) cout << x << " ";
+    cout << endl;
+
+    // Same answers as the one-at-a-time functions
+    bool agrees = true;
+    for (int32_t x : values) {
+        agrees = agrees && matches(BitPredicate::EVEN, x) == isEven_Bitwise(x)
+                 && matches(BitPredicate::POWER_OF_TWO, x) == isPowerOfTwo_Bitwise(x);
+    }
+    cout << "Agrees with clean_code_examples.cpp: " << (agrees ? "yes" : "NO") << endl;
+    if (!agrees) {
+        cerr << "Mismatch between implementations!" << endl;
+        return 1;
+    }
+    cout << "Widest SIMD level: " << simdLevelName(bestSimdLevel()) << endl;
+
+    size_t count = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 16000000;
+    if (!runBenchmark(count)) return 1;
+
+    return 0;
+}
@@ -0,0 +1,289 @@
+/*
+ * batch_predicates.h
+ * Batch versions of isEven and isPowerOfTwo from clean_code_examples.cpp for whole integer columns.
+ * Definition: Instead of one function call per value, a batch kernel tests 8 (AVX2) or 16
+ * (AVX-512) values per instruction with the same bit tricks:
+ *   even:         (x & 1) == 0
+ *   power of two: x > 0 && (x & (x - 1)) == 0
+ * and produces either a bitmask (bit i set when values[i] matches), a count (popcount of the
+ * lane masks), or a compacted copy of the matching values (AVX-512 VPCOMPRESSD, or an AVX2
+ * permute driven by a lookup table of 256 shuffles).
+ * The instruction set is picked at runtime; every kernel also has a scalar version, and a level
+ * can be forced to compare them.
+ */
+#ifndef BATCH_PREDICATES_H
+#define BATCH_PREDICATES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define PREDICATES_X86 1
+#endif
+
+enum class BitPredicate { EVEN, POWER_OF_TWO };
+
+enum class SimdLevel { SCALAR, AVX2, AVX512 };
+
+inline const char* simdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::AVX512: return "AVX-512";
+        case SimdLevel::AVX2: return "AVX2";
+        default: return "scalar";
+    }
+}
+
+// Widest instruction set this CPU supports
+inline SimdLevel bestSimdLevel() {
+#ifdef PREDICATES_X86
+    static const SimdLevel level = __builtin_cpu_supports("avx512f") ? SimdLevel::AVX512
+                                 : __builtin_cpu_supports("avx2")    ? SimdLevel::AVX2
+                                                                     : SimdLevel::SCALAR;
+    return level;
+#else
+    return SimdLevel::SCALAR;
+#endif
+}
+
+// Requested level, lowered to what the CPU supports
+inline SimdLevel usableLevel(SimdLevel requested) {
+    SimdLevel best = bestSimdLevel();
+    return static_cast<int>(requested) < static_cast<int>(best) ? requested : best;
+}
+
+inline bool matches(BitPredicate predicate, int32_t x) {
+    if (predicate == BitPredicate::EVEN) return (x & 1) == 0;
+    return x > 0 && (x & (x - 1)) == 0;
+}
+
+// Words needed for a bitmask over count values
+inline size_t maskWords(size_t count) {
+    return (count + 63) / 64;
+}
+
+// -------------------------------------------------
+// 1. SCALAR KERNELS
+// -------------------------------------------------
+
+inline size_t predicateMaskScalar(BitPredicate predicate, const int32_t* values, size_t from, size_t count, uint64_t* mask) {
+    size_t hits = 0;
+    for (size_t i = from; i < count; ++i) {
+        if (matches(predicate, values[i])) {
+            mask[i / 64] |= uint64_t(1) << (i % 64);
+            ++hits;
+        }
+    }
+    return hits;
+}
+
+inline size_t countMatchesScalar(BitPredicate predicate, const int32_t* values, size_t from, size_t count) {
+    size_t hits = 0;
+    for (size_t i = from; i < count; ++i) hits += matches(predicate, values[i]);
+    return hits;
+}
+
+inline size_t compactScalar(BitPredicate predicate, const int32_t* values, size_t from, size_t count, int32_t* out) {
+    size_t written = 0;
+    for (size_t i = from; i < count; ++i) {
+        out[written] = values[i];
+        written += matches(predicate, values[i]);
+    }
+    return written;
+}
+
+// -------------------------------------------------
+// 2. AVX2 KERNELS (8 lanes)
+// -------------------------------------------------
+
+#ifdef PREDICATES_X86
+__attribute__((target("avx2")))
+inline unsigned laneMaskAvx2(BitPredicate predicate, __m256i x) {
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i hit;
+    if (predicate == BitPredicate::EVEN) {
+        hit = _mm256_cmpeq_epi32(_mm256_and_si256(x, _mm256_set1_epi32(1)), zero);
+    } else {
+        __m256i single = _mm256_cmpeq_epi32(_mm256_and_si256(x, _mm256_sub_epi32(x, _mm256_set1_epi32(1))), zero);
+        hit = _mm256_and_si256(single, _mm256_cmpgt_epi32(x, zero));
+    }
+    return unsigned(_mm256_movemask_ps(_mm256_castsi256_ps(hit)));
+}
+
+__attribute__((target("avx2")))
+inline size_t predicateMaskAvx2(BitPredicate predicate, const int32_t* values, size_t count, uint64_t* mask) {
+    size_t hits = 0, i = 0;
+    for (; i + 64 <= count; i += 64) {
+        uint64_t word = 0;
+        for (int group = 0; group < 8; ++group) {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i + group * 8));
+            word |= uint64_t(laneMaskAvx2(predicate, x)) << (group * 8);
+        }
+        mask[i / 64] = word;
+        hits += size_t(__builtin_popcountll(word));
+    }
+    return hits + predicateMaskScalar(predicate, values, i, count, mask);
+}
+
+__attribute__((target("avx2,popcnt")))
+inline size_t countMatchesAvx2(BitPredicate predicate, const int32_t* values, size_t count) {
+    size_t hits = 0, i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+        hits += size_t(_mm_popcnt_u32(laneMaskAvx2(predicate, x)));
+    }
+    return hits + countMatchesScalar(predicate, values, i, count);
+}
+
+// Row m holds the lane indices of the set bits of m, lowest first
+struct CompactShuffleTable {
+    int32_t order[256][8];
+
+    CompactShuffleTable() {
+        for (int m = 0; m < 256; ++m) {
+            int k = 0;
+            for (int lane = 0; lane < 8; ++lane) {
+                if (m & (1 << lane)) order[m][k++] = lane;
+            }
+            while (k < 8) order[m][k++] = 0;
+        }
+    }
+};
+
+inline const int32_t* compactShuffleTable() {
+    static const CompactShuffleTable table;   // built once, thread-safe
+    return &table.order[0][0];
+}
+
+// Full 8-lane stores stay in bounds: written <= i, so written + 8 <= i + 8 <= count
+__attribute__((target("avx2,popcnt")))
+inline size_t compactAvx2(BitPredicate predicate, const int32_t* values, size_t count, int32_t* out) {
+    const int32_t* table = compactShuffleTable();
+    size_t written = 0, i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+        unsigned lanes = laneMaskAvx2(predicate, x);
+        __m256i order = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(table + lanes * 8));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + written), _mm256_permutevar8x32_epi32(x, order));
+        written += _mm_popcnt_u32(lanes);
+    }
+    return written + compactScalar(predicate, values, i, count, out + written);
+}
+
+// -------------------------------------------------
+// 3. AVX-512 KERNELS (16 lanes)
+// -------------------------------------------------
+
+__attribute__((target("avx512f")))
+inline __mmask16 laneMaskAvx512(BitPredicate predicate, __m512i x) {
+    if (predicate == BitPredicate::EVEN) return _mm512_testn_epi32_mask(x, _mm512_set1_epi32(1));
+    __mmask16 positive = _mm512_cmpgt_epi32_mask(x, _mm512_setzero_si512());
+    return _mm512_mask_testn_epi32_mask(positive, x, _mm512_sub_epi32(x, _mm512_set1_epi32(1)));
+}
+
+__attribute__((target("avx512f,popcnt")))
+inline size_t predicateMaskAvx512(BitPredicate predicate, const int32_t* values, size_t count, uint64_t* mask) {
+    size_t hits = 0, i = 0;
+    for (; i + 64 <= count; i += 64) {
+        uint64_t word = 0;
+        for (int group = 0; group < 4; ++group) {
+            __m512i x = _mm512_loadu_si512(values + i + group * 16);
+            word |= uint64_t(laneMaskAvx512(predicate, x)) << (group * 16);
+        }
+        mask[i / 64] = word;
+        hits += size_t(_mm_popcnt_u64(word));
+    }
+    return hits + predicateMaskScalar(predicate, values, i, count, mask);
+}
+
+__attribute__((target("avx512f,popcnt")))
+inline size_t countMatchesAvx512(BitPredicate predicate, const int32_t* values, size_t count) {
+    size_t hits = 0, i = 0;
+    for (; i + 16 <= count; i += 16) {
+        hits += size_t(_mm_popcnt_u32(laneMaskAvx512(predicate, _mm512_loadu_si512(values + i))));
+    }
+    return hits + countMatchesScalar(predicate, values, i, count);
+}
+
+// VPCOMPRESSD packs the matching lanes to the front; the full store stays in bounds as in AVX2
+__attribute__((target("avx512f,popcnt")))
+inline size_t compactAvx512(BitPredicate predicate, const int32_t* values, size_t count, int32_t* out) {
+    size_t written = 0, i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m512i x = _mm512_loadu_si512(values + i);
+        __mmask16 lanes = laneMaskAvx512(predicate, x);
+        _mm512_storeu_si512(out + written, _mm512_maskz_compress_epi32(lanes, x));
+        written += _mm_popcnt_u32(lanes);
+    }
+    return written + compactScalar(predicate, values, i, count, out + written);
+}
+#endif
+
+// -------------------------------------------------
+// 4. PUBLIC BATCH API
+// -------------------------------------------------
+
+/*
+ * Set bit i of mask when values[i] matches; mask must hold maskWords(count) words
+ * Returns: the number of matching values
+ */
+inline size_t predicateMask(BitPredicate predicate, const int32_t* values, size_t count, uint64_t* mask,
+                            SimdLevel level = SimdLevel::AVX512) {
+    for (size_t w = 0; w < maskWords(count); ++w) mask[w] = 0;
+    switch (usableLevel(level)) {
+#ifdef PREDICATES_X86
+        case SimdLevel::AVX512: return predicateMaskAvx512(predicate, values, count, mask);
+        case SimdLevel::AVX2: return predicateMaskAvx2(predicate, values, count, mask);
+#endif
+        default: return predicateMaskScalar(predicate, values, 0, count, mask);
+    }
+}
+
+// Number of matching values (lane masks are popcounted, nothing is stored)
+inline size_t countMatches(BitPredicate predicate, const int32_t* values, size_t count,
+                           SimdLevel level = SimdLevel::AVX512) {
+    switch (usableLevel(level)) {
+#ifdef PREDICATES_X86
+        case SimdLevel::AVX512: return countMatchesAvx512(predicate, values, count);
+        case SimdLevel::AVX2: return countMatchesAvx2(predicate, values, count);
+#endif
+        default: return countMatchesScalar(predicate, values, 0, count);
+    }
+}
+
+/*
+ * Copy the matching values, in order, to the front of out; out must hold count values
+ * Returns: the number of values written
+ */
+inline size_t compactMatches(BitPredicate predicate, const int32_t* values, size_t count, int32_t* out,
+                             SimdLevel level = SimdLevel::AVX512) {
+    switch (usableLevel(level)) {
+#ifdef PREDICATES_X86
+        case SimdLevel::AVX512: return compactAvx512(predicate, values, count, out);
+        case SimdLevel::AVX2: return compactAvx2(predicate, values, count, out);
+#endif
+        default: return compactScalar(predicate, values, 0, count, out);
+    }
+}
+
+// Number of set bits in a mask of maskWords(count) words
+inline size_t popcountMask(const uint64_t* mask, size_t words) {
+    size_t total = 0;
+    for (size_t w = 0; w < words; ++w) total += size_t(__builtin_popcountll(mask[w]));
+    return total;
+}
+
+// Convenience overloads for whole vectors
+inline std::vector<uint64_t> predicateMask(BitPredicate predicate, const std::vector<int32_t>& values) {
+    std::vector<uint64_t> mask(maskWords(values.size()));
+    predicateMask(predicate, values.data(), values.size(), mask.data());
+    return mask;
+}
+
+inline std::vector<int32_t> compactMatches(BitPredicate predicate, const std::vector<int32_t>& values) {
+    std::vector<int32_t> out(values.size());
+    out.resize(compactMatches(predicate, values.data(), values.size(), out.data()));
+    return out;
+}
+
+#endif // BATCH_PREDICATES_H
@@ -0,0 +1,411 @@
+/*
+ * clean_code_bench.cpp
+ * Microbenchmark suite for the competing implementations in clean_code_examples.cpp.
+ * Definition: The comments in clean_code_examples.cpp say the bitwise checks are "more efficient";
+ * this file measures it. Every variant runs over the same inputs with:
+ *   - warmup passes that are not recorded,
+ *   - repeated passes split into small batches, each batch one timing sample,
+ *   - median and p99 (nearest rank) nanoseconds per call over all samples,
+ *   - DoNotOptimize barriers so the compiler cannot drop or hoist the calls,
+ *   - hardware counters (cycles, instructions, branch misses) through perf_event_open when the
+ *     kernel allows it ("n/a" otherwise, e.g. in containers or with perf_event_paranoid > 2).
+ * Inputs: random, sorted and adversarial (worst case for each family: near-2^30 values for the
+ * power-of-two loop, mixed-sign neighbours for parity, the deepest non-overflowing factorial).
+ * Values stay within +/- 2^30 because isPowerOfTwo_Iterative never terminates above 2^30, and
+ * factorial inputs stay at or below 12 because factorial(13) overflows int.
+ *
+ * --tsv prints one tab-separated row per (variant, input) in a fixed order, so CI can store the
+ * output of one commit and pass it back with --compare on the next: rows whose median got slower
+ * than the threshold are flagged and the exit status becomes 1. Variants of one family that
+ * disagree on an input exit with status 3 (bad arguments or baseline: 2).
+ *
+ * Usage: ./clean_code_bench [--count N] [--reps R] [--warmup W] [--tsv] [--compare baseline.tsv] [--threshold PCT]
+ *        (defaults: 1000000 values, 11 repetitions, 2 warmup passes, 10% threshold)
+ */
+#define CLEAN_CODE_EXAMPLES_NO_MAIN
+#include "clean_code_examples.cpp"   // the variants under test
+#include <vector>
+#include <string>
+#include <map>
+#include <algorithm>   // for sort, shuffle
+#include <chrono>
+#include <random>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// -------------------------------------------------
+// 1. OPTIMIZATION BARRIERS
+// -------------------------------------------------
+
+// Force value to be materialized, as if something outside the compiler's view read it
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Make the compiler forget what it knows about a value, so it cannot be hoisted out of a loop
+template <typename T>
+inline void Launder(T& value) {
+    asm volatile("" : "+r,m"(value) : : "memory");
+}
+
+// -------------------------------------------------
+// 2. HARDWARE COUNTERS
+// -------------------------------------------------
+
+/*
+ * Cycles, instructions and branch misses for this thread, read as one perf_event group
+ * available() is false when perf_event_open is not permitted; all reads are then zero.
+ */
+class PerfCounters {
+public:
+    static const int EVENTS = 3;
+
+private:
+    int fds[EVENTS];
+    bool ready;
+
+public:
+    PerfCounters() : ready(false) {
+        for (int& fd : fds) fd = -1;
+#ifdef __linux__
+        const uint64_t configs[EVENTS] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                          PERF_COUNT_HW_BRANCH_MISSES};
+        for (int e = 0; e < EVENTS; ++e) {
+            perf_event_attr attr;
+            memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = configs[e];
+            attr.disabled = (e == 0);   // the leader starts the whole group
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP;
+            fds[e] = int(syscall(SYS_perf_event_open, &attr, 0, -1, e == 0 ? -1 : fds[0], 0));
+            if (fds[e] < 0) {
+                close_all();
+                return;
+            }
+        }
+        ready = true;
+#endif
+    }
+
+    ~PerfCounters() { close_all(); }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available() const { return ready; }
+
+    void start() {
+#ifdef __linux__
+        if (!ready) return;
+        ioctl(fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+    }
+
+    // Stops the group and adds its counts to totals
+    void stop(uint64_t totals[EVENTS]) {
+#ifdef __linux__
+        if (!ready) return;
+        ioctl(fds[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+        uint64_t buffer[1 + EVENTS];   // nr, then one value per event
+        if (read(fds[0], buffer, sizeof(buffer)) == ssize_t(sizeof(buffer))) {
+            for (int e = 0; e < EVENTS; ++e) totals[e] += buffer[1 + e];
+        }
+#else
+        (void)totals;
+#endif
+    }
+
+private:
+    void close_all() {
+#ifdef __linux__
+        for (int& fd : fds) {
+            if (fd >= 0) close(fd);
+            fd = -1;
+        }
+#endif
+        ready = false;
+    }
+};
+
+// -------------------------------------------------
+// 3. INPUTS
+// -------------------------------------------------
+
+enum class Family { PARITY, POWER_OF_TWO, FACTORIAL };
+
+struct InputSet {
+    string name;
+    vector<int> values;
+};
+
+// Random, sorted and adversarial inputs for one family, all of length count
+vector<InputSet> makeInputs(Family family, size_t count) {
+    mt19937 rng(45);
+    vector<int> random(count);
+    if (family == Family::FACTORIAL) {
+        uniform_int_distribution<int> small(0, 12);
+        for (int& x : random) x = small(rng);
+    } else {
+        uniform_int_distribution<int> value(-(1 << 30), 1 << 30);
+        uniform_int_distribution<int> exponent(0, 30);
+        // A quarter are powers of two so the power-of-two checks do not always answer "no"
+        for (size_t i = 0; i < count; ++i) random[i] = (i % 4 == 0) ? (1 << exponent(rng)) : value(rng);
+        shuffle(random.begin(), random.end(), rng);
+    }
+
+    vector<int> sorted = random;
+    sort(sorted.begin(), sorted.end());
+
+    vector<int> adversarial(count);
+    for (size_t i = 0; i < count; ++i) {
+        int k = int(rng() % 1000);
+        switch (family) {
+            // Negative odd values and their even neighbours in random order: sign fix-ups for %
+            case Family::PARITY: adversarial[i] = (rng() & 1) ? -(2 * k + 1) : 2 * k; break;
+            // 2^30 and its neighbours: the longest doubling loop, and log2 of near-powers
+            case Family::POWER_OF_TWO: adversarial[i] = (1 << 30) - int(rng() % 3); break;
+            // The deepest recursion that still fits in an int
+            case Family::FACTORIAL: adversarial[i] = 12; break;
+        }
+    }
+
+    return {{"random", random}, {"sorted", sorted}, {"adversarial", adversarial}};
+}
+
+// -------------------------------------------------
+// 4. HARNESS
+// -------------------------------------------------
+
+struct BenchConfig {
+    size_t count = 1000000;
+    int repetitions = 11;
+    int warmup = 2;
+    size_t batch = 4096;   // calls per timing sample
+};
+
+struct BenchResult {
+    string variant;
+    string input;
+    double medianNs = 0;
+    double p99Ns = 0;
+    double counters[PerfCounters::EVENTS] = {0, 0, 0};   // per call
+    uint64_t checksum = 0;
+};
+
+using Clock = chrono::steady_clock;
+
+// Nearest-rank percentile of sorted samples
+double percentile(const vector<double>& sorted, double pct) {
+    size_t rank = size_t(pct / 100.0 * double(sorted.size()) + 0.999999);
+    return sorted[min(sorted.size(), max<size_t>(rank, 1)) - 1];
+}
+
+/*
+ * Time variant over every value of input
+ * One pass per repetition; each batch of config.batch calls is one sample.
+ */
+template <typename Variant>
+BenchResult measure(const string& name, const InputSet& input, Variant variant, const BenchConfig& config,
+                    PerfCounters& perf) {
+    BenchResult result;
+    result.variant = name;
+    result.input = input.name;
+    const vector<int>& values = input.values;
+
+    auto pass = [&](vector<double>* samples, uint64_t* totals) {
+        uint64_t checksum = 0;
+        for (size_t from = 0; from < values.size(); from += config.batch) {
+            size_t to = min(values.size(), from + config.batch);
+            if (totals) perf.start();
+            auto start = Clock::now();
+            for (size_t i = from; i < to; ++i) {
+                int x = values[i];
+                Launder(x);
+                auto answer = variant(x);
+                DoNotOptimize(answer);
+                checksum += uint64_t(answer);
+            }
+            auto stop = Clock::now();
+            if (totals) perf.stop(totals);
+            if (samples) samples->push_back(chrono::duration<double, nano>(stop - start).count() / double(to - from));
+        }
+        return checksum;
+    };
+
+    for (int w = 0; w < config.warmup; ++w) result.checksum = pass(nullptr, nullptr);
+
+    vector<double> samples;
+    uint64_t totals[PerfCounters::EVENTS] = {0, 0, 0};
+    for (int r = 0; r < config.repetitions; ++r) result.checksum = pass(&samples, &totals[0]);
+
+    sort(samples.begin(), samples.end());
+    if (!samples.empty()) {
+        result.medianNs = percentile(samples, 50);
+        result.p99Ns = percentile(samples, 99);
+    }
+    double calls = double(values.size()) * double(config.repetitions);
+    for (int e = 0; e < PerfCounters::EVENTS; ++e) result.counters[e] = calls > 0 ? double(totals[e]) / calls : 0;
+    return result;
+}
+
+vector<BenchResult> runSuite(const BenchConfig& config, PerfCounters& perf) {
+    vector<BenchResult> results;
+    for (const InputSet& input : makeInputs(Family::PARITY, config.count)) {
+        results.push_back(measure("isEven_Modulus", input, isEven_Modulus, config, perf));
+        results.push_back(measure("isEven_Bitwise", input, isEven_Bitwise, config, perf));
+    }
+    for (const InputSet& input : makeInputs(Family::POWER_OF_TWO, config.count)) {
+        results.push_back(measure("isPowerOfTwo_Log", input, isPowerOfTwo_Log, config, perf));
+        results.push_back(measure("isPowerOfTwo_Iterative", input, isPowerOfTwo_Iterative, config, perf));
+        results.push_back(measure("isPowerOfTwo_Bitwise", input, isPowerOfTwo_Bitwise, config, perf));
+    }
+    for (const InputSet& input : makeInputs(Family::FACTORIAL, config.count)) {
+        results.push_back(measure("factorial", input, factorial, config, perf));
+    }
+    return results;
+}
+
+// -------------------------------------------------
+// 5. REPORTING
+// -------------------------------------------------
+
+string formatCounter(double value, bool available) {
+    if (!available) return "n/a";
+    ostringstream text;
+    text << fixed << setprecision(2) << value;
+    return text.str();
+}
+
+void printTable(const vector<BenchResult>& results, bool counters) {
+    cout << left << setw(24) << "Variant" << setw(13) << "Input" << right << setw(10) << "median ns" << setw(10)
+         << "p99 ns" << setw(10) << "cycles" << setw(10) << "instr" << setw(10) << "br-miss" << endl;
+    for (const BenchResult& r : results) {
+        cout << left << setw(24) << r.variant << setw(13) << r.input << right << fixed << setprecision(2)
+             << setw(10) << r.medianNs << setw(10) << r.p99Ns;
+        for (double value : r.counters) cout << setw(10) << formatCounter(value, counters);
+        cout << endl;
+    }
+    cout.unsetf(ios::fixed);
+}
+
+// Fixed header and row order so two runs can be diffed line by line
+void printTsv(const vector<BenchResult>& results, bool counters) {
+    cout << "variant\tinput\tmedian_ns\tp99_ns\tcycles\tinstructions\tbranch_misses\tchecksum" << endl;
+    for (const BenchResult& r : results) {
+        cout << r.variant << '\t' << r.input << '\t' << fixed << setprecision(3) << r.medianNs << '\t' << r.p99Ns;
+        for (double value : r.counters) cout << '\t' << formatCounter(value, counters);
+        cout << '\t' << r.checksum << endl;
+    }
+    cout.unsetf(ios::fixed);
+}
+
+// (variant, input) -> median ns from a --tsv file
+map<pair<string, string>, double> loadBaseline(const string& path) {
+    ifstream file(path);
+    if (!file) throw runtime_error("Cannot open baseline file: " + path);
+    map<pair<string, string>, double> medians;
+    string line;
+    getline(file, line);   // header
+    while (getline(file, line)) {
+        istringstream fields(line);
+        string variant, input, median;
+        if (getline(fields, variant, '\t') && getline(fields, input, '\t') && getline(fields, median, '\t')) {
+            medians[make_pair(variant, input)] = strtod(median.c_str(), nullptr);
+        }
+    }
+    return medians;
+}
+
+/*
+ * Compare medians against a baseline run
+ * Returns: the number of rows slower than thresholdPct percent (written to cerr so TSV output stays clean)
+ */
+int compareWithBaseline(const vector<BenchResult>& results, const string& path, double thresholdPct) {
+    map<pair<string, string>, double> baseline = loadBaseline(path);
+    int regressions = 0;
+    cerr << "\nChange in median against " << path << ":" << endl;
+    for (const BenchResult& r : results) {
+        auto found = baseline.find(make_pair(r.variant, r.input));
+        if (found == baseline.end() || found->second <= 0) {
+            cerr << "  " << r.variant << " / " << r.input << ": new" << endl;
+            continue;
+        }
+        double change = (r.medianNs / found->second - 1.0) * 100.0;
+        bool regressed = change > thresholdPct;
+        regressions += regressed;
+        cerr << "  " << r.variant << " / " << r.input << ": " << showpos << fixed << setprecision(1) << change
+             << noshowpos << "%" << (regressed ? "  REGRESSION" : "") << endl;
+    }
+    cerr.unsetf(ios::fixed);
+    return regressions;
+}
+
+int main(int argc, char* argv[]) {
+    BenchConfig config;
+    bool tsv = false;
+    string baselinePath;
+    double thresholdPct = 10;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--tsv") tsv = true;
+        else if (arg == "--count" && hasValue) config.count = strtoul(argv[++i], nullptr, 10);
+        else if (arg == "--reps" && hasValue) config.repetitions = max(1, atoi(argv[++i]));
+        else if (arg == "--warmup" && hasValue) config.warmup = max(0, atoi(argv[++i]));
+        else if (arg == "--compare" && hasValue) baselinePath = argv[++i];
+        else if (arg == "--threshold" && hasValue) thresholdPct = strtod(argv[++i], nullptr);
+        else {
+            cerr << "Usage: " << argv[0]
+                 << " [--count N] [--reps R] [--warmup W] [--tsv] [--compare baseline.tsv] [--threshold PCT]" << endl;
+            return 2;
+        }
+    }
+
+    PerfCounters perf;
+    if (!tsv) {
+        cout << "=== Clean code variants: " << config.count << " calls x " << config.repetitions
+             << " repetitions (" << config.warmup << " warmup), per call ===" << endl;
+        if (!perf.available()) cout << "Hardware counters unavailable (perf_event_open not permitted)" << endl;
+    }
+
+    vector<BenchResult> results = runSuite(config, perf);
+    if (tsv) printTsv(results, perf.available());
+    else printTable(results, perf.available());
+
+    // Variants of the same family must agree on every input
+    bool consistent = true;
+    for (size_t i = 1; i < results.size(); ++i) {
+        bool sameFamily = results[i].input == results[i - 1].input
+                          && results[i].variant.substr(0, 6) == results[i - 1].variant.substr(0, 6);
+        if (sameFamily && results[i].checksum != results[i - 1].checksum) {
+            cerr << "Mismatch between implementations!" << endl;
+            consistent = false;
+        }
+    }
+    if (!consistent) return 3;
+
+    if (!baselinePath.empty()) {
+        try {
+            return compareWithBaseline(results, baselinePath, thresholdPct) > 0 ? 1 : 0;
+        } catch (const runtime_error& e) {
+            cerr << "Error: " << e.what() << endl;
+            return 2;
+        }
+    }
+    return 0;
+}
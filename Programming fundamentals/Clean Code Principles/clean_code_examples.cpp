@@ -132,7 +132,10 @@ int factorial(int n) {
 
 // -------------------------------------------------
 // MAIN FUNCTION (Driver Code)
+// Benchmarks include this file with CLEAN_CODE_EXAMPLES_NO_MAIN defined
+// to measure the functions above without their own main.
 // -------------------------------------------------
+#ifndef CLEAN_CODE_EXAMPLES_NO_MAIN
 int main() {
     cout << "=== Clean Code Examples ===" << endl;
 
@@ -154,3 +157,4 @@ int main() {
 
     return 0;
 }
+#endif // CLEAN_CODE_EXAMPLES_NO_MAIN
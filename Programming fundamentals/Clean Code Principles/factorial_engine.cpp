@@ -0,0 +1,124 @@
+/*
+ * factorial_engine.cpp
+ * Demonstrates the overflow-safe and big-integer factorials from factorial_engine.h.
+ * Definition: factorial(int) in clean_code_examples.cpp is correct only up to 12!; after that the
+ * int silently overflows. The engine answers small n from a constexpr table, detects overflow
+ * for fixed-width types, and computes exact n! for any n with the prime-swing algorithm.
+ * Shows: the 64-bit table against factorial(int), overflow detection, exact 100!, agreement of the
+ * prime swing, product tree and naive multiplication, memoization, and a timed n! (default
+ * 1000000!) checked against n! mod several primes computed independently.
+ * Run this file independently to see the factorial engine in action.
+ * Usage: ./factorial_engine [n] [threads]   (defaults: 1000000, every hardware thread)
+ */
+#define CLEAN_CODE_EXAMPLES_NO_MAIN
+#include "clean_code_examples.cpp"   // factorial(int)
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include "factorial_engine.h"
+
+using Clock = chrono::steady_clock;
+
+double elapsedSeconds(Clock::time_point start) {
+    return chrono::duration<double>(Clock::now() - start).count();
+}
+
+// n! mod p, one multiplication at a time (independent check for huge results)
+uint64_t factorialModulo(uint64_t n, uint64_t p) {
+    uint64_t result = 1 % p;
+    for (uint64_t i = 2; i <= n && result != 0; ++i) result = uint64_t(uint128(result) * i % p);
+    return result;
+}
+
+// Trailing decimal zeros of n! (Legendre's formula for the prime 5)
+uint64_t trailingZeros(uint64_t n) {
+    uint64_t zeros = 0;
+    for (uint64_t q = n / 5; q > 0; q /= 5) zeros += q;
+    return zeros;
+}
+
+// Decimal digits of n!, floor(log10(n!)) + 1 via lgamma
+uint64_t decimalDigits(uint64_t n) {
+    return uint64_t(lgammal((long double)n + 1) / logl(10.0L)) + 1;
+}
+
+int main(int argc, char* argv[]) {
+    // Small factorials: constexpr table
+    static_assert(factorial64(10) == 3628800, "table is usable at compile time");
+    bool tableAgrees = true;
+    for (int n = 0; n <= 12; ++n) tableAgrees = tableAgrees && uint64_t(factorial(n)) == factorial64(n);
+    cout << "factorial64 agrees with factorial(int) for 0..12: " << (tableAgrees ? "yes" : "NO") << endl;
+    cout << "20! = " << factorial64(20) << endl;
+
+    // Overflow is reported instead of wrapping
+    cout << "checkedFactorial<int>(12) = " << checkedFactorial<int>(12) << endl;
+    try {
+        checkedFactorial<int>(13);
+    } catch (const overflow_error& e) {
+        cout << "Caught expected error: " << e.what() << " an int" << endl;
+    }
+    try {
+        factorial64(21);
+    } catch (const overflow_error& e) {
+        cout << "Caught expected error: " << e.what() << endl;
+    }
+    try {
+        factorial64(-1);
+    } catch (const invalid_argument& e) {
+        cout << "Caught expected error: " << e.what() << endl;
+    }
+
+    uint64_t n = (argc > 1) ? strtoull(argv[1], nullptr, 10) : 1000000;
+    unsigned threads = (argc > 2) ? unsigned(atoi(argv[2])) : 0;
+    FactorialEngine engine(threads);
+
+    // Exact big factorials
+    cout << "100! = " << engine.factorial(100).toString() << endl;
+    string thousand = engine.factorial(1000).toString();
+    cout << "1000! has " << thousand.size() << " digits (expected 2568)" << endl;
+
+    const uint64_t CHECK_N = 5000;
+    BigUnsigned swing = engine.factorial(CHECK_N);
+    bool same = swing == factorialProductTree(CHECK_N) && swing == factorialNaive(CHECK_N);
+    cout << CHECK_N << "! by prime swing, product tree and naive loop agree: " << (same ? "yes" : "NO") << endl;
+
+    // Big n: prime swing against the product tree and the naive loop (naive timed on n / 50)
+    cout << "\n=== " << n << "! with " << engine.threadCount() << " thread(s) ===" << endl;
+    engine.clearCache();
+    auto start = Clock::now();
+    BigUnsigned result = engine.factorial(n);
+    double swingSeconds = elapsedSeconds(start);
+
+    start = Clock::now();
+    BigUnsigned treeResult = factorialProductTree(n, engine.threadCount());
+    double treeSeconds = elapsedSeconds(start);
+
+    uint64_t naiveN = n / 50;
+    start = Clock::now();
+    BigUnsigned naive = factorialNaive(naiveN);
+    double naiveSeconds = elapsedSeconds(start);
+
+    cout << "Bits: " << result.bitLength() << ", decimal digits: " << decimalDigits(n)
+         << ", trailing zeros: " << trailingZeros(n) << endl;
+    cout << "prime swing:   " << swingSeconds << " s" << endl;
+    cout << "product tree:  " << treeSeconds << " s" << endl;
+    cout << "naive loop:    " << naiveSeconds << " s for " << naiveN << "! (quadratic, so ~"
+         << naiveSeconds * 2500 << " s for " << n << "!)" << endl;
+
+    // Memoized odd parts: (n + 1)! reuses the odd part of (n / 2)!
+    start = Clock::now();
+    engine.factorial(n + 1);
+    cout << "(n + 1)! with " << engine.cachedValues() << " cached odd parts: " << elapsedSeconds(start) << " s" << endl;
+
+    // Independent check: n! mod p by direct multiplication
+    const uint64_t PRIMES[] = {1000000007ULL, 998244353ULL, 18446744073709551557ULL};
+    bool verified = result == treeResult && naive.modulo(PRIMES[0]) == factorialModulo(naiveN, PRIMES[0]);
+    for (uint64_t p : PRIMES) verified = verified && result.modulo(p) == factorialModulo(n, p);
+    cout << "Residues mod 3 primes match direct computation: " << (verified ? "yes" : "NO") << endl;
+    if (!verified || !same || !tableAgrees) {
+        cerr << "Mismatch between implementations!" << endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,489 @@
+/*
+ * factorial_engine.h
+ * Overflow-safe and arbitrary-precision factorials, replacing factorial(int) from clean_code_examples.cpp
+ * (which silently overflows int after 12!).
+ * Definition: Three tiers:
+ *   - factorial64(n): a constexpr table of every factorial that fits in 64 bits (0! .. 20!),
+ *   - checkedFactorial<T>(n): multiplies in T and throws overflow_error instead of wrapping,
+ *   - FactorialEngine::factorial(n): exact n! as a BigUnsigned for any n.
+ * The big path uses Luschny's prime-swing algorithm:
+ *   n! = 2^(n - popcount(n)) * odd(n),   odd(n) = odd(n/2)^2 * oddSwing(n)
+ * where oddSwing(n) = product of p^e over odd primes p <= n, e = sum over k of floor(n / p^k) mod 2.
+ * The prime powers are multiplied with a balanced product tree (binary splitting), so the factors
+ * stay of similar size, products use Karatsuba above KARATSUBA_THRESHOLD limbs, and large subtree
+ * products and Karatsuba branches run on separate threads.
+ * The odd parts computed along the way are memoized, so nearby n reuse them.
+ *
+ * BigUnsigned stores 64-bit limbs, least significant first; toString() is quadratic and meant for
+ * numbers up to ~100000 digits.
+ */
+#ifndef FACTORIAL_ENGINE_H
+#define FACTORIAL_ENGINE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// -------------------------------------------------
+// 1. SMALL FACTORIALS
+// -------------------------------------------------
+
+struct Factorial64Table {
+    uint64_t values[21];
+
+    constexpr Factorial64Table() : values() {
+        values[0] = 1;
+        for (int i = 1; i <= 20; ++i) values[i] = values[i - 1] * uint64_t(i);
+    }
+};
+
+inline constexpr Factorial64Table FACTORIAL64_TABLE{};
+
+static_assert(FACTORIAL64_TABLE.values[20] == 2432902008176640000ULL, "20! must fit in 64 bits");
+
+// Largest n with n! representable in uint64_t
+const int FACTORIAL64_MAX = 20;
+
+/*
+ * n! by table lookup
+ * Throws: invalid_argument for negative n, overflow_error for n > 20
+ */
+constexpr uint64_t factorial64(int n) {
+    if (n < 0) throw std::invalid_argument("Factorial of a negative number");
+    if (n > FACTORIAL64_MAX) throw std::overflow_error("Factorial does not fit in 64 bits");
+    return FACTORIAL64_TABLE.values[n];
+}
+
+/*
+ * n! computed in T with overflow detection
+ * Throws: invalid_argument for negative n, overflow_error as soon as a product does not fit in T
+ */
+template <typename T>
+T checkedFactorial(int n) {
+    if (n < 0) throw std::invalid_argument("Factorial of a negative number");
+    T result = 1;
+    for (int i = 2; i <= n; ++i) {
+        if (__builtin_mul_overflow(result, T(i), &result)) {
+            throw std::overflow_error("Factorial of " + std::to_string(n) + " overflows");
+        }
+    }
+    return result;
+}
+
+// -------------------------------------------------
+// 2. LIMB ARITHMETIC
+// -------------------------------------------------
+
+typedef std::vector<uint64_t> Limbs;
+typedef unsigned __int128 uint128;
+
+const size_t KARATSUBA_THRESHOLD = 40;     // limbs; below this schoolbook is faster
+const size_t PARALLEL_THRESHOLD = 2048;    // limbs; smaller products are not worth a thread
+
+// out[0 .. na+nb) = a * b; out must be zeroed
+inline void multiplySchoolbook(const uint64_t* a, size_t na, const uint64_t* b, size_t nb, uint64_t* out) {
+    for (size_t i = 0; i < na; ++i) {
+        uint64_t ai = a[i];
+        if (ai == 0) continue;
+        uint128 carry = 0;
+        for (size_t j = 0; j < nb; ++j) {
+            uint128 t = uint128(ai) * b[j] + out[i + j] + carry;
+            out[i + j] = uint64_t(t);
+            carry = t >> 64;
+        }
+        out[i + nb] = uint64_t(carry);
+    }
+}
+
+// acc[offset ..] += src[0 .. n); the carry must not run past accLen
+inline void addAt(uint64_t* acc, size_t accLen, const uint64_t* src, size_t n, size_t offset) {
+    uint64_t carry = 0;
+    for (size_t i = 0; i < n; ++i) {
+        uint128 sum = uint128(acc[offset + i]) + src[i] + carry;
+        acc[offset + i] = uint64_t(sum);
+        carry = uint64_t(sum >> 64);
+    }
+    for (size_t k = offset + n; carry && k < accLen; ++k) carry = (++acc[k] == 0);
+}
+
+// x -= y, requires x >= y
+inline void subtractInPlace(uint64_t* x, size_t nx, const uint64_t* y, size_t ny) {
+    uint64_t borrow = 0;
+    for (size_t i = 0; i < ny; ++i) {
+        uint64_t yi = y[i];
+        uint64_t diff = x[i] - yi - borrow;
+        borrow = (x[i] < yi) || (x[i] - yi < borrow);
+        x[i] = diff;
+    }
+    for (size_t k = ny; borrow && k < nx; ++k) borrow = (x[k]-- == 0);
+}
+
+// Length without leading zero limbs
+inline size_t significantLimbs(const uint64_t* x, size_t n) {
+    while (n > 0 && x[n - 1] == 0) --n;
+    return n;
+}
+
+/*
+ * a * b as na + nb limbs (possibly with leading zeros)
+ * Karatsuba for balanced operands, chunked for unbalanced ones; while threadDepth > 0 the two outer
+ * Karatsuba products of a large multiplication run on their own threads.
+ */
+inline Limbs multiplyLimbs(const uint64_t* a, size_t na, const uint64_t* b, size_t nb, int threadDepth) {
+    if (na < nb) {
+        std::swap(a, b);
+        std::swap(na, nb);
+    }
+    Limbs out(na + nb, 0);
+    if (nb == 0) return out;
+    if (nb < KARATSUBA_THRESHOLD) {
+        multiplySchoolbook(a, na, b, nb, out.data());
+        return out;
+    }
+
+    // Unbalanced: multiply b by nb-limb slices of a
+    if (na >= 2 * nb) {
+        for (size_t from = 0; from < na; from += nb) {
+            size_t len = std::min(nb, na - from);
+            Limbs part = multiplyLimbs(a + from, len, b, nb, threadDepth);
+            addAt(out.data(), out.size(), part.data(), significantLimbs(part.data(), part.size()), from);
+        }
+        return out;
+    }
+
+    // a = a1*B^m + a0, b = b1*B^m + b0 (b1 may be empty when nb == m)
+    size_t m = (na + 1) / 2;
+    const uint64_t* a1 = a + m;
+    const uint64_t* b1 = b + m;
+    size_t na1 = na - m, nb1 = nb - m;
+
+    Limbs sumA(m + 1, 0), sumB(m + 1, 0);
+    std::copy(a, a + m, sumA.begin());
+    std::copy(b, b + m, sumB.begin());
+    addAt(sumA.data(), sumA.size(), a1, na1, 0);
+    addAt(sumB.data(), sumB.size(), b1, nb1, 0);
+
+    Limbs z0, z1, z2;
+    if (threadDepth > 0 && nb >= PARALLEL_THRESHOLD) {
+        auto low = std::async(std::launch::async, multiplyLimbs, a, m, b, m, threadDepth - 1);
+        auto high = std::async(std::launch::async, multiplyLimbs, a1, na1, b1, nb1, threadDepth - 1);
+        z1 = multiplyLimbs(sumA.data(), sumA.size(), sumB.data(), sumB.size(), threadDepth - 1);
+        z0 = low.get();
+        z2 = high.get();
+    } else {
+        z0 = multiplyLimbs(a, m, b, m, 0);
+        z2 = multiplyLimbs(a1, na1, b1, nb1, 0);
+        z1 = multiplyLimbs(sumA.data(), sumA.size(), sumB.data(), sumB.size(), 0);
+    }
+
+    // z1 = (a0 + a1)(b0 + b1) - z0 - z2 = a0*b1 + a1*b0
+    subtractInPlace(z1.data(), z1.size(), z0.data(), z0.size());
+    subtractInPlace(z1.data(), z1.size(), z2.data(), z2.size());
+
+    addAt(out.data(), out.size(), z0.data(), significantLimbs(z0.data(), z0.size()), 0);
+    addAt(out.data(), out.size(), z2.data(), significantLimbs(z2.data(), z2.size()), 2 * m);
+    addAt(out.data(), out.size(), z1.data(), significantLimbs(z1.data(), z1.size()), m);
+    return out;
+}
+
+// Karatsuba levels that may fork threads: each level runs 3 products, so 3^depth >= threads
+inline int threadDepthFor(unsigned threads) {
+    int depth = 0;
+    for (unsigned tasks = 1; tasks < threads; tasks *= 3) ++depth;
+    return depth;
+}
+
+// -------------------------------------------------
+// 3. BIG UNSIGNED INTEGER
+// -------------------------------------------------
+
+/*
+ * Arbitrary-precision unsigned integer
+ * Only what factorials need: multiplication (small and big), left shift, remainder, comparison
+ * and conversion to decimal / hexadecimal text.
+ */
+class BigUnsigned {
+private:
+    Limbs limbs;   // least significant first, no leading zero limbs
+
+    void trim() {
+        limbs.resize(significantLimbs(limbs.data(), limbs.size()));
+    }
+
+public:
+    BigUnsigned() {}
+
+    BigUnsigned(uint64_t value) {
+        if (value != 0) limbs.push_back(value);
+    }
+
+    bool isZero() const { return limbs.empty(); }
+    size_t limbCount() const { return limbs.size(); }
+
+    size_t bitLength() const {
+        if (limbs.empty()) return 0;
+        return 64 * (limbs.size() - 1) + size_t(64 - __builtin_clzll(limbs.back()));
+    }
+
+    BigUnsigned& operator*=(uint64_t factor) {
+        uint128 carry = 0;
+        for (uint64_t& limb : limbs) {
+            uint128 t = uint128(limb) * factor + carry;
+            limb = uint64_t(t);
+            carry = t >> 64;
+        }
+        if (carry) limbs.push_back(uint64_t(carry));
+        if (factor == 0) limbs.clear();
+        return *this;
+    }
+
+    // Product using up to `threads` threads for the Karatsuba branches
+    static BigUnsigned multiply(const BigUnsigned& x, const BigUnsigned& y, unsigned threads = 1) {
+        BigUnsigned result;
+        result.limbs = multiplyLimbs(x.limbs.data(), x.limbs.size(), y.limbs.data(), y.limbs.size(),
+                                     threadDepthFor(threads));
+        result.trim();
+        return result;
+    }
+
+    friend BigUnsigned operator*(const BigUnsigned& x, const BigUnsigned& y) {
+        return multiply(x, y);
+    }
+
+    BigUnsigned& operator<<=(size_t bits) {
+        if (limbs.empty() || bits == 0) return *this;
+        size_t whole = bits / 64;
+        unsigned part = unsigned(bits % 64);
+        if (part != 0) {
+            uint64_t carry = 0;
+            for (uint64_t& limb : limbs) {
+                uint64_t next = limb >> (64 - part);
+                limb = (limb << part) | carry;
+                carry = next;
+            }
+            if (carry) limbs.push_back(carry);
+        }
+        limbs.insert(limbs.begin(), whole, 0);
+        return *this;
+    }
+
+    // Divides in place by a non-zero divisor; Returns: the remainder
+    uint64_t divideSmall(uint64_t divisor) {
+        if (divisor == 0) throw std::invalid_argument("Division by zero");
+        uint128 remainder = 0;
+        for (size_t i = limbs.size(); i-- > 0;) {
+            uint128 current = (remainder << 64) | limbs[i];
+            limbs[i] = uint64_t(current / divisor);
+            remainder = current % divisor;
+        }
+        trim();
+        return uint64_t(remainder);
+    }
+
+    // Remainder modulo a non-zero 64-bit value, without changing the number
+    uint64_t modulo(uint64_t divisor) const {
+        if (divisor == 0) throw std::invalid_argument("Division by zero");
+        uint128 remainder = 0;
+        for (size_t i = limbs.size(); i-- > 0;) remainder = ((remainder << 64) | limbs[i]) % divisor;
+        return uint64_t(remainder);
+    }
+
+    bool operator==(const BigUnsigned& other) const { return limbs == other.limbs; }
+    bool operator!=(const BigUnsigned& other) const { return limbs != other.limbs; }
+
+    // Decimal text, 19 digits per division pass (quadratic in the number of limbs)
+    std::string toString() const {
+        if (limbs.empty()) return "0";
+        const uint64_t CHUNK = 10000000000000000000ULL;   // 10^19
+        BigUnsigned rest = *this;
+        std::vector<uint64_t> chunks;
+        while (!rest.isZero()) chunks.push_back(rest.divideSmall(CHUNK));
+        std::string text = std::to_string(chunks.back());
+        for (size_t i = chunks.size() - 1; i-- > 0;) {
+            std::string digits = std::to_string(chunks[i]);
+            text.append(19 - digits.size(), '0');
+            text += digits;
+        }
+        return text;
+    }
+
+    std::string toHex() const {
+        if (limbs.empty()) return "0";
+        static const char DIGITS[] = "0123456789abcdef";
+        std::string text;
+        for (size_t i = limbs.size(); i-- > 0;) {
+            for (int shift = 60; shift >= 0; shift -= 4) text += DIGITS[(limbs[i] >> shift) & 15];
+        }
+        return text.substr(text.find_first_not_of('0'));
+    }
+};
+
+// -------------------------------------------------
+// 4. PRODUCT TREE
+// -------------------------------------------------
+
+// Greedily pack consecutive factors into 64-bit words so the tree has fewer leaves
+inline std::vector<uint64_t> packFactors(const std::vector<uint64_t>& factors) {
+    std::vector<uint64_t> words;
+    uint64_t word = 1;
+    for (uint64_t f : factors) {
+        uint64_t packed;
+        if (__builtin_mul_overflow(word, f, &packed)) {
+            words.push_back(word);
+            word = f;
+        } else {
+            word = packed;
+        }
+    }
+    if (word != 1 || words.empty()) words.push_back(word);
+    return words;
+}
+
+/*
+ * Product of words[from .. to) by binary splitting
+ * Both halves have similar size, so every multiplication is balanced and Karatsuba pays off;
+ * while threadDepth > 0 the left half is computed on another thread.
+ */
+inline BigUnsigned productTree(const std::vector<uint64_t>& words, size_t from, size_t to, unsigned threads) {
+    if (to - from <= 16) {
+        BigUnsigned result(1);
+        for (size_t i = from; i < to; ++i) result *= words[i];
+        return result;
+    }
+    size_t mid = from + (to - from) / 2;
+    if (threads > 1) {
+        unsigned leftThreads = threads / 2;
+        auto left = std::async(std::launch::async, productTree, std::cref(words), from, mid, leftThreads);
+        BigUnsigned right = productTree(words, mid, to, threads - leftThreads);
+        return BigUnsigned::multiply(left.get(), right, threads);
+    }
+    return BigUnsigned::multiply(productTree(words, from, mid, 1), productTree(words, mid, to, 1), 1);
+}
+
+inline BigUnsigned productOf(const std::vector<uint64_t>& factors, unsigned threads) {
+    std::vector<uint64_t> words = packFactors(factors);
+    return productTree(words, 0, words.size(), threads);
+}
+
+// -------------------------------------------------
+// 5. FACTORIAL ENGINE
+// -------------------------------------------------
+
+/*
+ * Exact factorials of any size by prime swing
+ * Odd parts of the factorials met during the recursion are cached (n >= MEMO_MIN), so computing
+ * n! after m! with m near n reuses most of the work. Thread-safe.
+ */
+class FactorialEngine {
+private:
+    static const uint64_t MEMO_MIN = 1024;
+
+    typedef std::shared_ptr<const std::vector<uint32_t>> PrimeList;
+
+    unsigned threads;
+    PrimeList primes;        // odd primes up to sievedUpTo; replaced, never modified, when it grows
+    uint64_t sievedUpTo;
+    std::map<uint64_t, BigUnsigned> oddCache;
+    std::mutex mutex;
+
+    // Odd primes up to at least limit (caller holds the mutex)
+    PrimeList sieve(uint64_t limit) {
+        if (limit <= sievedUpTo) return primes;
+        std::vector<char> composite(limit + 1, 0);
+        std::vector<uint32_t> found;
+        for (uint64_t i = 3; i <= limit; i += 2) {
+            if (composite[i]) continue;
+            found.push_back(uint32_t(i));
+            for (uint64_t j = i * i; j <= limit; j += 2 * i) composite[j] = 1;
+        }
+        primes = std::make_shared<const std::vector<uint32_t>>(std::move(found));
+        sievedUpTo = limit;
+        return primes;
+    }
+
+    // Prime powers whose product is the odd part of n! / ((n/2)!)^2
+    static std::vector<uint64_t> oddSwingFactors(uint64_t n, const std::vector<uint32_t>& primes) {
+        std::vector<uint64_t> factors;
+        for (uint32_t p : primes) {
+            if (p > n) break;
+            uint64_t power = 1;
+            for (uint64_t q = n / p; q > 0; q /= p) {
+                if (q & 1) power *= p;
+            }
+            if (power > 1) factors.push_back(power);
+        }
+        return factors;
+    }
+
+    BigUnsigned oddFactorial(uint64_t n, const std::vector<uint32_t>& primes) {
+        if (n < 2) return BigUnsigned(1);
+        if (n >= MEMO_MIN) {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto cached = oddCache.find(n);
+            if (cached != oddCache.end()) return cached->second;
+        }
+        BigUnsigned half = oddFactorial(n / 2, primes);
+        BigUnsigned swing = productOf(oddSwingFactors(n, primes), threads);
+        BigUnsigned result = BigUnsigned::multiply(BigUnsigned::multiply(half, half, threads), swing, threads);
+        if (n >= MEMO_MIN) {
+            std::lock_guard<std::mutex> lock(mutex);
+            oddCache.emplace(n, result);
+        }
+        return result;
+    }
+
+public:
+    // threads = 0 uses every hardware thread
+    explicit FactorialEngine(unsigned threads = 0)
+        : threads(threads ? threads : std::max(1u, std::thread::hardware_concurrency())),
+          primes(std::make_shared<const std::vector<uint32_t>>()), sievedUpTo(2) {}
+
+    // Exact n!
+    BigUnsigned factorial(uint64_t n) {
+        if (n <= uint64_t(FACTORIAL64_MAX)) return BigUnsigned(factorial64(int(n)));
+        PrimeList oddPrimes;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            oddPrimes = sieve(n);
+        }
+        BigUnsigned result = oddFactorial(n, *oddPrimes);
+        result <<= size_t(n - uint64_t(__builtin_popcountll(n)));   // 2's exponent in n!
+        return result;
+    }
+
+    size_t cachedValues() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return oddCache.size();
+    }
+
+    void clearCache() {
+        std::lock_guard<std::mutex> lock(mutex);
+        oddCache.clear();
+    }
+
+    unsigned threadCount() const { return threads; }
+};
+
+// n! as the product tree of 1..n (binary splitting without the prime swing)
+inline BigUnsigned factorialProductTree(uint64_t n, unsigned threads = 1) {
+    std::vector<uint64_t> factors;
+    for (uint64_t i = 2; i <= n; ++i) factors.push_back(i);
+    return productOf(factors, threads);
+}
+
+// n! by multiplying 1, 2, ..., n one at a time (the big-number version of factorial(int))
+inline BigUnsigned factorialNaive(uint64_t n) {
+    BigUnsigned result(1);
+    for (uint64_t i = 2; i <= n; ++i) result *= i;
+    return result;
+}
+
+#endif // FACTORIAL_ENGINE_H
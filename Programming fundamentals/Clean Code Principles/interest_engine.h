@@ -0,0 +1,379 @@
+/*
+ * interest_engine.h
+ * Batch simple interest over columns of accounts, in exact fixed-point decimal.
+ * Definition: calculateSimpleInterest(double, double, double) from clean_code_examples.cpp works in
+ * binary floating point, so amounts like 0.005 dollars are not representable and results that sit
+ * exactly on half a cent round the wrong way. Here every amount is an integer count of decimal units:
+ *   principal: Money (FixedDecimal<2>, cents)
+ *   rate:      Rate  (FixedDecimal<4>, percent per year, 5.25% = 52500)
+ *   time:      Years (FixedDecimal<4>, 1.5 years = 15000)
+ * so interest in cents = principal * rate * years / 10^10, computed with a 128-bit intermediate
+ * and rounded half to even (banker's rounding).
+ *
+ * InterestColumns stores the three inputs as separate arrays (structure of arrays). The AVX-512DQ
+ * kernel computes 8 rows per step without 128-bit arithmetic: a double estimate of the quotient is
+ * within one unit of the truth, and the exact remainder, computed with wrapping 64-bit multiplies,
+ * corrects it and decides the rounding. The scalar kernel uses __int128 directly. Rows are split
+ * across threads, and streamInterestToFile() writes row groups to a columnar file while the next
+ * group is being computed.
+ *
+ * Input limits (checked by InterestColumns::push_back): 0 <= principal <= 10^10 dollars,
+ * 0 <= rate <= 100%, 0 <= years <= 100. They keep principal * rate below 2^63 and every result
+ * below 2^47, which the vector kernel relies on.
+ */
+#ifndef INTEREST_ENGINE_H
+#define INTEREST_ENGINE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <fstream>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define INTEREST_X86 1
+#endif
+
+// -------------------------------------------------
+// 1. FIXED-POINT DECIMAL
+// -------------------------------------------------
+
+/*
+ * Signed decimal with SCALE digits after the point, stored as a 64-bit count of 10^-SCALE units
+ * Parsing is exact ("0.1" is 1 unit at SCALE 1), unlike converting through double.
+ */
+template <int SCALE>
+class FixedDecimal {
+private:
+    int64_t units;
+
+public:
+    static constexpr int64_t ONE() {
+        int64_t one = 1;
+        for (int i = 0; i < SCALE; ++i) one *= 10;
+        return one;
+    }
+
+    constexpr FixedDecimal() : units(0) {}
+
+    static constexpr FixedDecimal fromUnits(int64_t units) {
+        FixedDecimal value;
+        value.units = units;
+        return value;
+    }
+
+    /*
+     * Parse "[-]digits[.digits]"
+     * Throws: invalid_argument for malformed text or more than SCALE decimals, out_of_range when too large
+     */
+    static FixedDecimal parse(const std::string& text) {
+        size_t i = 0;
+        bool negative = (!text.empty() && text[0] == '-');
+        if (negative) ++i;
+        int64_t whole = 0, fraction = 0;
+        int decimals = 0;
+        bool digits = false, point = false;
+        for (; i < text.size(); ++i) {
+            char c = text[i];
+            if (c == '.' && !point) {
+                point = true;
+            } else if (c >= '0' && c <= '9') {
+                digits = true;
+                if (point) {
+                    if (++decimals > SCALE) throw std::invalid_argument("Too many decimals: " + text);
+                    fraction = fraction * 10 + (c - '0');
+                } else if (__builtin_mul_overflow(whole, 10, &whole) || __builtin_add_overflow(whole, c - '0', &whole)) {
+                    throw std::out_of_range("Decimal too large: " + text);
+                }
+            } else {
+                throw std::invalid_argument("Not a decimal number: " + text);
+            }
+        }
+        if (!digits) throw std::invalid_argument("Not a decimal number: " + text);
+        for (; decimals < SCALE; ++decimals) fraction *= 10;
+        int64_t total;
+        if (__builtin_mul_overflow(whole, ONE(), &total) || __builtin_add_overflow(total, fraction, &total)) {
+            throw std::out_of_range("Decimal too large: " + text);
+        }
+        return fromUnits(negative ? -total : total);
+    }
+
+    int64_t raw() const { return units; }
+
+    std::string toString() const {
+        uint64_t magnitude = units < 0 ? 0 - uint64_t(units) : uint64_t(units);
+        std::string fraction = std::to_string(magnitude % uint64_t(ONE()));
+        std::string text = (units < 0 ? "-" : "") + std::to_string(magnitude / uint64_t(ONE()));
+        if (SCALE > 0) text += "." + std::string(SCALE - fraction.size(), '0') + fraction;
+        return text;
+    }
+
+    bool operator==(const FixedDecimal& other) const { return units == other.units; }
+    bool operator!=(const FixedDecimal& other) const { return units != other.units; }
+};
+
+typedef FixedDecimal<2> Money;   // cents
+typedef FixedDecimal<4> Rate;    // percent per year
+typedef FixedDecimal<4> Years;
+
+typedef __int128 int128;
+
+// numerator / divisor rounded half to even; divisor > 0
+inline int128 divideRoundHalfEven(int128 numerator, int128 divisor) {
+    int128 quotient = numerator / divisor;
+    int128 remainder = numerator % divisor;
+    if (remainder < 0) {   // floor division, so the tie test below works for negatives too
+        quotient -= 1;
+        remainder += divisor;
+    }
+    if (2 * remainder > divisor || (2 * remainder == divisor && (quotient & 1))) quotient += 1;
+    return quotient;
+}
+
+// -------------------------------------------------
+// 2. INTEREST KERNELS
+// -------------------------------------------------
+
+// cents * (percent * 10^4) * (years * 10^4) / 10^10 = interest in cents
+const int64_t INTEREST_DIVISOR = 10000000000LL;
+
+const int64_t MAX_PRINCIPAL_CENTS = 1000000000000LL;   // 10^10 dollars
+const int64_t MAX_RATE_UNITS = 1000000;                // 100%
+const int64_t MAX_YEARS_UNITS = 1000000;               // 100 years
+
+// Exact simple interest for one account
+inline Money simpleInterest(Money principal, Rate rate, Years years) {
+    int128 numerator = int128(principal.raw()) * rate.raw() * years.raw();
+    return Money::fromUnits(int64_t(divideRoundHalfEven(numerator, INTEREST_DIVISOR)));
+}
+
+inline void interestScalar(const int64_t* principal, const int64_t* rate, const int64_t* years, int64_t* out,
+                           size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        int128 numerator = int128(principal[i] * rate[i]) * years[i];
+        out[i] = int64_t(divideRoundHalfEven(numerator, INTEREST_DIVISOR));
+    }
+}
+
+#ifdef INTEREST_X86
+inline bool cpuHasAvx512dq() {
+    static const bool supported = __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq");
+    return supported;
+}
+
+/*
+ * 8 rows per step. With principal * rate < 2^63 and results < 2^47, the double estimate of
+ * principal * rate * years / 10^10 is off by less than one, so truncating it gives q or q - 1
+ * (or q + 1); the remainder n - q * 10^10 is small, so it is exact even though n and q * 10^10
+ * are only known modulo 2^64.
+ */
+__attribute__((target("avx512f,avx512dq")))
+inline void interestAvx512(const int64_t* principal, const int64_t* rate, const int64_t* years, int64_t* out,
+                           size_t count) {
+    const __m512i divisor = _mm512_set1_epi64(INTEREST_DIVISOR);
+    const __m512i one = _mm512_set1_epi64(1);
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512d inverse = _mm512_set1_pd(1.0 / double(INTEREST_DIVISOR));
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m512i p = _mm512_loadu_si512(principal + i);
+        __m512i r = _mm512_loadu_si512(rate + i);
+        __m512i t = _mm512_loadu_si512(years + i);
+        __m512i pr = _mm512_mullo_epi64(p, r);
+
+        __m512d estimate = _mm512_mul_pd(_mm512_mul_pd(_mm512_cvtepi64_pd(pr), _mm512_cvtepi64_pd(t)), inverse);
+        __m512i q = _mm512_cvttpd_epi64(estimate);
+        __m512i remainder = _mm512_sub_epi64(_mm512_mullo_epi64(pr, t), _mm512_mullo_epi64(q, divisor));
+
+        __mmask8 under = _mm512_cmplt_epi64_mask(remainder, zero);
+        q = _mm512_mask_sub_epi64(q, under, q, one);
+        remainder = _mm512_mask_add_epi64(remainder, under, remainder, divisor);
+        __mmask8 over = _mm512_cmpge_epi64_mask(remainder, divisor);
+        q = _mm512_mask_add_epi64(q, over, q, one);
+        remainder = _mm512_mask_sub_epi64(remainder, over, remainder, divisor);
+
+        // Round half to even
+        __m512i twice = _mm512_add_epi64(remainder, remainder);
+        __mmask8 up = _mm512_cmpgt_epi64_mask(twice, divisor)
+                      | (_mm512_cmpeq_epi64_mask(twice, divisor) & _mm512_test_epi64_mask(q, one));
+        q = _mm512_mask_add_epi64(q, up, q, one);
+        _mm512_storeu_si512(out + i, q);
+    }
+    interestScalar(principal + i, rate + i, years + i, out + i, count - i);
+}
+#endif
+
+// -------------------------------------------------
+// 3. COLUMNS AND BATCH API
+// -------------------------------------------------
+
+/*
+ * Accounts as three parallel columns of raw fixed-point units
+ */
+struct InterestColumns {
+    std::vector<int64_t> principal;   // cents
+    std::vector<int64_t> rate;        // 10^-4 percent
+    std::vector<int64_t> years;       // 10^-4 years
+
+    size_t size() const { return principal.size(); }
+
+    void reserve(size_t rows) {
+        principal.reserve(rows);
+        rate.reserve(rows);
+        years.reserve(rows);
+    }
+
+    /*
+     * Append one account
+     * Throws: out_of_range if a value is negative or above the engine limits
+     */
+    void push_back(Money p, Rate r, Years t) {
+        if (p.raw() < 0 || p.raw() > MAX_PRINCIPAL_CENTS) throw std::out_of_range("Principal out of range: " + p.toString());
+        if (r.raw() < 0 || r.raw() > MAX_RATE_UNITS) throw std::out_of_range("Rate out of range: " + r.toString());
+        if (t.raw() < 0 || t.raw() > MAX_YEARS_UNITS) throw std::out_of_range("Years out of range: " + t.toString());
+        principal.push_back(p.raw());
+        rate.push_back(r.raw());
+        years.push_back(t.raw());
+    }
+};
+
+enum class InterestKernel { SCALAR, AVX512 };
+
+inline InterestKernel bestInterestKernel() {
+#ifdef INTEREST_X86
+    if (cpuHasAvx512dq()) return InterestKernel::AVX512;
+#endif
+    return InterestKernel::SCALAR;
+}
+
+// Rows [from, to) into out[0 .. to - from) with the given kernel (AVX512 falls back to scalar when unsupported)
+inline void computeInterestRange(const InterestColumns& in, int64_t* out, size_t from, size_t to, InterestKernel kernel) {
+    const int64_t* p = in.principal.data() + from;
+    const int64_t* r = in.rate.data() + from;
+    const int64_t* t = in.years.data() + from;
+#ifdef INTEREST_X86
+    if (kernel == InterestKernel::AVX512 && cpuHasAvx512dq()) {
+        interestAvx512(p, r, t, out, to - from);
+        return;
+    }
+#endif
+    (void)kernel;
+    interestScalar(p, r, t, out, to - from);
+}
+
+/*
+ * Interest in cents for rows [from, to), written to out[0 .. to - from)
+ * Rows are split into one contiguous block per thread (threads = 0 uses every hardware thread).
+ */
+inline void computeInterest(const InterestColumns& in, int64_t* out, size_t from, size_t to, unsigned threads = 0,
+                            InterestKernel kernel = bestInterestKernel()) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    size_t rows = to - from;
+    const size_t MIN_ROWS_PER_THREAD = 65536;
+    threads = unsigned(std::min<size_t>(threads, std::max<size_t>(1, rows / MIN_ROWS_PER_THREAD)));
+    if (threads <= 1) {
+        computeInterestRange(in, out, from, to, kernel);
+        return;
+    }
+    std::vector<std::thread> workers;
+    size_t block = (rows + threads - 1) / threads;
+    block = (block + 7) / 8 * 8;   // whole vectors per thread
+    for (size_t begin = from; begin < to; begin += block) {
+        size_t end = std::min(to, begin + block);
+        workers.emplace_back(computeInterestRange, std::cref(in), out + (begin - from), begin, end, kernel);
+    }
+    for (std::thread& worker : workers) worker.join();
+}
+
+inline std::vector<int64_t> computeInterest(const InterestColumns& in, unsigned threads = 0) {
+    std::vector<int64_t> out(in.size());
+    computeInterest(in, out.data(), 0, in.size(), threads);
+    return out;
+}
+
+// -------------------------------------------------
+// 4. COLUMNAR OUTPUT
+// -------------------------------------------------
+
+/*
+ * File layout (little-endian):
+ *   "INTCOL01"
+ *   row groups: uint64 rows, then rows x int64 for each column in order
+ *               principal (cents), rate (10^-4 %), years (10^-4), interest (cents)
+ *   a final row group with rows = 0
+ * A reader can skip straight to any column of a group.
+ */
+const char INTEREST_FILE_MAGIC[8] = {'I', 'N', 'T', 'C', 'O', 'L', '0', '1'};
+
+/*
+ * Compute interest for every row and stream it to path in groups of groupRows rows;
+ * group k is written by a background task while group k + 1 is computed
+ * Throws: runtime_error if the file cannot be written
+ * Returns: bytes written
+ */
+inline uint64_t streamInterestToFile(const InterestColumns& in, const std::string& path, size_t groupRows = 1 << 20,
+                                     unsigned threads = 0) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) throw std::runtime_error("Cannot open output file: " + path);
+    groupRows = std::max<size_t>(groupRows, 8);
+
+    auto writeRaw = [&file](const void* data, size_t bytes) {
+        file.write(static_cast<const char*>(data), std::streamsize(bytes));
+    };
+    auto writeGroup = [&in, &writeRaw](const std::vector<int64_t>* interest, size_t from, size_t rows) {
+        uint64_t count = rows;
+        writeRaw(&count, sizeof(count));
+        writeRaw(in.principal.data() + from, rows * sizeof(int64_t));
+        writeRaw(in.rate.data() + from, rows * sizeof(int64_t));
+        writeRaw(in.years.data() + from, rows * sizeof(int64_t));
+        writeRaw(interest->data(), rows * sizeof(int64_t));
+    };
+
+    writeRaw(INTEREST_FILE_MAGIC, sizeof(INTEREST_FILE_MAGIC));
+    std::vector<int64_t> buffers[2] = {std::vector<int64_t>(groupRows), std::vector<int64_t>(groupRows)};
+    std::future<void> pending;
+    int current = 0;
+    for (size_t from = 0; from < in.size(); from += groupRows) {
+        size_t rows = std::min(groupRows, in.size() - from);
+        computeInterest(in, buffers[current].data(), from, from + rows, threads);
+        if (pending.valid()) pending.get();
+        pending = std::async(std::launch::async, writeGroup, &buffers[current], from, rows);
+        current ^= 1;
+    }
+    if (pending.valid()) pending.get();
+    uint64_t end = 0;
+    writeRaw(&end, sizeof(end));
+    file.flush();
+    if (!file) throw std::runtime_error("Failed writing output file: " + path);
+    return uint64_t(file.tellp());
+}
+
+/*
+ * The interest column of every row group in a file written by streamInterestToFile
+ * Throws: runtime_error for a missing or malformed file
+ */
+inline std::vector<int64_t> readInterestColumn(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    char magic[sizeof(INTEREST_FILE_MAGIC)];
+    if (!file.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), INTEREST_FILE_MAGIC)) {
+        throw std::runtime_error("Not an interest column file: " + path);
+    }
+    std::vector<int64_t> interest;
+    uint64_t rows;
+    while (file.read(reinterpret_cast<char*>(&rows), sizeof(rows)) && rows > 0) {
+        file.seekg(std::streamoff(3 * rows * sizeof(int64_t)), std::ios::cur);   // skip the input columns
+        size_t old = interest.size();
+        interest.resize(old + rows);
+        if (!file.read(reinterpret_cast<char*>(interest.data() + old), std::streamsize(rows * sizeof(int64_t)))) {
+            throw std::runtime_error("Truncated interest column file: " + path);
+        }
+    }
+    return interest;
+}
+
+#endif // INTEREST_ENGINE_H
@@ -0,0 +1,313 @@
+/*
+ * alloc_tracking.h
+ * Instrumenting allocator and a global counters registry for the container demos.
+ * Definition: TrackingAllocator<T> is a standard allocator that forwards to operator new/delete and
+ * records every allocation in a ContainerStats entry owned by AllocationRegistry. Each container
+ * instance gets its own entry (give it a name), so a report shows, per container: allocation and
+ * deallocation counts, total and peak bytes, bytes copied by reallocation, and a histogram of
+ * allocation sizes. The registry writes the report as JSON.
+ *
+ * Usage:
+ *   TrackedVector<int> numbers = makeTracked<TrackedVector<int>>("numbers");
+ *   TrackedMap<string, int> ages = makeTracked<TrackedMap<string, int>>("ages");
+ *   TrackedQueue<int> q = makeTracked<TrackedQueue<int>>("q");   // also TrackedSet, TrackedStack
+ *   AllocationRegistry::instance().writeJson(cout);
+ *
+ * Fixed-capacity containers such as ArrayOperations<T> and Stack<T> (Typedef/) keep their elements
+ * in a member array and never allocate; register their footprint with recordStatic() so they still
+ * appear in the same report.
+ *
+ * The counters are plain integers: use one registry from one thread at a time.
+ */
+#ifndef ALLOC_TRACKING_H
+#define ALLOC_TRACKING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <new>
+#include <ostream>
+#include <queue>
+#include <set>
+#include <stack>
+#include <string>
+#include <vector>
+
+// -------------------------------------------------
+// 1. COUNTERS
+// -------------------------------------------------
+
+enum class ContainerKind {
+    CONTIGUOUS,   // one block that is replaced when it grows (vector)
+    NODE,         // many independent blocks (map, set, deque-based queue/stack)
+    FIXED         // no heap use; footprint registered with recordStatic()
+};
+
+inline const char* kindName(ContainerKind kind) {
+    switch (kind) {
+        case ContainerKind::CONTIGUOUS: return "contiguous";
+        case ContainerKind::NODE: return "node";
+        case ContainerKind::FIXED: return "fixed";
+    }
+    return "unknown";
+}
+
+/*
+ * Counters for one container instance
+ *
+ * Size histogram bucket b counts allocations of (2^(b-1), 2^b] bytes; bucket 0 counts 0-1 bytes.
+ * reallocCopyBytes is recorded for CONTIGUOUS containers only: when a new block is requested while
+ * an old one is live, the old block's bytes are counted as moved. For vector growth by push_back
+ * the old block is full at that point, so the figure is exact; after reserve() it is an upper bound.
+ */
+struct ContainerStats {
+    static const int HISTOGRAM_BUCKETS = 48;
+
+    std::string name;
+    ContainerKind kind;
+    uint64_t allocations = 0;
+    uint64_t deallocations = 0;
+    uint64_t bytesAllocated = 0;
+    uint64_t liveBytes = 0;
+    uint64_t peakBytes = 0;
+    uint64_t liveBlocks = 0;
+    uint64_t lastBlockBytes = 0;
+    uint64_t reallocations = 0;
+    uint64_t reallocCopyBytes = 0;
+    uint64_t sizeHistogram[HISTOGRAM_BUCKETS] = {};
+
+    ContainerStats(const std::string& name, ContainerKind kind) : name(name), kind(kind) {}
+
+    static int bucketFor(uint64_t bytes) {
+        int bucket = 0;
+        while (bucket < HISTOGRAM_BUCKETS - 1 && (uint64_t(1) << bucket) < bytes) ++bucket;
+        return bucket;
+    }
+
+    void onAllocate(uint64_t bytes) {
+        if (kind == ContainerKind::CONTIGUOUS && liveBlocks > 0) {
+            ++reallocations;
+            reallocCopyBytes += lastBlockBytes;
+        }
+        ++allocations;
+        ++liveBlocks;
+        bytesAllocated += bytes;
+        liveBytes += bytes;
+        if (liveBytes > peakBytes) peakBytes = liveBytes;
+        lastBlockBytes = bytes;
+        ++sizeHistogram[bucketFor(bytes)];
+    }
+
+    void onDeallocate(uint64_t bytes) {
+        ++deallocations;
+        --liveBlocks;
+        liveBytes -= bytes;
+    }
+};
+
+// -------------------------------------------------
+// 2. REGISTRY
+// -------------------------------------------------
+
+/*
+ * Owns every ContainerStats entry
+ *
+ * Entries are never freed before reset(), so a report can still be written after the containers
+ * that fed it have been destroyed.
+ */
+class AllocationRegistry {
+private:
+    std::vector<std::unique_ptr<ContainerStats>> entries;
+    ContainerStats untrackedStats;
+
+    static void writeEscaped(std::ostream& out, const std::string& text) {
+        out << '"';
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                out << '\\' << c;
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                const char* hex = "0123456789abcdef";
+                out << "\\u00" << hex[(c >> 4) & 0xF] << hex[c & 0xF];
+            } else {
+                out << c;
+            }
+        }
+        out << '"';
+    }
+
+    static void writeEntry(std::ostream& out, const ContainerStats& stats) {
+        out << "    {\"name\": ";
+        writeEscaped(out, stats.name);
+        out << ", \"kind\": \"" << kindName(stats.kind) << "\""
+            << ", \"allocations\": " << stats.allocations
+            << ", \"deallocations\": " << stats.deallocations
+            << ", \"bytes_allocated\": " << stats.bytesAllocated
+            << ", \"live_bytes\": " << stats.liveBytes
+            << ", \"peak_bytes\": " << stats.peakBytes
+            << ", \"reallocations\": " << stats.reallocations
+            << ", \"realloc_copy_bytes\": " << stats.reallocCopyBytes
+            << ", \"size_histogram\": {";
+        bool firstBucket = true;
+        for (int b = 0; b < ContainerStats::HISTOGRAM_BUCKETS; ++b) {
+            if (stats.sizeHistogram[b] == 0) continue;
+            if (!firstBucket) out << ", ";
+            out << "\"<=" << (uint64_t(1) << b) << "\": " << stats.sizeHistogram[b];
+            firstBucket = false;
+        }
+        out << "}}";
+    }
+
+    AllocationRegistry() : untrackedStats("(untracked)", ContainerKind::NODE) {}
+
+public:
+    static AllocationRegistry& instance() {
+        static AllocationRegistry registry;
+        return registry;
+    }
+
+    // Create the counters for one container instance
+    ContainerStats* track(const std::string& name, ContainerKind kind) {
+        entries.push_back(std::unique_ptr<ContainerStats>(new ContainerStats(name, kind)));
+        return entries.back().get();
+    }
+
+    // Record a container that holds its elements inline (no allocator involved)
+    ContainerStats* recordStatic(const std::string& name, uint64_t footprintBytes) {
+        ContainerStats* stats = track(name, ContainerKind::FIXED);
+        stats->liveBytes = stats->peakBytes = footprintBytes;
+        return stats;
+    }
+
+    // Counters used by default-constructed allocators (containers created without makeTracked);
+    // reported only when something was allocated through them
+    ContainerStats* untracked() { return &untrackedStats; }
+
+    const std::vector<std::unique_ptr<ContainerStats>>& all() const { return entries; }
+
+    void writeJson(std::ostream& out) const {
+        std::vector<const ContainerStats*> reported;
+        for (const auto& entry : entries) reported.push_back(entry.get());
+        if (untrackedStats.allocations > 0) reported.push_back(&untrackedStats);
+
+        uint64_t allocations = 0, bytes = 0, copyBytes = 0, peak = 0;
+        for (const ContainerStats* entry : reported) {
+            allocations += entry->allocations;
+            bytes += entry->bytesAllocated;
+            copyBytes += entry->reallocCopyBytes;
+            peak += entry->peakBytes;
+        }
+        out << "{\n  \"totals\": {\"allocations\": " << allocations << ", \"bytes_allocated\": " << bytes
+            << ", \"realloc_copy_bytes\": " << copyBytes << ", \"sum_of_peak_bytes\": " << peak << "},\n"
+            << "  \"containers\": [\n";
+        for (size_t i = 0; i < reported.size(); ++i) {
+            writeEntry(out, *reported[i]);
+            out << (i + 1 < reported.size() ? ",\n" : "\n");
+        }
+        out << "  ]\n}\n";
+    }
+
+    // Write the JSON report to a file
+    // Returns: false if the file could not be opened
+    bool dumpJson(const std::string& path) const {
+        std::ofstream out(path);
+        if (!out) return false;
+        writeJson(out);
+        return bool(out);
+    }
+
+    // Forget every named entry; containers still using their counters must be destroyed first
+    void reset() { entries.clear(); }
+};
+
+// -------------------------------------------------
+// 3. ALLOCATOR
+// -------------------------------------------------
+
+/*
+ * Template class for the instrumenting allocator
+ *
+ * Copies and rebinds share the same ContainerStats, so a map's node allocator and a deque's block
+ * and index allocators all report to the container they belong to.
+ *
+ * Template parameter T: The element type
+ */
+template <typename T>
+class TrackingAllocator {
+private:
+    ContainerStats* stats;
+
+    template <typename U>
+    friend class TrackingAllocator;
+
+public:
+    typedef T value_type;
+
+    TrackingAllocator() noexcept : stats(AllocationRegistry::instance().untracked()) {}
+    explicit TrackingAllocator(ContainerStats* stats) noexcept : stats(stats) {}
+
+    template <typename U>
+    TrackingAllocator(const TrackingAllocator<U>& other) noexcept : stats(other.stats) {}
+
+    T* allocate(size_t n) {
+        T* block = static_cast<T*>(::operator new(n * sizeof(T)));
+        stats->onAllocate(uint64_t(n) * sizeof(T));
+        return block;
+    }
+
+    void deallocate(T* block, size_t n) noexcept {
+        stats->onDeallocate(uint64_t(n) * sizeof(T));
+        ::operator delete(block);
+    }
+
+    ContainerStats* counters() const { return stats; }
+
+    template <typename U>
+    bool operator==(const TrackingAllocator<U>& other) const { return stats == other.stats; }
+    template <typename U>
+    bool operator!=(const TrackingAllocator<U>& other) const { return stats != other.stats; }
+};
+
+// -------------------------------------------------
+// 4. TRACKED CONTAINERS
+// -------------------------------------------------
+
+template <typename T>
+using TrackedVector = std::vector<T, TrackingAllocator<T>>;
+
+template <typename T>
+using TrackedDeque = std::deque<T, TrackingAllocator<T>>;
+
+template <typename T, typename Compare = std::less<T>>
+using TrackedSet = std::set<T, Compare, TrackingAllocator<T>>;
+
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+using TrackedMap = std::map<Key, Value, Compare, TrackingAllocator<std::pair<const Key, Value>>>;
+
+template <typename T>
+using TrackedQueue = std::queue<T, TrackedDeque<T>>;
+
+template <typename T>
+using TrackedStack = std::stack<T, TrackedDeque<T>>;
+
+template <typename Container>
+struct TrackedKind {
+    static const ContainerKind value = ContainerKind::NODE;
+};
+
+template <typename T>
+struct TrackedKind<TrackedVector<T>> {
+    static const ContainerKind value = ContainerKind::CONTIGUOUS;
+};
+
+// Create an empty container whose allocations are recorded under name
+template <typename Container>
+Container makeTracked(const std::string& name) {
+    typedef typename Container::value_type Element;
+    ContainerStats* stats = AllocationRegistry::instance().track(name, TrackedKind<Container>::value);
+    return Container(TrackingAllocator<Element>(stats));
+}
+
+#endif // ALLOC_TRACKING_H
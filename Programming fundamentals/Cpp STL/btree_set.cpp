@@ -0,0 +1,738 @@
+/*
+ * btree_set.cpp
+ * Demonstrates a cache-line-sized B+-tree ordered set/map as an alternative to std::set and std::map.
+ * Definition: A B+-tree stores many sorted keys per node (here sized to 64-256 bytes, i.e. 1-4 cache
+ * lines) instead of one key per red-black node. Lookups touch far fewer cache lines, all elements
+ * live in the leaves, and the leaves are linked so range scans are a walk over contiguous arrays.
+ * Shows major operations: insert, find, count, lower_bound/upper_bound, ordered iteration, erase
+ * (including erase during iteration), bulk loading from sorted input, SIMD in-node search for int
+ * keys, and a benchmark against std::set<int>.
+ * Run this file independently to see B+-tree operations in action.
+ * Usage: ./btree_set [number_of_keys]   (default 1000000; try up to 100000000 with enough memory)
+ */
+#include <iostream>
+#include <set>
+#include <vector>
+#include <algorithm>   // for sort, unique
+#include <iterator>    // for forward_iterator_tag
+#include <type_traits> // for is_same
+#include <utility>     // for pair
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define BTREE_X86 1
+#endif
+using namespace std;
+
+// -------------------------------------------------
+// 1. IN-NODE SEARCH (scalar + AVX2 for int keys)
+// -------------------------------------------------
+
+#ifdef BTREE_X86
+bool cpuHasAvx2() {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+
+// Number of keys[i] > target, 8 keys per compare
+__attribute__((target("avx2")))
+int countGreaterAvx2(const int* keys, int count, int target) {
+    __m256i needle = _mm256_set1_epi32(target);
+    int greater = 0, i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i));
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(block, needle)));
+        greater += __builtin_popcount(mask);
+    }
+    for (; i < count; ++i) greater += keys[i] > target;
+    return greater;
+}
+
+// Number of keys[i] < target, 8 keys per compare
+__attribute__((target("avx2")))
+int countLessAvx2(const int* keys, int count, int target) {
+    __m256i needle = _mm256_set1_epi32(target);
+    int less = 0, i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i));
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(needle, block)));
+        less += __builtin_popcount(mask);
+    }
+    for (; i < count; ++i) less += keys[i] < target;
+    return less;
+}
+#endif
+
+// Index of the first key >= target (keys are sorted, so this equals the count of smaller keys)
+template <typename Key>
+int nodeLowerBound(const Key* keys, int count, const Key& target) {
+#ifdef BTREE_X86
+    if constexpr (is_same<Key, int>::value) {
+        if (cpuHasAvx2()) return countLessAvx2(keys, count, target);
+    }
+#endif
+    return int(lower_bound(keys, keys + count, target) - keys);
+}
+
+// Index of the first key > target
+template <typename Key>
+int nodeUpperBound(const Key* keys, int count, const Key& target) {
+#ifdef BTREE_X86
+    if constexpr (is_same<Key, int>::value) {
+        if (cpuHasAvx2()) return count - countGreaterAvx2(keys, count, target);
+    }
+#endif
+    return int(upper_bound(keys, keys + count, target) - keys);
+}
+
+// -------------------------------------------------
+// 2. B+-TREE
+// -------------------------------------------------
+
+// Value type used by BTreeSet: leaves then carry no value array at all
+struct NoValue {};
+
+template <typename Value, size_t Capacity>
+struct LeafValues {
+    Value slots[Capacity];
+    Value& at(size_t i) { return slots[i]; }
+};
+
+template <size_t Capacity>
+struct LeafValues<NoValue, Capacity> {
+    NoValue& at(size_t) {
+        static NoValue none;
+        return none;
+    }
+};
+
+/*
+ * Template class for a B+-tree ordered map
+ *
+ * Inner node invariant: every key in children[i] is < keys[i] <= every key in children[i + 1].
+ * Every node except the root holds at least half its capacity; erase borrows from or merges with
+ * a sibling to keep it that way.
+ *
+ * Template parameter Key: The key type (ordered by operator<)
+ * Template parameter Value: The mapped type (NoValue for a set)
+ * Template parameter NodeBytes: Bytes of keys per node (64-256 keeps a node within 1-4 cache lines)
+ */
+template <typename Key, typename Value, size_t NodeBytes = 256>
+class BPlusTree {
+    static_assert(NodeBytes >= 64 && NodeBytes <= 256, "Node size should stay between 64 and 256 bytes");
+
+private:
+    static const int CAPACITY = int(NodeBytes / sizeof(Key)) < 4 ? 4 : int(NodeBytes / sizeof(Key));
+    static const int MIN_KEYS = CAPACITY / 2;
+
+    struct Node {
+        bool isLeaf;
+        int count;
+        Key keys[CAPACITY];
+        explicit Node(bool isLeaf) : isLeaf(isLeaf), count(0) {}
+    };
+
+    struct Leaf : Node {
+        LeafValues<Value, CAPACITY> values;
+        Leaf* next;
+        Leaf* prev;
+        Leaf() : Node(true), next(nullptr), prev(nullptr) {}
+    };
+
+    struct Inner : Node {
+        Node* children[CAPACITY + 1];
+        Inner() : Node(false) {}
+    };
+
+    Node* root;
+    Leaf* firstLeaf;
+    size_t elementCount;
+
+    // ----- iterator -----
+public:
+    class iterator {
+        friend class BPlusTree;
+
+    private:
+        Leaf* leaf;
+        int index;
+
+        void skipPastEnd() {
+            while (leaf && index >= leaf->count) {
+                leaf = leaf->next;
+                index = 0;
+            }
+        }
+
+    public:
+        using iterator_category = forward_iterator_tag;
+        using value_type = Key;
+        using difference_type = ptrdiff_t;
+        using pointer = const Key*;
+        using reference = const Key&;
+
+        iterator(Leaf* leaf = nullptr, int index = 0) : leaf(leaf), index(index) { skipPastEnd(); }
+        const Key& operator*() const { return leaf->keys[index]; }
+        const Key* operator->() const { return &leaf->keys[index]; }
+        Value& value() const { return leaf->values.at(index); }
+        iterator& operator++() {
+            ++index;
+            skipPastEnd();
+            return *this;
+        }
+        bool operator==(const iterator& other) const { return leaf == other.leaf && (!leaf || index == other.index); }
+        bool operator!=(const iterator& other) const { return !(*this == other); }
+    };
+
+    BPlusTree() : root(nullptr), firstLeaf(nullptr), elementCount(0) {
+        resetToEmptyLeaf();
+    }
+
+    ~BPlusTree() { destroy(root); }
+
+    BPlusTree(const BPlusTree&) = delete;
+    BPlusTree& operator=(const BPlusTree&) = delete;
+
+    iterator begin() const { return iterator(firstLeaf, 0); }
+    iterator end() const { return iterator(nullptr, 0); }
+
+    size_t size() const { return elementCount; }
+    bool empty() const { return elementCount == 0; }
+
+    // Insert a key (and value); does nothing if the key already exists
+    // Returns: iterator to the element and whether it was inserted (same as std::set::insert)
+    pair<iterator, bool> insert(const Key& key, const Value& value = Value()) {
+        Key splitKey;
+        Node* sibling = nullptr;
+        iterator position;
+        bool inserted = insertInto(root, key, value, splitKey, sibling, position);
+        if (sibling) {
+            Inner* newRoot = new Inner();
+            newRoot->keys[0] = splitKey;
+            newRoot->children[0] = root;
+            newRoot->children[1] = sibling;
+            newRoot->count = 1;
+            root = newRoot;
+        }
+        if (inserted) ++elementCount;
+        return {position, inserted};
+    }
+
+    // First element >= key
+    iterator lower_bound(const Key& key) const {
+        Leaf* leaf = findLeaf(key);
+        return iterator(leaf, nodeLowerBound(leaf->keys, leaf->count, key));
+    }
+
+    // First element > key
+    iterator upper_bound(const Key& key) const {
+        Leaf* leaf = findLeaf(key);
+        return iterator(leaf, nodeUpperBound(leaf->keys, leaf->count, key));
+    }
+
+    iterator find(const Key& key) const {
+        iterator it = lower_bound(key);
+        return (it != end() && !(key < *it)) ? it : end();
+    }
+
+    size_t count(const Key& key) const { return find(key) != end() ? 1 : 0; }
+
+    // Access or insert a default value (map semantics)
+    Value& operator[](const Key& key) { return insert(key, Value()).first.value(); }
+
+    // Erase by key
+    // Returns: Number of removed elements (0 or 1)
+    size_t erase(const Key& key) {
+        if (!eraseFrom(root, key)) return 0;
+        --elementCount;
+        if (!root->isLeaf && root->count == 0) {
+            Inner* oldRoot = static_cast<Inner*>(root);
+            root = oldRoot->children[0];
+            delete oldRoot;
+        }
+        return 1;
+    }
+
+    // Erase by position, safe inside an iteration loop
+    // Returns: iterator to the element after the erased one
+    iterator erase(iterator position) {
+        Key key = *position;
+        erase(key);
+        return upper_bound(key);   // Nodes may have been merged: search again
+    }
+
+    // Bulk load from sorted input: O(n), leaves packed nearly full and linked left to right.
+    // Duplicate keys are skipped (the first occurrence wins).
+    // Throws: invalid_argument if the input is not sorted
+    template <typename InputIt>
+    void buildFromSorted(InputIt first, InputIt last) {
+        vector<pair<Key, Value>> items;
+        for (; first != last; ++first) {
+            Key key = keyOf(*first);
+            if (!items.empty() && key < items.back().first) throw invalid_argument("buildFromSorted: input is not sorted");
+            if (!items.empty() && !(items.back().first < key)) continue;
+            items.push_back({key, valueOf(*first)});
+        }
+
+        destroy(root);
+        elementCount = items.size();
+        if (items.empty()) {
+            resetToEmptyLeaf();
+            return;
+        }
+
+        // Leaves: spread items evenly so no leaf is under half full
+        size_t leafCount = (items.size() + CAPACITY - 1) / CAPACITY;
+        vector<Node*> level;
+        vector<Key> levelMinKeys;
+        Leaf* previous = nullptr;
+        size_t taken = 0;
+        for (size_t l = 0; l < leafCount; ++l) {
+            size_t share = (items.size() - taken) / (leafCount - l);
+            Leaf* leaf = new Leaf();
+            for (size_t k = 0; k < share; ++k, ++taken) {
+                leaf->keys[k] = items[taken].first;
+                leaf->values.at(k) = items[taken].second;
+            }
+            leaf->count = int(share);
+            leaf->prev = previous;
+            if (previous) previous->next = leaf;
+            previous = leaf;
+            level.push_back(leaf);
+            levelMinKeys.push_back(leaf->keys[0]);
+        }
+        firstLeaf = static_cast<Leaf*>(level[0]);
+
+        // Inner levels: each parent takes up to CAPACITY + 1 children
+        while (level.size() > 1) {
+            size_t parentCount = (level.size() + CAPACITY) / (CAPACITY + 1);
+            vector<Node*> parents;
+            vector<Key> parentMinKeys;
+            size_t child = 0;
+            for (size_t p = 0; p < parentCount; ++p) {
+                size_t share = (level.size() - child) / (parentCount - p);
+                Inner* inner = new Inner();
+                parentMinKeys.push_back(levelMinKeys[child]);
+                for (size_t k = 0; k < share; ++k, ++child) {
+                    inner->children[k] = level[child];
+                    if (k > 0) inner->keys[k - 1] = levelMinKeys[child];
+                }
+                inner->count = int(share) - 1;
+                parents.push_back(inner);
+            }
+            level.swap(parents);
+            levelMinKeys.swap(parentMinKeys);
+        }
+        root = level[0];
+    }
+
+    void clear() {
+        destroy(root);
+        elementCount = 0;
+        resetToEmptyLeaf();
+    }
+
+    // Tree height (1 = the root is a leaf)
+    int height() const {
+        int levels = 1;
+        for (Node* node = root; !node->isLeaf; node = static_cast<Inner*>(node)->children[0]) ++levels;
+        return levels;
+    }
+
+    static int nodeCapacity() { return CAPACITY; }
+
+private:
+    static const Key& keyOf(const Key& key) { return key; }
+    template <typename Pair>
+    static const Key& keyOf(const Pair& entry) { return entry.first; }
+    static Value valueOf(const Key&) { return Value(); }
+    template <typename Pair>
+    static const Value& valueOf(const Pair& entry) { return entry.second; }
+
+    void resetToEmptyLeaf() {
+        Leaf* leaf = new Leaf();
+        root = leaf;
+        firstLeaf = leaf;
+    }
+
+    void destroy(Node* node) {
+        if (!node) return;
+        if (!node->isLeaf) {
+            Inner* inner = static_cast<Inner*>(node);
+            for (int i = 0; i <= inner->count; ++i) destroy(inner->children[i]);
+            delete inner;
+        } else {
+            delete static_cast<Leaf*>(node);
+        }
+    }
+
+    Leaf* findLeaf(const Key& key) const {
+        Node* node = root;
+        while (!node->isLeaf) {
+            Inner* inner = static_cast<Inner*>(node);
+            node = inner->children[nodeUpperBound(inner->keys, inner->count, key)];
+        }
+        return static_cast<Leaf*>(node);
+    }
+
+    // Recursive insert. When node splits, the new right sibling and its separator key are returned.
+    bool insertInto(Node* node, const Key& key, const Value& value, Key& splitKey, Node*& sibling, iterator& position) {
+        sibling = nullptr;
+        if (node->isLeaf) {
+            Leaf* leaf = static_cast<Leaf*>(node);
+            int slot = nodeLowerBound(leaf->keys, leaf->count, key);
+            if (slot < leaf->count && !(key < leaf->keys[slot])) {
+                position = iterator(leaf, slot);
+                return false;
+            }
+            if (leaf->count == CAPACITY) {
+                Leaf* right = splitLeaf(leaf);
+                splitKey = right->keys[0];
+                sibling = right;
+                if (slot > leaf->count) {
+                    slot -= leaf->count;
+                    leaf = right;
+                }
+            }
+            for (int i = leaf->count; i > slot; --i) {
+                leaf->keys[i] = leaf->keys[i - 1];
+                leaf->values.at(i) = leaf->values.at(i - 1);
+            }
+            leaf->keys[slot] = key;
+            leaf->values.at(slot) = value;
+            ++leaf->count;
+            position = iterator(leaf, slot);
+            return true;
+        }
+
+        Inner* inner = static_cast<Inner*>(node);
+        int childIndex = nodeUpperBound(inner->keys, inner->count, key);
+        Key childSplitKey;
+        Node* childSibling = nullptr;
+        bool inserted = insertInto(inner->children[childIndex], key, value, childSplitKey, childSibling, position);
+        if (!childSibling) return inserted;
+
+        if (inner->count == CAPACITY) {
+            Inner* right = splitInner(inner, splitKey);
+            sibling = right;
+            if (childIndex > inner->count) {
+                childIndex -= inner->count + 1;
+                inner = right;
+            }
+        }
+        for (int i = inner->count; i > childIndex; --i) {
+            inner->keys[i] = inner->keys[i - 1];
+            inner->children[i + 1] = inner->children[i];
+        }
+        inner->keys[childIndex] = childSplitKey;
+        inner->children[childIndex + 1] = childSibling;
+        ++inner->count;
+        return inserted;
+    }
+
+    Leaf* splitLeaf(Leaf* leaf) {
+        Leaf* right = new Leaf();
+        int keep = leaf->count / 2;
+        for (int i = keep; i < leaf->count; ++i) {
+            right->keys[i - keep] = leaf->keys[i];
+            right->values.at(i - keep) = leaf->values.at(i);
+        }
+        right->count = leaf->count - keep;
+        leaf->count = keep;
+        right->next = leaf->next;
+        right->prev = leaf;
+        if (leaf->next) leaf->next->prev = right;
+        leaf->next = right;
+        return right;
+    }
+
+    // Moves the upper half into a new node; the middle key moves up through separator
+    Inner* splitInner(Inner* inner, Key& separator) {
+        Inner* right = new Inner();
+        int middle = inner->count / 2;
+        separator = inner->keys[middle];
+        for (int i = middle + 1; i < inner->count; ++i) right->keys[i - middle - 1] = inner->keys[i];
+        for (int i = middle + 1; i <= inner->count; ++i) right->children[i - middle - 1] = inner->children[i];
+        right->count = inner->count - middle - 1;
+        inner->count = middle;
+        return right;
+    }
+
+    // Recursive erase; fixes up any child left under half full
+    bool eraseFrom(Node* node, const Key& key) {
+        if (node->isLeaf) {
+            Leaf* leaf = static_cast<Leaf*>(node);
+            int slot = nodeLowerBound(leaf->keys, leaf->count, key);
+            if (slot == leaf->count || key < leaf->keys[slot]) return false;
+            for (int i = slot; i + 1 < leaf->count; ++i) {
+                leaf->keys[i] = leaf->keys[i + 1];
+                leaf->values.at(i) = leaf->values.at(i + 1);
+            }
+            --leaf->count;
+            return true;
+        }
+
+        Inner* inner = static_cast<Inner*>(node);
+        int childIndex = nodeUpperBound(inner->keys, inner->count, key);
+        if (!eraseFrom(inner->children[childIndex], key)) return false;
+        if (inner->children[childIndex]->count < MIN_KEYS) rebalanceChild(inner, childIndex);
+        return true;
+    }
+
+    void rebalanceChild(Inner* parent, int i) {
+        Node* left = (i > 0) ? parent->children[i - 1] : nullptr;
+        Node* right = (i < parent->count) ? parent->children[i + 1] : nullptr;
+
+        if (left && left->count > MIN_KEYS) {
+            borrowFromLeft(parent, i);
+        } else if (right && right->count > MIN_KEYS) {
+            borrowFromRight(parent, i);
+        } else if (left) {
+            mergeChildren(parent, i - 1);
+        } else if (right) {
+            mergeChildren(parent, i);
+        }
+    }
+
+    void borrowFromLeft(Inner* parent, int i) {
+        Node* child = parent->children[i];
+        Node* left = parent->children[i - 1];
+        if (child->isLeaf) {
+            Leaf* c = static_cast<Leaf*>(child);
+            Leaf* l = static_cast<Leaf*>(left);
+            for (int k = c->count; k > 0; --k) {
+                c->keys[k] = c->keys[k - 1];
+                c->values.at(k) = c->values.at(k - 1);
+            }
+            c->keys[0] = l->keys[l->count - 1];
+            c->values.at(0) = l->values.at(l->count - 1);
+            ++c->count;
+            --l->count;
+            parent->keys[i - 1] = c->keys[0];
+        } else {
+            Inner* c = static_cast<Inner*>(child);
+            Inner* l = static_cast<Inner*>(left);
+            for (int k = c->count; k > 0; --k) c->keys[k] = c->keys[k - 1];
+            for (int k = c->count + 1; k > 0; --k) c->children[k] = c->children[k - 1];
+            c->keys[0] = parent->keys[i - 1];
+            c->children[0] = l->children[l->count];
+            ++c->count;
+            parent->keys[i - 1] = l->keys[l->count - 1];
+            --l->count;
+        }
+    }
+
+    void borrowFromRight(Inner* parent, int i) {
+        Node* child = parent->children[i];
+        Node* right = parent->children[i + 1];
+        if (child->isLeaf) {
+            Leaf* c = static_cast<Leaf*>(child);
+            Leaf* r = static_cast<Leaf*>(right);
+            c->keys[c->count] = r->keys[0];
+            c->values.at(c->count) = r->values.at(0);
+            ++c->count;
+            for (int k = 0; k + 1 < r->count; ++k) {
+                r->keys[k] = r->keys[k + 1];
+                r->values.at(k) = r->values.at(k + 1);
+            }
+            --r->count;
+            parent->keys[i] = r->keys[0];
+        } else {
+            Inner* c = static_cast<Inner*>(child);
+            Inner* r = static_cast<Inner*>(right);
+            c->keys[c->count] = parent->keys[i];
+            c->children[c->count + 1] = r->children[0];
+            ++c->count;
+            parent->keys[i] = r->keys[0];
+            for (int k = 0; k + 1 < r->count; ++k) r->keys[k] = r->keys[k + 1];
+            for (int k = 0; k < r->count; ++k) r->children[k] = r->children[k + 1];
+            --r->count;
+        }
+    }
+
+    // Merge children[i + 1] into children[i] and drop separator keys[i]
+    void mergeChildren(Inner* parent, int i) {
+        Node* leftNode = parent->children[i];
+        Node* rightNode = parent->children[i + 1];
+        if (leftNode->isLeaf) {
+            Leaf* l = static_cast<Leaf*>(leftNode);
+            Leaf* r = static_cast<Leaf*>(rightNode);
+            for (int k = 0; k < r->count; ++k) {
+                l->keys[l->count + k] = r->keys[k];
+                l->values.at(l->count + k) = r->values.at(k);
+            }
+            l->count += r->count;
+            l->next = r->next;
+            if (r->next) r->next->prev = l;
+            delete r;
+        } else {
+            Inner* l = static_cast<Inner*>(leftNode);
+            Inner* r = static_cast<Inner*>(rightNode);
+            l->keys[l->count] = parent->keys[i];
+            for (int k = 0; k < r->count; ++k) l->keys[l->count + 1 + k] = r->keys[k];
+            for (int k = 0; k <= r->count; ++k) l->children[l->count + 1 + k] = r->children[k];
+            l->count += r->count + 1;
+            delete r;
+        }
+        for (int k = i; k + 1 < parent->count; ++k) parent->keys[k] = parent->keys[k + 1];
+        for (int k = i + 1; k < parent->count; ++k) parent->children[k] = parent->children[k + 1];
+        --parent->count;
+    }
+};
+
+// std::set / std::map style names
+template <typename Key, size_t NodeBytes = 256>
+using BTreeSet = BPlusTree<Key, NoValue, NodeBytes>;
+
+template <typename Key, typename Value, size_t NodeBytes = 256>
+using BTreeMap = BPlusTree<Key, Value, NodeBytes>;
+
+// -------------------------------------------------
+// 3. BENCHMARK AGAINST std::set<int>
+// -------------------------------------------------
+
+using Clock = chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start) {
+    return chrono::duration<double, milli>(Clock::now() - start).count();
+}
+
+// Returns: false if the tree disagrees with std::set (also reported on cerr)
+template <size_t NodeBytes>
+bool benchmarkTree(const char* label, const vector<int>& keys, const vector<int>& sortedKeys,
+                   const vector<int>& probes, long long expectedHits) {
+    auto start = Clock::now();
+    BTreeSet<int, NodeBytes> tree;
+    for (int key : keys) tree.insert(key);
+    double insertMs = elapsedMs(start);
+
+    start = Clock::now();
+    long long hits = 0;
+    for (int probe : probes) hits += tree.count(probe);
+    double findNs = elapsedMs(start) * 1e6 / probes.size();
+
+    start = Clock::now();
+    long long sum = 0;
+    for (int key : tree) sum += key;
+    double scanMs = elapsedMs(start);
+
+    BTreeSet<int, NodeBytes> bulk;
+    start = Clock::now();
+    bulk.buildFromSorted(sortedKeys.begin(), sortedKeys.end());
+    double bulkMs = elapsedMs(start);
+
+    bool consistent = hits == expectedHits && bulk.size() == tree.size();
+    if (!consistent) cerr << "Mismatch between implementations! (" << label << ")" << endl;
+    cout << label << "  " << insertMs << "  " << findNs << "  " << scanMs << "  " << bulkMs
+         << "  (height " << tree.height() << ", checksum " << sum % 1000 << ")" << endl;
+    return consistent;
+}
+
+// Returns: false if the implementations disagree (also reported on cerr)
+bool runBenchmark(size_t count) {
+    cout << "\n=== BENCHMARK: " << count << " random int keys ===" << endl;
+    mt19937 rng(5);
+    vector<int> keys(count);
+    for (int& key : keys) key = int(rng() % (count * 2));
+    vector<int> sortedKeys = keys;
+    sort(sortedKeys.begin(), sortedKeys.end());
+    vector<int> probes(count);
+    for (int& probe : probes) probe = int(rng() % (count * 2));
+
+    auto start = Clock::now();
+    set<int> tree(keys.begin(), keys.end());
+    double insertMs = elapsedMs(start);
+
+    start = Clock::now();
+    long long hits = 0;
+    for (int probe : probes) hits += tree.count(probe);
+    double findNs = elapsedMs(start) * 1e6 / probes.size();
+
+    start = Clock::now();
+    long long sum = 0;
+    for (int key : tree) sum += key;
+    double scanMs = elapsedMs(start);
+
+    start = Clock::now();
+    set<int> hinted;
+    for (int key : sortedKeys) hinted.insert(hinted.end(), key);
+    double bulkMs = elapsedMs(start);
+
+#ifdef BTREE_X86
+    cout << "AVX2 in-node search: " << (cpuHasAvx2() ? "yes" : "no") << endl;
+#endif
+    cout << "Container          insert(ms)  find(ns)  scan(ms)  bulk-load(ms)" << endl;
+    cout << "std::set<int>      " << insertMs << "  " << findNs << "  " << scanMs << "  " << bulkMs
+         << "  (checksum " << sum % 1000 << ")" << endl;
+    bool consistent = benchmarkTree<64>("BTreeSet 64B node ", keys, sortedKeys, probes, hits);
+    consistent = benchmarkTree<128>("BTreeSet 128B node", keys, sortedKeys, probes, hits) && consistent;
+    consistent = benchmarkTree<256>("BTreeSet 256B node", keys, sortedKeys, probes, hits) && consistent;
+    return consistent;
+}
+
+int main(int argc, char* argv[]) {
+    BTreeSet<int> s;
+
+    // Insert elements
+    s.insert(5);
+    s.insert(1);
+    s.insert(3);
+    s.insert(5); // duplicate, will not be added
+    for (int i = 10; i <= 200; i += 10) s.insert(i);
+
+    // Iterate and print (leaves are linked, so this is a linear scan)
+    cout << "Set contents: ";
+    for (int n : s) cout << n << " ";
+    cout << endl;
+
+    // Find element
+    int value = 3;
+    if (s.find(value) != s.end()) {
+        cout << value << " found in set" << endl;
+    } else {
+        cout << value << " not found in set" << endl;
+    }
+
+    // Range scan with lower_bound
+    cout << "Range [45, 95): ";
+    for (auto it = s.lower_bound(45); it != s.end() && *it < 95; ++it) cout << *it << " ";
+    cout << endl;
+
+    // Erase during iteration: drop every multiple of 20
+    for (auto it = s.begin(); it != s.end();) {
+        it = (*it % 20 == 0) ? s.erase(it) : ++it;
+    }
+    cout << "After erasing multiples of 20: ";
+    for (int n : s) cout << n << " ";
+    cout << endl;
+
+    // Erase element
+    s.erase(1);
+    cout << "After erasing 1, size: " << s.size() << endl;
+
+    // Map usage
+    BTreeMap<int, const char*> names;
+    names[30] = "thirty";
+    names[10] = "ten";
+    names.insert(20, "twenty");
+    for (auto it = names.begin(); it != names.end(); ++it) cout << *it << " -> " << it.value() << endl;
+
+    // Bulk load from sorted input
+    vector<int> sorted = {2, 4, 6, 8, 10, 12};
+    BTreeSet<int> loaded;
+    loaded.buildFromSorted(sorted.begin(), sorted.end());
+    cout << "Bulk loaded size: " << loaded.size() << ", node capacity: " << BTreeSet<int>::nodeCapacity() << " keys" << endl;
+
+    // Clear all
+    s.clear();
+    cout << "After clear, set size: " << s.size() << endl;
+
+    size_t count = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 1000000;
+    if (!runBenchmark(count)) return 1;
+
+    return 0;
+}
@@ -0,0 +1,270 @@
+/*
+ * concurrent_map.cpp
+ * Demonstrates a sharded concurrent map for read-mostly workloads in C++.
+ * Definition: A sharded map splits its keys across N independent shards chosen by hash. Each shard
+ * has its own reader-writer lock, so readers never block each other and a writer only blocks the
+ * one shard it is updating.
+ * Shows major operations: upsert, find, erase, consistent per-shard forEach, size, and a throughput
+ * benchmark against std::map behind a single std::mutex (many readers + one background writer).
+ * Run this file independently to see concurrent map operations in action.
+ * Compile with: g++ -std=c++17 -O2 -pthread concurrent_map.cpp
+ * Usage: ./concurrent_map [reader_threads] [milliseconds_per_run]
+ */
+#include <iostream>
+#include <map>
+#include <unordered_map>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <functional>  // for hash
+#include <cstdlib>
+using namespace std;
+
+// Size of a cache line: each shard starts on its own line so locks do not false-share
+const size_t CACHE_LINE_SIZE = 64;
+
+/*
+ * Template class for a sharded, read-mostly concurrent map
+ *
+ * Why a reader-writer lock and not a seqlock? A seqlock lets readers copy data that a writer is
+ * modifying and retry afterwards. That is only safe for trivially copyable values; reading a
+ * std::string while it reallocates would touch freed memory. A shared_mutex gives the same
+ * "readers never block readers" property for any key/value type.
+ *
+ * Template parameter Key: The key type (must be hashable)
+ * Template parameter Value: The mapped type
+ * Template parameter ShardCount: Number of shards (power of two so the shard is a mask, not a modulo)
+ */
+template <typename Key, typename Value, size_t ShardCount = 64>
+class ConcurrentMap {
+    static_assert((ShardCount & (ShardCount - 1)) == 0, "ShardCount must be a power of two");
+
+private:
+    struct alignas(CACHE_LINE_SIZE) Shard {
+        mutable shared_mutex lock;
+        unordered_map<Key, Value> entries;
+    };
+
+    Shard shards[ShardCount];
+    hash<Key> hasher;
+
+    Shard& shardFor(const Key& key) {
+        // Mix the high bits in: some std::hash implementations are the identity for integers
+        size_t h = hasher(key);
+        h ^= h >> 29;
+        return shards[h & (ShardCount - 1)];
+    }
+
+public:
+    // Insert a new key or overwrite an existing one
+    // Returns: true if the key was newly inserted
+    bool upsert(const Key& key, const Value& value) {
+        Shard& shard = shardFor(key);
+        unique_lock<shared_mutex> guard(shard.lock);
+        auto result = shard.entries.insert_or_assign(key, value);
+        return result.second;
+    }
+
+    // Look up a key; the value is copied out so no reference escapes the lock
+    // Parameter: out - Receives the value when the key is found
+    // Returns: true if the key was found
+    bool find(const Key& key, Value& out) {
+        Shard& shard = shardFor(key);
+        shared_lock<shared_mutex> guard(shard.lock);
+        auto it = shard.entries.find(key);
+        if (it == shard.entries.end()) return false;
+        out = it->second;
+        return true;
+    }
+
+    // Erase a key
+    // Returns: true if the key was present
+    bool erase(const Key& key) {
+        Shard& shard = shardFor(key);
+        unique_lock<shared_mutex> guard(shard.lock);
+        return shard.entries.erase(key) > 0;
+    }
+
+    // Visit every entry. Each shard is visited under its shared lock, so the entries seen for one
+    // shard form a consistent snapshot; different shards may be observed at different moments.
+    // Parameter: visit - Called as visit(key, value); must not call back into this map
+    void forEach(const function<void(const Key&, const Value&)>& visit) const {
+        for (const Shard& shard : shards) {
+            shared_lock<shared_mutex> guard(shard.lock);
+            for (const auto& entry : shard.entries) {
+                visit(entry.first, entry.second);
+            }
+        }
+    }
+
+    // Total number of entries (approximate while writers are active)
+    size_t size() const {
+        size_t total = 0;
+        for (const Shard& shard : shards) {
+            shared_lock<shared_mutex> guard(shard.lock);
+            total += shard.entries.size();
+        }
+        return total;
+    }
+
+    void clear() {
+        for (Shard& shard : shards) {
+            unique_lock<shared_mutex> guard(shard.lock);
+            shard.entries.clear();
+        }
+    }
+};
+
+/*
+ * Baseline for the benchmark: std::map behind one std::mutex
+ * Every reader serialises on the same lock, so throughput cannot grow with core count.
+ */
+template <typename Key, typename Value>
+class LockedMap {
+private:
+    mutex lock;
+    map<Key, Value> entries;
+
+public:
+    bool upsert(const Key& key, const Value& value) {
+        lock_guard<mutex> guard(lock);
+        return entries.insert_or_assign(key, value).second;
+    }
+
+    bool find(const Key& key, Value& out) {
+        lock_guard<mutex> guard(lock);
+        auto it = entries.find(key);
+        if (it == entries.end()) return false;
+        out = it->second;
+        return true;
+    }
+};
+
+// -------------------------------------------------
+// BENCHMARK: N reader threads + 1 writer thread
+// -------------------------------------------------
+
+const int BENCH_KEY_COUNT = 100000;
+
+// Runs readers against the map while one writer keeps updating it
+// Returns: Lookups per second summed over all reader threads
+template <typename MapType>
+double measureLookupThroughput(MapType& ages, const vector<string>& names, int readers, int runMs) {
+    atomic<bool> stop(false);
+    atomic<long long> totalLookups(0);
+
+    thread writer([&]() {
+        mt19937 rng(7);
+        while (!stop.load(memory_order_relaxed)) {
+            ages.upsert(names[rng() % names.size()], int(rng() % 100));
+        }
+    });
+
+    vector<thread> workers;
+    for (int t = 0; t < readers; ++t) {
+        workers.emplace_back([&, t]() {
+            mt19937 rng(100 + t);
+            long long lookups = 0;
+            int age = 0;
+            while (!stop.load(memory_order_relaxed)) {
+                for (int i = 0; i < 256; ++i) {
+                    ages.find(names[rng() % names.size()], age);
+                }
+                lookups += 256;
+            }
+            totalLookups += lookups;
+        });
+    }
+
+    this_thread::sleep_for(chrono::milliseconds(runMs));
+    stop = true;
+    writer.join();
+    for (thread& worker : workers) worker.join();
+    return totalLookups.load() * 1000.0 / runMs;
+}
+
+void runBenchmark(int maxReaders, int runMs) {
+    cout << "\n=== BENCHMARK: lookups/s with 1 background writer ===" << endl;
+    vector<string> names;
+    for (int i = 0; i < BENCH_KEY_COUNT; ++i) names.push_back("person_" + to_string(i));
+
+    // Doubling reader counts, always ending with maxReaders itself
+    vector<int> steps;
+    for (int readers = 1; readers < maxReaders; readers *= 2) steps.push_back(readers);
+    steps.push_back(maxReaders);
+
+    cout << "Readers   std::map+mutex     ConcurrentMap" << endl;
+    for (int readers : steps) {
+        LockedMap<string, int> locked;
+        ConcurrentMap<string, int> sharded;
+        for (int i = 0; i < BENCH_KEY_COUNT; ++i) {
+            locked.upsert(names[i], i % 100);
+            sharded.upsert(names[i], i % 100);
+        }
+        double lockedRate = measureLookupThroughput(locked, names, readers, runMs);
+        double shardedRate = measureLookupThroughput(sharded, names, readers, runMs);
+        cout << readers << "         " << lockedRate << "        " << shardedRate << endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    ConcurrentMap<string, int> age;
+
+    // Insert elements
+    age.upsert("Alice", 25);
+    age.upsert("Bob", 30);
+    age.upsert("Charlie", 22);
+
+    // Concurrent updates: every thread owns its own keys, readers run at the same time
+    vector<thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&age, t]() {
+            for (int i = 0; i < 1000; ++i) {
+                age.upsert("worker" + to_string(t) + "_" + to_string(i), i);
+                int alice = 0;
+                age.find("Alice", alice);
+            }
+        });
+    }
+    for (thread& worker : threads) worker.join();
+    cout << "Map size after 4 threads x 1000 upserts: " << age.size() << endl;
+
+    // Find element
+    string name = "Bob";
+    int bobAge = 0;
+    if (age.find(name, bobAge)) {
+        cout << name << " found, age = " << bobAge << endl;
+    } else {
+        cout << name << " not found" << endl;
+    }
+
+    // Erase element
+    age.erase("Alice");
+    int ignored = 0;
+    cout << "After erasing Alice, found: " << (age.find("Alice", ignored) ? "yes" : "no") << endl;
+
+    // Iterate (consistent per shard)
+    long long ageSum = 0;
+    age.forEach([&ageSum](const string&, const int& value) { ageSum += value; });
+    cout << "Sum of all ages via forEach: " << ageSum << endl;
+
+    // Clear all
+    age.clear();
+    cout << "After clear, map size: " << age.size() << endl;
+
+    int hardwareThreads = int(thread::hardware_concurrency());
+    int maxReaders = (argc > 1) ? atoi(argv[1]) : (hardwareThreads > 0 ? hardwareThreads : 4);
+    int runMs = (argc > 2) ? atoi(argv[2]) : 300;
+    if (maxReaders < 1 || runMs < 1) {
+        cerr << "Usage: " << argv[0] << " [reader_threads >= 1] [milliseconds_per_run >= 1]" << endl;
+        return 2;
+    }
+    runBenchmark(maxReaders, runMs);
+
+    return 0;
+}
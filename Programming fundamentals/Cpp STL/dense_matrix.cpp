@@ -0,0 +1,494 @@
+/*
+ * dense_matrix.cpp
+ * Demonstrates a cache-blocked dense matrix as a replacement for vector<vector<double>> grids.
+ * Definition: A dense row-major matrix stores all rows in ONE aligned buffer. Element (i, j) lives at
+ * data[i * ld + j], where the leading dimension ld >= cols lets every row start on a 64-byte boundary.
+ * Working on small tiles (blocks) that fit in cache makes transpose and multiply reuse loaded data
+ * instead of streaming whole columns through memory.
+ * Shows major operations: construction, element access, cache-blocked transpose, GEMV and blocked GEMM
+ * with AVX2/FMA kernels (picked at runtime, scalar fallback otherwise), multithreaded row-panel
+ * partitioning for both, and a benchmark against naive loops over vector<vector<double>> at sizes
+ * from 256 upward.
+ * Run this file independently to see dense matrix operations in action.
+ * Compile with: g++ -std=c++17 -O2 -pthread dense_matrix.cpp
+ * Usage: ./dense_matrix [max_size]   (default 1024; sizes double from 256 up to max_size, e.g. 8192)
+ */
+#include <iostream>
+#include <vector>
+#include <algorithm>   // for min, fill
+#include <thread>
+#include <chrono>
+#include <random>
+#include <cmath>       // for fabs
+#include <cstdlib>     // for aligned_alloc, free
+#include <cstring>     // for memcpy
+#include <stdexcept>
+#include <new>         // for bad_alloc
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define MATRIX_X86 1
+#endif
+using namespace std;
+
+const size_t MATRIX_ALIGNMENT = 64;      // One cache line; also satisfies AVX-512 loads
+const size_t TRANSPOSE_BLOCK = 32;       // 32 x 32 doubles = 8 KB per tile, fits L1 twice
+const size_t GEMM_K_BLOCK = 256;         // Depth of one pass: a K_BLOCK x N_BLOCK panel of B stays in L2
+const size_t GEMM_N_BLOCK = 512;
+const size_t GEMV_MIN_PANEL = 1 << 16;   // Elements of A per thread below which GEMV stays on one thread
+
+// -------------------------------------------------
+// 1. MATRIX TYPE
+// -------------------------------------------------
+
+/*
+ * Row-major dense matrix with a single aligned allocation
+ * The leading dimension is rounded up so each row starts on a cache-line boundary.
+ */
+class Matrix {
+private:
+    size_t rowCount;
+    size_t colCount;
+    size_t leading;
+    double* buffer;
+
+    static size_t paddedLeading(size_t cols) {
+        size_t perLine = MATRIX_ALIGNMENT / sizeof(double);
+        return ((cols + perLine - 1) / perLine) * perLine;
+    }
+
+public:
+    // Parameter: leadingDimension - Row stride in elements (0 = cols rounded up to a cache line)
+    // Throws: invalid_argument if leadingDimension < cols
+    Matrix(size_t rows, size_t cols, size_t leadingDimension = 0)
+        : rowCount(rows), colCount(cols), leading(leadingDimension ? leadingDimension : paddedLeading(cols)), buffer(nullptr) {
+        if (leading < cols) throw invalid_argument("Leading dimension must be at least the column count");
+        size_t bytes = rows * leading * sizeof(double);
+        bytes = ((bytes + MATRIX_ALIGNMENT - 1) / MATRIX_ALIGNMENT) * MATRIX_ALIGNMENT;
+        if (bytes) {
+            buffer = static_cast<double*>(aligned_alloc(MATRIX_ALIGNMENT, bytes));
+            if (!buffer) throw bad_alloc();
+            memset(buffer, 0, bytes);
+        }
+    }
+
+    ~Matrix() { free(buffer); }
+
+    Matrix(const Matrix& other) : Matrix(other.rowCount, other.colCount, other.leading) {
+        if (buffer) memcpy(buffer, other.buffer, rowCount * leading * sizeof(double));
+    }
+
+    Matrix(Matrix&& other) noexcept
+        : rowCount(other.rowCount), colCount(other.colCount), leading(other.leading), buffer(other.buffer) {
+        other.buffer = nullptr;
+        other.rowCount = other.colCount = 0;
+    }
+
+    Matrix& operator=(Matrix other) {
+        swap(rowCount, other.rowCount);
+        swap(colCount, other.colCount);
+        swap(leading, other.leading);
+        swap(buffer, other.buffer);
+        return *this;
+    }
+
+    size_t rows() const { return rowCount; }
+    size_t cols() const { return colCount; }
+    size_t ld() const { return leading; }
+
+    double& operator()(size_t i, size_t j) { return buffer[i * leading + j]; }
+    double operator()(size_t i, size_t j) const { return buffer[i * leading + j]; }
+
+    double* row(size_t i) { return buffer + i * leading; }
+    const double* row(size_t i) const { return buffer + i * leading; }
+
+    void fill(double value) {
+        for (size_t i = 0; i < rowCount; ++i) std::fill(row(i), row(i) + colCount, value);
+    }
+};
+
+// -------------------------------------------------
+// 2. TRANSPOSE AND GEMV
+// -------------------------------------------------
+
+#ifdef MATRIX_X86
+bool cpuHasAvx2Fma() {
+    static const bool supported = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    return supported;
+}
+#endif
+
+// Cache-blocked transpose: reads and writes TRANSPOSE_BLOCK x TRANSPOSE_BLOCK tiles, so both the
+// source rows and the destination rows of a tile stay in L1 instead of striding across memory.
+Matrix transpose(const Matrix& a) {
+    Matrix result(a.cols(), a.rows());
+    for (size_t ib = 0; ib < a.rows(); ib += TRANSPOSE_BLOCK) {
+        for (size_t jb = 0; jb < a.cols(); jb += TRANSPOSE_BLOCK) {
+            size_t iEnd = min(ib + TRANSPOSE_BLOCK, a.rows());
+            size_t jEnd = min(jb + TRANSPOSE_BLOCK, a.cols());
+            for (size_t i = ib; i < iEnd; ++i) {
+                for (size_t j = jb; j < jEnd; ++j) result(j, i) = a(i, j);
+            }
+        }
+    }
+    return result;
+}
+
+// Scalar GEMV kernel: y[i] = A[i, :] . x for rows [rowBegin, rowEnd)
+void gemvRowsScalar(const Matrix& a, const double* x, double* y, size_t rowBegin, size_t rowEnd) {
+    for (size_t i = rowBegin; i < rowEnd; ++i) {
+        const double* r = a.row(i);
+        double sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;   // Independent sums hide FP add latency
+        size_t j = 0;
+        for (; j + 4 <= a.cols(); j += 4) {
+            sum0 += r[j] * x[j];
+            sum1 += r[j + 1] * x[j + 1];
+            sum2 += r[j + 2] * x[j + 2];
+            sum3 += r[j + 3] * x[j + 3];
+        }
+        for (; j < a.cols(); ++j) sum0 += r[j] * x[j];
+        y[i] = (sum0 + sum1) + (sum2 + sum3);
+    }
+}
+
+#ifdef MATRIX_X86
+__attribute__((target("avx2,fma")))
+double horizontalSum(__m256d v) {
+    __m128d pair = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(pair, _mm_unpackhi_pd(pair, pair)));
+}
+
+/*
+ * AVX2/FMA GEMV kernel, 4 rows at a time
+ * Each 4-wide load of x is reused for 4 rows of A, and every row keeps its own vector accumulator
+ * (4 independent FMA chains). Leftover columns and rows go through scalar code.
+ */
+__attribute__((target("avx2,fma")))
+void gemvRowsAvx2(const Matrix& a, const double* x, double* y, size_t rowBegin, size_t rowEnd) {
+    size_t cols = a.cols();
+    size_t jVectorEnd = cols / 4 * 4;
+    size_t i = rowBegin;
+    for (; i + 4 <= rowEnd; i += 4) {
+        const double* r0 = a.row(i);
+        const double* r1 = a.row(i + 1);
+        const double* r2 = a.row(i + 2);
+        const double* r3 = a.row(i + 3);
+        __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+        __m256d s2 = _mm256_setzero_pd(), s3 = _mm256_setzero_pd();
+        for (size_t j = 0; j < jVectorEnd; j += 4) {
+            __m256d xv = _mm256_loadu_pd(x + j);
+            s0 = _mm256_fmadd_pd(_mm256_loadu_pd(r0 + j), xv, s0);
+            s1 = _mm256_fmadd_pd(_mm256_loadu_pd(r1 + j), xv, s1);
+            s2 = _mm256_fmadd_pd(_mm256_loadu_pd(r2 + j), xv, s2);
+            s3 = _mm256_fmadd_pd(_mm256_loadu_pd(r3 + j), xv, s3);
+        }
+        double t0 = horizontalSum(s0), t1 = horizontalSum(s1), t2 = horizontalSum(s2), t3 = horizontalSum(s3);
+        for (size_t j = jVectorEnd; j < cols; ++j) {
+            t0 += r0[j] * x[j];
+            t1 += r1[j] * x[j];
+            t2 += r2[j] * x[j];
+            t3 += r3[j] * x[j];
+        }
+        y[i] = t0;
+        y[i + 1] = t1;
+        y[i + 2] = t2;
+        y[i + 3] = t3;
+    }
+    if (i < rowEnd) gemvRowsScalar(a, x, y, i, rowEnd);
+}
+#endif
+
+// y[rowBegin..rowEnd) = A * x for one row panel
+void gemvPanel(const Matrix& a, const double* x, double* y, size_t rowBegin, size_t rowEnd) {
+#ifdef MATRIX_X86
+    if (cpuHasAvx2Fma()) {
+        gemvRowsAvx2(a, x, y, rowBegin, rowEnd);
+        return;
+    }
+#endif
+    gemvRowsScalar(a, x, y, rowBegin, rowEnd);
+}
+
+// y = A * x, with rows split into panels across threads (0 = one per hardware thread).
+// Matrices under GEMV_MIN_PANEL elements per thread use fewer threads; small ones run inline.
+// Throws: invalid_argument on a size mismatch
+vector<double> gemv(const Matrix& a, const vector<double>& x, unsigned threads = 0) {
+    if (x.size() != a.cols()) throw invalid_argument("gemv: vector length must equal the column count");
+    vector<double> y(a.rows());
+    if (threads == 0) threads = max(1u, thread::hardware_concurrency());
+    threads = unsigned(min<size_t>(threads, max<size_t>(1, a.rows() * a.cols() / GEMV_MIN_PANEL)));
+    if (threads == 1) {
+        gemvPanel(a, x.data(), y.data(), 0, a.rows());
+        return y;
+    }
+    size_t panelRows = ((a.rows() + threads - 1) / threads + 7) / 8 * 8;   // Whole cache lines of y per thread
+
+    vector<thread> workers;
+    for (size_t begin = 0; begin < a.rows(); begin += panelRows) {
+        size_t end = min(begin + panelRows, a.rows());
+        workers.emplace_back(gemvPanel, cref(a), x.data(), y.data(), begin, end);
+    }
+    for (thread& worker : workers) worker.join();
+    return y;
+}
+
+// -------------------------------------------------
+// 3. BLOCKED GEMM
+// -------------------------------------------------
+
+// Scalar block kernel: C[i0..i1) += A[i0..i1, k0..k1) * B[k0..k1, j0..j1)
+void gemmBlockScalar(const Matrix& a, const Matrix& b, Matrix& c,
+                     size_t i0, size_t i1, size_t k0, size_t k1, size_t j0, size_t j1) {
+    for (size_t i = i0; i < i1; ++i) {
+        double* cRow = c.row(i);
+        for (size_t k = k0; k < k1; ++k) {
+            double aik = a(i, k);
+            const double* bRow = b.row(k);
+            for (size_t j = j0; j < j1; ++j) cRow[j] += aik * bRow[j];
+        }
+    }
+}
+
+#ifdef MATRIX_X86
+/*
+ * AVX2/FMA block kernel with 4 x 8 register blocking
+ * Eight accumulators hold a 4-row by 8-column tile of C; each k step loads 8 values of B once and
+ * reuses them for 4 rows of A. Leftover rows and columns go through the scalar kernel.
+ */
+__attribute__((target("avx2,fma")))
+void gemmBlockAvx2(const Matrix& a, const Matrix& b, Matrix& c,
+                   size_t i0, size_t i1, size_t k0, size_t k1, size_t j0, size_t j1) {
+    size_t i = i0;
+    size_t jVectorEnd = j0 + ((j1 - j0) / 8) * 8;
+    for (; i + 4 <= i1; i += 4) {
+        for (size_t j = j0; j < jVectorEnd; j += 8) {
+            __m256d c00 = _mm256_loadu_pd(c.row(i) + j), c01 = _mm256_loadu_pd(c.row(i) + j + 4);
+            __m256d c10 = _mm256_loadu_pd(c.row(i + 1) + j), c11 = _mm256_loadu_pd(c.row(i + 1) + j + 4);
+            __m256d c20 = _mm256_loadu_pd(c.row(i + 2) + j), c21 = _mm256_loadu_pd(c.row(i + 2) + j + 4);
+            __m256d c30 = _mm256_loadu_pd(c.row(i + 3) + j), c31 = _mm256_loadu_pd(c.row(i + 3) + j + 4);
+            for (size_t k = k0; k < k1; ++k) {
+                __m256d b0 = _mm256_loadu_pd(b.row(k) + j);
+                __m256d b1 = _mm256_loadu_pd(b.row(k) + j + 4);
+                __m256d a0 = _mm256_broadcast_sd(&a.row(i)[k]);
+                __m256d a1 = _mm256_broadcast_sd(&a.row(i + 1)[k]);
+                __m256d a2 = _mm256_broadcast_sd(&a.row(i + 2)[k]);
+                __m256d a3 = _mm256_broadcast_sd(&a.row(i + 3)[k]);
+                c00 = _mm256_fmadd_pd(a0, b0, c00);
+                c01 = _mm256_fmadd_pd(a0, b1, c01);
+                c10 = _mm256_fmadd_pd(a1, b0, c10);
+                c11 = _mm256_fmadd_pd(a1, b1, c11);
+                c20 = _mm256_fmadd_pd(a2, b0, c20);
+                c21 = _mm256_fmadd_pd(a2, b1, c21);
+                c30 = _mm256_fmadd_pd(a3, b0, c30);
+                c31 = _mm256_fmadd_pd(a3, b1, c31);
+            }
+            _mm256_storeu_pd(c.row(i) + j, c00);
+            _mm256_storeu_pd(c.row(i) + j + 4, c01);
+            _mm256_storeu_pd(c.row(i + 1) + j, c10);
+            _mm256_storeu_pd(c.row(i + 1) + j + 4, c11);
+            _mm256_storeu_pd(c.row(i + 2) + j, c20);
+            _mm256_storeu_pd(c.row(i + 2) + j + 4, c21);
+            _mm256_storeu_pd(c.row(i + 3) + j, c30);
+            _mm256_storeu_pd(c.row(i + 3) + j + 4, c31);
+        }
+        if (jVectorEnd < j1) gemmBlockScalar(a, b, c, i, i + 4, k0, k1, jVectorEnd, j1);
+    }
+    if (i < i1) gemmBlockScalar(a, b, c, i, i1, k0, k1, j0, j1);
+}
+#endif
+
+// C[rowBegin..rowEnd) += A * B for one row panel, blocked over k and j
+void gemmPanel(const Matrix& a, const Matrix& b, Matrix& c, size_t rowBegin, size_t rowEnd) {
+    for (size_t kb = 0; kb < a.cols(); kb += GEMM_K_BLOCK) {
+        size_t kEnd = min(kb + GEMM_K_BLOCK, a.cols());
+        for (size_t jb = 0; jb < b.cols(); jb += GEMM_N_BLOCK) {
+            size_t jEnd = min(jb + GEMM_N_BLOCK, b.cols());
+#ifdef MATRIX_X86
+            if (cpuHasAvx2Fma()) {
+                gemmBlockAvx2(a, b, c, rowBegin, rowEnd, kb, kEnd, jb, jEnd);
+                continue;
+            }
+#endif
+            gemmBlockScalar(a, b, c, rowBegin, rowEnd, kb, kEnd, jb, jEnd);
+        }
+    }
+}
+
+// C = A * B, with rows of C split into panels across threads (0 = one per hardware thread).
+// Each thread owns a disjoint set of C rows, so no synchronisation is needed.
+// Throws: invalid_argument on a size mismatch
+Matrix gemm(const Matrix& a, const Matrix& b, unsigned threads = 0) {
+    if (a.cols() != b.rows()) throw invalid_argument("gemm: inner dimensions do not match");
+    Matrix c(a.rows(), b.cols());
+    if (threads == 0) threads = max(1u, thread::hardware_concurrency());
+    size_t panelRows = ((a.rows() + threads - 1) / threads + 3) / 4 * 4;   // Multiple of 4 for the kernel
+
+    vector<thread> workers;
+    for (size_t begin = 0; begin < a.rows(); begin += panelRows) {
+        size_t end = min(begin + panelRows, a.rows());
+        workers.emplace_back(gemmPanel, cref(a), cref(b), ref(c), begin, end);
+    }
+    for (thread& worker : workers) worker.join();
+    return c;
+}
+
+// -------------------------------------------------
+// 4. BENCHMARK AGAINST vector<vector<double>>
+// -------------------------------------------------
+
+using Clock = chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start) {
+    return chrono::duration<double, milli>(Clock::now() - start).count();
+}
+
+typedef vector<vector<double>> NestedGrid;
+
+NestedGrid naiveMultiply(const NestedGrid& a, const NestedGrid& b) {
+    size_t n = a.size(), m = b[0].size(), inner = b.size();
+    NestedGrid c(n, vector<double>(m, 0.0));
+    for (size_t i = 0; i < n; ++i) {
+        for (size_t j = 0; j < m; ++j) {
+            for (size_t k = 0; k < inner; ++k) c[i][j] += a[i][k] * b[k][j];   // Walks a column of b
+        }
+    }
+    return c;
+}
+
+vector<double> naiveGemv(const NestedGrid& a, const vector<double>& x) {
+    vector<double> y(a.size(), 0.0);
+    for (size_t i = 0; i < a.size(); ++i) {
+        for (size_t j = 0; j < x.size(); ++j) y[i] += a[i][j] * x[j];
+    }
+    return y;
+}
+
+NestedGrid naiveTranspose(const NestedGrid& a) {
+    NestedGrid t(a[0].size(), vector<double>(a.size()));
+    for (size_t i = 0; i < a.size(); ++i) {
+        for (size_t j = 0; j < a[i].size(); ++j) t[j][i] = a[i][j];
+    }
+    return t;
+}
+
+// Returns: false if the implementations disagree (also reported on cerr)
+bool runBenchmark(size_t maxSize) {
+    cout << "\n=== BENCHMARK (threads: " << max(1u, thread::hardware_concurrency()) << ") ===" << endl;
+#ifdef MATRIX_X86
+    cout << "AVX2/FMA kernel: " << (cpuHasAvx2Fma() ? "yes" : "no (scalar fallback)") << endl;
+#endif
+    cout << "n      naive GEMM(ms)  blocked GEMM(ms)  GFLOP/s  naive T(ms)  blocked T(ms)  naive GEMV(ms)  GEMV(ms)"
+         << endl;
+    mt19937 rng(4);
+    uniform_real_distribution<double> dist(-1.0, 1.0);
+    bool consistent = true;
+
+    for (size_t n = 256; n <= maxSize; n *= 2) {
+        Matrix a(n, n), b(n, n);
+        NestedGrid na(n, vector<double>(n)), nb(n, vector<double>(n));
+        for (size_t i = 0; i < n; ++i) {
+            for (size_t j = 0; j < n; ++j) {
+                a(i, j) = na[i][j] = dist(rng);
+                b(i, j) = nb[i][j] = dist(rng);
+            }
+        }
+
+        auto start = Clock::now();
+        Matrix c = gemm(a, b);
+        double blockedMs = elapsedMs(start);
+
+        start = Clock::now();
+        Matrix t = transpose(a);
+        double blockedTransposeMs = elapsedMs(start);
+
+        start = Clock::now();
+        NestedGrid nt = naiveTranspose(na);
+        double naiveTransposeMs = elapsedMs(start);
+
+        // GEMV is a few microseconds at the small sizes: average over several runs
+        const int GEMV_RUNS = 10;
+        vector<double> x(n), y, ny;
+        for (double& value : x) value = dist(rng);
+        start = Clock::now();
+        for (int run = 0; run < GEMV_RUNS; ++run) ny = naiveGemv(na, x);
+        double naiveGemvMs = elapsedMs(start) / GEMV_RUNS;
+        start = Clock::now();
+        for (int run = 0; run < GEMV_RUNS; ++run) y = gemv(a, x);
+        double gemvMs = elapsedMs(start) / GEMV_RUNS;
+
+        // The naive multiply is O(n^3) with a cache miss per step: skip it for the largest sizes
+        double naiveMs = -1;
+        if (n <= 1024) {
+            start = Clock::now();
+            NestedGrid nc = naiveMultiply(na, nb);
+            naiveMs = elapsedMs(start);
+            double maxError = 0;
+            for (size_t i = 0; i < n; i += 17) {
+                for (size_t j = 0; j < n; j += 13) maxError = max(maxError, fabs(nc[i][j] - c(i, j)));
+            }
+            if (maxError > 1e-9) {
+                cerr << "Mismatch between implementations! GEMM at n=" << n << " (error " << maxError << ")" << endl;
+                consistent = false;
+            }
+        }
+        bool transposeMatches = true;
+        for (size_t i = 0; i < n && transposeMatches; ++i) {
+            for (size_t j = 0; j < n; ++j) transposeMatches = transposeMatches && t(i, j) == nt[i][j];
+        }
+        if (!transposeMatches) {
+            cerr << "Mismatch between implementations! Transpose at n=" << n << endl;
+            consistent = false;
+        }
+        double gemvError = 0;
+        for (size_t i = 0; i < n; ++i) gemvError = max(gemvError, fabs(y[i] - ny[i]));
+        if (gemvError > 1e-9) {
+            cerr << "Mismatch between implementations! GEMV at n=" << n << " (error " << gemvError << ")" << endl;
+            consistent = false;
+        }
+
+        double gflops = 2.0 * double(n) * n * n / (blockedMs * 1e6);
+        cout << n << "  " << (naiveMs < 0 ? string("skipped") : to_string(naiveMs)) << "  " << blockedMs << "  "
+             << gflops << "  " << naiveTransposeMs << "  " << blockedTransposeMs << "  " << naiveGemvMs << "  " << gemvMs
+             << endl;
+    }
+    return consistent;
+}
+
+int main(int argc, char* argv[]) {
+    // Create a 2 x 3 matrix in one aligned buffer
+    Matrix a(2, 3);
+    a(0, 0) = 1; a(0, 1) = 2; a(0, 2) = 3;
+    a(1, 0) = 4; a(1, 1) = 5; a(1, 2) = 6;
+    cout << "A is " << a.rows() << " x " << a.cols() << " (leading dimension " << a.ld() << ")" << endl;
+
+    // Transpose
+    Matrix at = transpose(a);
+    cout << "Transpose of A:" << endl;
+    for (size_t i = 0; i < at.rows(); ++i) {
+        for (size_t j = 0; j < at.cols(); ++j) cout << at(i, j) << " ";
+        cout << endl;
+    }
+
+    // Multiply
+    Matrix product = gemm(a, at);
+    cout << "A * A^T:" << endl;
+    for (size_t i = 0; i < product.rows(); ++i) {
+        for (size_t j = 0; j < product.cols(); ++j) cout << product(i, j) << " ";
+        cout << endl;
+    }
+
+    // Matrix-vector product
+    vector<double> y = gemv(a, {1, 1, 1});
+    cout << "A * [1 1 1] = " << y[0] << " " << y[1] << endl;
+
+    // Size mismatches are reported
+    try {
+        gemm(a, a);
+    } catch (const invalid_argument& e) {
+        cout << "Caught expected error: " << e.what() << endl;
+    }
+
+    size_t maxSize = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 1024;
+    if (!runBenchmark(maxSize)) return 1;
+
+    return 0;
+}
@@ -0,0 +1,437 @@
+/*
+ * flat_map.cpp
+ * Demonstrates a sorted, vector-backed flat_map as a read-heavy alternative to std::map.
+ * Definition: A flat_map keeps its keys and values in two separate contiguous arrays, sorted by key,
+ * so lookups are a binary search over one cache-friendly array and iteration is a linear scan.
+ * Shows major operations: bulk build (sort once + deduplicate), find, access, iterate, insert, erase,
+ * an optional prefix-compressed key layout for strings, and a benchmark against std::map
+ * (build time, lookup latency and bytes per entry).
+ * Run this file independently to see flat_map operations in action.
+ * Usage: ./flat_map [number_of_keys]   (default 200000)
+ */
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include <algorithm>   // for sort, lower_bound
+#include <numeric>     // for iota
+#include <functional>  // for less
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+#include "heap_accounting.h"   // liveHeapBytes() for the bytes-per-entry benchmark
+using namespace std;
+
+// -------------------------------------------------
+// 1. FLAT MAP (separate key and value arrays)
+// -------------------------------------------------
+
+/*
+ * Template class for a sorted, vector-backed map
+ *
+ * Keys and values live in two parallel arrays. Keeping keys apart from values means
+ * a binary search only touches key bytes, so more keys fit in each cache line.
+ *
+ * Template parameter Key: The key type (must be ordered by Compare)
+ * Template parameter Value: The mapped type
+ * Template parameter Compare: Strict weak ordering for keys
+ */
+template <typename Key, typename Value, typename Compare = less<Key>>
+class FlatMap {
+private:
+    vector<Key> keys;      // Sorted, unique keys
+    vector<Value> values;  // values[i] belongs to keys[i]
+    Compare comp;
+
+    // Index of key, or size() if the key is absent
+    size_t position(const Key& key) const {
+        auto it = lower_bound(keys.begin(), keys.end(), key, comp);
+        if (it == keys.end() || comp(key, *it)) return keys.size();
+        return size_t(it - keys.begin());
+    }
+
+public:
+    // Proxies returned by the iterators so entries read like std::map's pair
+    struct Entry {
+        const Key& first;
+        Value& second;
+    };
+
+    struct ConstEntry {
+        const Key& first;
+        const Value& second;
+    };
+
+    class iterator {
+    private:
+        FlatMap* owner;
+        size_t index;
+
+    public:
+        iterator(FlatMap* owner, size_t index) : owner(owner), index(index) {}
+        Entry operator*() const { return {owner->keys[index], owner->values[index]}; }
+        iterator& operator++() { ++index; return *this; }
+        bool operator==(const iterator& other) const { return index == other.index; }
+        bool operator!=(const iterator& other) const { return index != other.index; }
+        size_t position() const { return index; }
+    };
+
+    class const_iterator {
+    private:
+        const FlatMap* owner;
+        size_t index;
+
+    public:
+        const_iterator(const FlatMap* owner, size_t index) : owner(owner), index(index) {}
+        ConstEntry operator*() const { return {owner->keys[index], owner->values[index]}; }
+        const_iterator& operator++() { ++index; return *this; }
+        bool operator==(const const_iterator& other) const { return index == other.index; }
+        bool operator!=(const const_iterator& other) const { return index != other.index; }
+        size_t position() const { return index; }
+    };
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, keys.size()); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, keys.size()); }
+
+    // Bulk construction: sorts once and deduplicates.
+    // When a key appears more than once, the LAST occurrence wins (same as age[key] = value).
+    // Parameter: first, last - Range of pair-like elements (.first = key, .second = value)
+    template <typename InputIt>
+    void buildFrom(InputIt first, InputIt last) {
+        vector<Key> inKeys;
+        vector<Value> inValues;
+        for (; first != last; ++first) {
+            inKeys.push_back((*first).first);
+            inValues.push_back((*first).second);
+        }
+
+        // Sort an index permutation; stable sort keeps duplicates in input order
+        vector<size_t> order(inKeys.size());
+        iota(order.begin(), order.end(), 0);
+        stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return comp(inKeys[a], inKeys[b]);
+        });
+
+        keys.clear();
+        values.clear();
+        keys.reserve(order.size());
+        values.reserve(order.size());
+        for (size_t i = 0; i < order.size(); ++i) {
+            size_t idx = order[i];
+            bool lastOfRun = (i + 1 == order.size()) || comp(inKeys[idx], inKeys[order[i + 1]]);
+            if (!lastOfRun) continue;
+            keys.push_back(move(inKeys[idx]));
+            values.push_back(move(inValues[idx]));
+        }
+        keys.shrink_to_fit();
+        values.shrink_to_fit();
+    }
+
+    // Find a key
+    // Returns: iterator to the entry, or end() if the key is absent
+    iterator find(const Key& key) {
+        return iterator(this, position(key));
+    }
+
+    const_iterator find(const Key& key) const {
+        return const_iterator(this, position(key));
+    }
+
+    bool contains(const Key& key) const {
+        return find(key) != end();
+    }
+
+    // Access an existing key
+    // Throws: out_of_range if the key is absent
+    Value& at(const Key& key) {
+        iterator it = find(key);
+        if (it == end()) throw out_of_range("FlatMap::at: key not found");
+        return values[it.position()];
+    }
+
+    const Value& at(const Key& key) const {
+        const_iterator it = find(key);
+        if (it == end()) throw out_of_range("FlatMap::at: key not found");
+        return values[it.position()];
+    }
+
+    // Access or insert a default value (O(n) insert: the map is meant to be built in bulk)
+    Value& operator[](const Key& key) {
+        auto it = lower_bound(keys.begin(), keys.end(), key, comp);
+        size_t pos = it - keys.begin();
+        if (it == keys.end() || comp(key, *it)) {
+            keys.insert(it, key);
+            values.insert(values.begin() + pos, Value());
+        }
+        return values[pos];
+    }
+
+    // Insert a single entry; does nothing if the key already exists (same as std::map::insert)
+    // Returns: true if the entry was inserted
+    bool insert(const pair<Key, Value>& entry) {
+        auto it = lower_bound(keys.begin(), keys.end(), entry.first, comp);
+        if (it != keys.end() && !comp(entry.first, *it)) return false;
+        size_t pos = it - keys.begin();
+        keys.insert(it, entry.first);
+        values.insert(values.begin() + pos, entry.second);
+        return true;
+    }
+
+    // Erase a key
+    // Returns: Number of removed entries (0 or 1)
+    size_t erase(const Key& key) {
+        iterator it = find(key);
+        if (it == end()) return 0;
+        keys.erase(keys.begin() + it.position());
+        values.erase(values.begin() + it.position());
+        return 1;
+    }
+
+    size_t size() const { return keys.size(); }
+    bool empty() const { return keys.empty(); }
+
+    void clear() {
+        keys.clear();
+        values.clear();
+    }
+};
+
+// -------------------------------------------------
+// 2. PREFIX-COMPRESSED STRING KEY LAYOUT
+// -------------------------------------------------
+
+/*
+ * Flat map with string keys stored as prefix-compressed blocks
+ *
+ * Keys are grouped into blocks of KEYS_PER_BLOCK sorted keys. The first key of each block
+ * is stored in full; every following key stores only the length of the prefix it shares with
+ * the previous key plus its remaining suffix. All key bytes live in one contiguous buffer.
+ * Lookup: binary search over block head keys, then a short linear decode inside one block.
+ *
+ * Template parameter Value: The mapped type
+ */
+template <typename Value>
+class PrefixCompressedFlatMap {
+private:
+    static const size_t KEYS_PER_BLOCK = 16;
+
+    string keyBytes;               // Encoded keys: [prefixLen][suffixLen][suffix bytes] ...
+    vector<uint32_t> blockOffsets; // Offset of each block inside keyBytes
+    vector<string> blockHeads;     // Full first key of each block (binary search target)
+    vector<Value> values;          // Values in key order
+
+    static void appendLength(string& out, size_t length) {
+        // Variable-length encoding: 7 bits per byte, high bit means "more bytes follow"
+        while (length >= 0x80) {
+            out.push_back(char((length & 0x7F) | 0x80));
+            length >>= 7;
+        }
+        out.push_back(char(length));
+    }
+
+    static size_t readLength(const string& in, size_t& pos) {
+        size_t length = 0;
+        int shift = 0;
+        while (true) {
+            unsigned char byte = static_cast<unsigned char>(in[pos++]);
+            length |= size_t(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return length;
+            shift += 7;
+        }
+    }
+
+public:
+    // Bulk construction from a built FlatMap (already sorted and unique)
+    void buildFrom(const FlatMap<string, Value>& source) {
+        keyBytes.clear();
+        blockOffsets.clear();
+        blockHeads.clear();
+        values.clear();
+        values.reserve(source.size());
+
+        string previous;
+        size_t i = 0;
+        for (auto entry : source) {
+            const string& key = entry.first;
+            if (i % KEYS_PER_BLOCK == 0) {
+                blockOffsets.push_back(static_cast<uint32_t>(keyBytes.size()));
+                blockHeads.push_back(key);
+                previous.clear();
+            }
+            size_t shared = 0;
+            while (shared < previous.size() && shared < key.size() && previous[shared] == key[shared]) {
+                ++shared;
+            }
+            appendLength(keyBytes, shared);
+            appendLength(keyBytes, key.size() - shared);
+            keyBytes.append(key, shared, string::npos);
+            values.push_back(entry.second);
+            previous = key;
+            ++i;
+        }
+        keyBytes.shrink_to_fit();
+    }
+
+    // Find a key
+    // Returns: pointer to the value, or nullptr if the key is absent
+    const Value* find(const string& key) const {
+        auto it = upper_bound(blockHeads.begin(), blockHeads.end(), key);
+        if (it == blockHeads.begin()) return nullptr;
+        size_t block = (it - blockHeads.begin()) - 1;
+
+        size_t pos = blockOffsets[block];
+        size_t blockEnd = (block + 1 < blockOffsets.size()) ? blockOffsets[block + 1] : keyBytes.size();
+        string current;
+        for (size_t index = block * KEYS_PER_BLOCK; pos < blockEnd; ++index) {
+            size_t shared = readLength(keyBytes, pos);
+            size_t suffix = readLength(keyBytes, pos);
+            current.resize(shared);
+            current.append(keyBytes, pos, suffix);
+            pos += suffix;
+            if (current == key) return &values[index];
+            if (current > key) return nullptr;   // Keys are sorted: we passed the spot
+        }
+        return nullptr;
+    }
+
+    size_t size() const { return values.size(); }
+};
+
+// -------------------------------------------------
+// 3. BENCHMARK AGAINST std::map
+// -------------------------------------------------
+
+using Clock = chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start) {
+    return chrono::duration<double, milli>(Clock::now() - start).count();
+}
+
+// Make names that share long prefixes, like real identifier tables do
+vector<pair<string, int>> makeInput(size_t count, mt19937& rng) {
+    vector<pair<string, int>> input;
+    input.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        input.push_back({"user_account_" + to_string(rng() % (count * 4)), int(i)});
+    }
+    return input;
+}
+
+// Returns: false if the implementations disagree (also reported on cerr)
+bool runBenchmark(size_t count) {
+    cout << "\n=== BENCHMARK: " << count << " string keys ===" << endl;
+    mt19937 rng(42);
+    vector<pair<string, int>> input = makeInput(count, rng);
+
+    vector<string> probes;
+    for (size_t i = 0; i < count; ++i) {
+        probes.push_back(i % 2 ? input[rng() % count].first : "user_account_" + to_string(rng() % (count * 4)));
+    }
+
+    // std::map
+    size_t heapBefore = liveHeapBytes();
+    auto start = Clock::now();
+    map<string, int> treeMap;
+    for (const auto& entry : input) treeMap[entry.first] = entry.second;
+    double treeBuildMs = elapsedMs(start);
+    size_t treeBytes = liveHeapBytes() - heapBefore;
+
+    long long found = 0;
+    start = Clock::now();
+    for (const string& probe : probes) found += treeMap.count(probe);
+    double treeLookupNs = elapsedMs(start) * 1e6 / probes.size();
+
+    // FlatMap
+    heapBefore = liveHeapBytes();
+    start = Clock::now();
+    FlatMap<string, int> flat;
+    flat.buildFrom(input.begin(), input.end());
+    double flatBuildMs = elapsedMs(start);
+    size_t flatBytes = liveHeapBytes() - heapBefore;
+
+    long long flatFound = 0;
+    start = Clock::now();
+    for (const string& probe : probes) flatFound += flat.contains(probe);
+    double flatLookupNs = elapsedMs(start) * 1e6 / probes.size();
+
+    // Prefix-compressed layout
+    heapBefore = liveHeapBytes();
+    start = Clock::now();
+    PrefixCompressedFlatMap<int> compressed;
+    compressed.buildFrom(flat);
+    double compressedBuildMs = elapsedMs(start);
+    size_t compressedBytes = liveHeapBytes() - heapBefore;
+
+    long long compressedFound = 0;
+    start = Clock::now();
+    for (const string& probe : probes) compressedFound += (compressed.find(probe) != nullptr);
+    double compressedLookupNs = elapsedMs(start) * 1e6 / probes.size();
+
+    bool consistent = found == flatFound && found == compressedFound;
+    if (!consistent) cerr << "Mismatch between implementations!" << endl;
+
+    size_t entries = treeMap.size();
+    cout << "Unique keys: " << entries << ", hits: " << found << "/" << probes.size() << endl;
+    cout << "Container            build(ms)  lookup(ns)  bytes/entry" << endl;
+    cout << "std::map             " << treeBuildMs << "  " << treeLookupNs << "  " << double(treeBytes) / entries << endl;
+    cout << "FlatMap              " << flatBuildMs << "  " << flatLookupNs << "  " << double(flatBytes) / entries << endl;
+    cout << "FlatMap (prefix)     " << compressedBuildMs << " (+flat)  " << compressedLookupNs << "  "
+         << double(compressedBytes) / entries << endl;
+    return consistent;
+}
+
+int main(int argc, char* argv[]) {
+    FlatMap<string, int> age;
+
+    // Bulk build (Alice appears twice: the last value wins)
+    vector<pair<string, int>> rows = {{"Bob", 30}, {"Alice", 24}, {"Charlie", 22}, {"Alice", 25}};
+    age.buildFrom(rows.begin(), rows.end());
+
+    // Access elements
+    cout << "Alice's age: " << age.at("Alice") << endl;
+
+    // Iterate and print (linear scan in key order)
+    cout << "All ages:" << endl;
+    for (auto entry : age) {
+        cout << entry.first << ": " << entry.second << endl;
+    }
+
+    // Find element
+    string name = "Bob";
+    if (age.find(name) != age.end()) {
+        cout << name << " found, age = " << age[name] << endl;
+    } else {
+        cout << name << " not found" << endl;
+    }
+
+    // Insert and erase (O(n) each: prefer buildFrom for large batches)
+    age.insert({"Dave", 41});
+    age.erase("Alice");
+    cout << "After inserting Dave and erasing Alice:" << endl;
+    for (auto entry : age) {
+        cout << entry.first << ": " << entry.second << endl;
+    }
+
+    // Prefix-compressed layout
+    PrefixCompressedFlatMap<int> compressed;
+    compressed.buildFrom(age);
+    const int* daveAge = compressed.find("Dave");
+    cout << "Compressed lookup of Dave: " << (daveAge ? to_string(*daveAge) : "not found") << endl;
+
+    // Size
+    cout << "Map size: " << age.size() << endl;
+
+    // Clear all
+    age.clear();
+    cout << "After clear, map size: " << age.size() << endl;
+
+    size_t count = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 200000;
+    if (!runBenchmark(count)) return 1;
+
+    return 0;
+}
@@ -0,0 +1,111 @@
+/*
+ * heap_accounting.h
+ * Live heap bytes and allocation counts for the memory comparisons in the container demos.
+ * Definition: replaces every global operator new / delete (plain, array, nothrow, aligned and
+ * sized forms) with one malloc / free pair. Block sizes come from malloc_usable_size, so nothing
+ * is written in front of a block and memory obtained through one form (e.g. the nothrow new
+ * behind std::get_temporary_buffer) can be released through any other.
+ * Sizes include the allocator's rounding, i.e. what the heap really holds for each block.
+ *
+ * Usage (in the one source file of a demo; replacements must be defined once per program):
+ *   #include "heap_accounting.h"
+ *   size_t before = liveHeapBytes();
+ *   ... build a container ...
+ *   size_t bytes = liveHeapBytes() - before;
+ *
+ * The counters are plain integers: measure from one thread at a time.
+ */
+#ifndef HEAP_ACCOUNTING_H
+#define HEAP_ACCOUNTING_H
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#if defined(__APPLE__)
+#include <malloc/malloc.h>
+#else
+#include <malloc.h>
+#endif
+
+namespace heap_accounting {
+
+static std::size_t liveBytes = 0;
+static std::size_t allocations = 0;
+
+inline std::size_t blockSize(void* ptr) {
+#if defined(__APPLE__)
+    return malloc_size(ptr);
+#else
+    return malloc_usable_size(ptr);
+#endif
+}
+
+// Returns: a block of at least bytes aligned to alignment (0 = default), or nullptr
+// noinline keeps the compiler from mixing these with its built-in new/delete assumptions.
+__attribute__((noinline)) inline void* allocate(std::size_t bytes, std::size_t alignment) noexcept {
+    if (bytes == 0) bytes = 1;
+    void* ptr = nullptr;
+    if (alignment <= alignof(std::max_align_t)) ptr = std::malloc(bytes);
+    else if (posix_memalign(&ptr, alignment, bytes) != 0) ptr = nullptr;
+    if (ptr) {
+        liveBytes += blockSize(ptr);
+        ++allocations;
+    }
+    return ptr;
+}
+
+__attribute__((noinline)) inline void release(void* ptr) noexcept {
+    if (!ptr) return;
+    liveBytes -= blockSize(ptr);
+    std::free(ptr);
+}
+
+// Throws: bad_alloc once the new-handler (if any) cannot free memory, as the standard forms do
+inline void* allocateOrThrow(std::size_t bytes, std::size_t alignment) {
+    for (;;) {
+        if (void* ptr = allocate(bytes, alignment)) return ptr;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) throw std::bad_alloc();
+        handler();
+    }
+}
+
+}  // namespace heap_accounting
+
+// Returns: bytes currently allocated through operator new
+inline std::size_t liveHeapBytes() { return heap_accounting::liveBytes; }
+
+// Returns: number of operator new calls so far
+inline std::size_t heapAllocationCount() { return heap_accounting::allocations; }
+
+void* operator new(std::size_t bytes) { return heap_accounting::allocateOrThrow(bytes, 0); }
+void* operator new[](std::size_t bytes) { return heap_accounting::allocateOrThrow(bytes, 0); }
+void* operator new(std::size_t bytes, const std::nothrow_t&) noexcept { return heap_accounting::allocate(bytes, 0); }
+void* operator new[](std::size_t bytes, const std::nothrow_t&) noexcept { return heap_accounting::allocate(bytes, 0); }
+void* operator new(std::size_t bytes, std::align_val_t alignment) {
+    return heap_accounting::allocateOrThrow(bytes, std::size_t(alignment));
+}
+void* operator new[](std::size_t bytes, std::align_val_t alignment) {
+    return heap_accounting::allocateOrThrow(bytes, std::size_t(alignment));
+}
+void* operator new(std::size_t bytes, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return heap_accounting::allocate(bytes, std::size_t(alignment));
+}
+void* operator new[](std::size_t bytes, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return heap_accounting::allocate(bytes, std::size_t(alignment));
+}
+
+void operator delete(void* ptr) noexcept { heap_accounting::release(ptr); }
+void operator delete[](void* ptr) noexcept { heap_accounting::release(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { heap_accounting::release(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { heap_accounting::release(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { heap_accounting::release(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { heap_accounting::release(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { heap_accounting::release(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { heap_accounting::release(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept { heap_accounting::release(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept { heap_accounting::release(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { heap_accounting::release(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { heap_accounting::release(ptr); }
+
+#endif // HEAP_ACCOUNTING_H
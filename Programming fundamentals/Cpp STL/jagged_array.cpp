@@ -0,0 +1,387 @@
+/*
+ * jagged_array.cpp
+ * Demonstrates a compressed-sparse-row (CSR) jagged array as a replacement for vector<vector<int>>.
+ * Definition: A CSR jagged array keeps every element of every row in ONE contiguous values buffer and
+ * records where each row starts. There is no per-row heap allocation or per-row 24-byte vector header,
+ * and a full scan is a single linear pass over memory.
+ * Shows major operations: building rows with a builder, row views (size, index, iterate), push_back
+ * into an existing row using optional per-row slack, clearing a row, compaction, full scans, and a
+ * benchmark (allocations, bytes, scan speed) against vector<vector<int>>.
+ * Run this file independently to see jagged array operations in action.
+ * Usage: ./jagged_array [number_of_rows]   (default 2000000)
+ */
+#include <iostream>
+#include <vector>
+#include <algorithm>   // for copy, max
+#include <initializer_list>
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+#include "heap_accounting.h"   // heapAllocationCount() for the benchmark
+using namespace std;
+
+// -------------------------------------------------
+// 1. ROW VIEW
+// -------------------------------------------------
+
+/*
+ * Non-owning view of one row inside the shared values buffer
+ * Valid until the jagged array reallocates (push_back into a full row, compact, clear).
+ */
+template <typename T>
+class RowView {
+private:
+    T* first;
+    size_t count;
+
+public:
+    RowView(T* first, size_t count) : first(first), count(count) {}
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    T& operator[](size_t i) const { return first[i]; }
+    T* begin() const { return first; }
+    T* end() const { return first + count; }
+};
+
+// -------------------------------------------------
+// 2. JAGGED ARRAY
+// -------------------------------------------------
+
+/*
+ * Template class for a CSR jagged array
+ *
+ * Row r occupies values[starts[r] .. starts[r] + sizes[r]) and owns capacities[r] slots.
+ * When built without slack, rows are packed back to back (capacity == size). With slack, every
+ * row gets extra slots so push_back into a row usually needs no data movement. A row that runs
+ * out of room is moved to the end of the buffer with doubled capacity; compact() later restores
+ * the packed, in-order layout.
+ *
+ * Template parameter T: The element type
+ */
+template <typename T>
+class JaggedArray {
+private:
+    vector<T> values;
+    vector<size_t> starts;
+    vector<uint32_t> sizes;
+    vector<uint32_t> capacities;
+    size_t elementCount;
+    bool inOrder;   // true while rows appear in the buffer in row order (fast full scan)
+
+    void checkRow(size_t row) const {
+        if (row >= starts.size()) {
+            throw out_of_range("Row " + to_string(row) + " out of range (rows: " + to_string(starts.size()) + ")");
+        }
+    }
+
+public:
+    JaggedArray() : elementCount(0), inOrder(true) {}
+
+    // Used by JaggedArrayBuilder: takes packed rows and spreads them out with slack
+    JaggedArray(vector<T>&& packedValues, const vector<size_t>& rowOffsets, size_t slackPerRow)
+        : elementCount(packedValues.size()), inOrder(true) {
+        size_t rows = rowOffsets.size() - 1;
+        starts.resize(rows);
+        sizes.resize(rows);
+        capacities.resize(rows);
+        if (slackPerRow == 0) {
+            values = move(packedValues);
+            for (size_t r = 0; r < rows; ++r) {
+                starts[r] = rowOffsets[r];
+                sizes[r] = capacities[r] = uint32_t(rowOffsets[r + 1] - rowOffsets[r]);
+            }
+            return;
+        }
+        values.resize(packedValues.size() + rows * slackPerRow);
+        size_t cursor = 0;
+        for (size_t r = 0; r < rows; ++r) {
+            size_t length = rowOffsets[r + 1] - rowOffsets[r];
+            starts[r] = cursor;
+            sizes[r] = uint32_t(length);
+            capacities[r] = uint32_t(length + slackPerRow);
+            copy(packedValues.begin() + rowOffsets[r], packedValues.begin() + rowOffsets[r + 1], values.begin() + cursor);
+            cursor += capacities[r];
+        }
+    }
+
+    size_t rows() const { return starts.size(); }
+    size_t totalElements() const { return elementCount; }
+
+    // Access a row
+    // Throws: out_of_range if the row does not exist
+    RowView<T> row(size_t r) {
+        checkRow(r);
+        return RowView<T>(values.data() + starts[r], sizes[r]);
+    }
+
+    RowView<T> operator[](size_t r) { return RowView<T>(values.data() + starts[r], sizes[r]); }
+
+    // Append a new row at the end
+    template <typename Range>
+    void appendRow(const Range& rowValues, size_t slack = 0) {
+        size_t length = size_t(distance(begin(rowValues), end(rowValues)));
+        starts.push_back(values.size());
+        sizes.push_back(uint32_t(length));
+        capacities.push_back(uint32_t(length + slack));
+        values.insert(values.end(), begin(rowValues), end(rowValues));
+        values.resize(values.size() + slack);
+        elementCount += length;
+    }
+
+    void appendRow(initializer_list<T> rowValues, size_t slack = 0) {
+        appendRow<initializer_list<T>>(rowValues, slack);
+    }
+
+    // Add an element to the end of a row (like matrix[r].push_back(value))
+    // Throws: out_of_range if the row does not exist
+    void pushBack(size_t r, const T& value) {
+        checkRow(r);
+        if (sizes[r] == capacities[r]) {
+            // Out of room: move the row to the end of the buffer with doubled capacity
+            size_t newCapacity = max<size_t>(4, size_t(capacities[r]) * 2);
+            size_t newStart = values.size();
+            values.resize(values.size() + newCapacity);
+            copy(values.begin() + starts[r], values.begin() + starts[r] + sizes[r], values.begin() + newStart);
+            starts[r] = newStart;
+            capacities[r] = uint32_t(newCapacity);
+            inOrder = inOrder && (r + 1 == rows());
+        }
+        values[starts[r] + sizes[r]] = value;
+        ++sizes[r];
+        ++elementCount;
+    }
+
+    // Remove all elements of a row (its slots stay reserved for later push_back calls)
+    void clearRow(size_t r) {
+        checkRow(r);
+        elementCount -= sizes[r];
+        sizes[r] = 0;
+    }
+
+    // Repack all rows in order with the given slack, dropping holes left by moved rows
+    void compact(size_t slackPerRow = 0) {
+        vector<T> packed;
+        packed.reserve(elementCount + rows() * slackPerRow);
+        for (size_t r = 0; r < rows(); ++r) {
+            size_t newStart = packed.size();
+            packed.insert(packed.end(), values.begin() + starts[r], values.begin() + starts[r] + sizes[r]);
+            packed.resize(packed.size() + slackPerRow);
+            starts[r] = newStart;
+            capacities[r] = uint32_t(sizes[r] + slackPerRow);
+        }
+        values.swap(packed);
+        inOrder = true;
+    }
+
+    // Visit every element in row order
+    template <typename Visitor>
+    void forEach(Visitor visit) {
+        if (inOrder && values.size() == elementCount) {
+            for (T& value : values) visit(value);   // Packed: one linear pass over the buffer
+            return;
+        }
+        for (size_t r = 0; r < rows(); ++r) {
+            T* first = values.data() + starts[r];
+            for (uint32_t i = 0; i < sizes[r]; ++i) visit(first[i]);
+        }
+    }
+
+    // Bytes held by the container, including slack and holes
+    size_t sizeInBytes() const {
+        return values.capacity() * sizeof(T) + starts.capacity() * sizeof(size_t) +
+               (sizes.capacity() + capacities.capacity()) * sizeof(uint32_t);
+    }
+
+    void clear() {
+        values.clear();
+        starts.clear();
+        sizes.clear();
+        capacities.clear();
+        elementCount = 0;
+        inOrder = true;
+    }
+};
+
+/*
+ * Builder that collects rows into one packed buffer, then produces a JaggedArray
+ * Rows can be added whole (addRow) or element by element (push + endRow).
+ */
+template <typename T>
+class JaggedArrayBuilder {
+private:
+    vector<T> values;
+    vector<size_t> rowOffsets;
+
+public:
+    JaggedArrayBuilder() : rowOffsets(1, 0) {}
+
+    void reserve(size_t rows, size_t elements) {
+        rowOffsets.reserve(rows + 1);
+        values.reserve(elements);
+    }
+
+    template <typename Range>
+    JaggedArrayBuilder& addRow(const Range& rowValues) {
+        values.insert(values.end(), begin(rowValues), end(rowValues));
+        return endRow();
+    }
+
+    JaggedArrayBuilder& addRow(initializer_list<T> rowValues) {
+        return addRow<initializer_list<T>>(rowValues);
+    }
+
+    JaggedArrayBuilder& push(const T& value) {
+        values.push_back(value);
+        return *this;
+    }
+
+    JaggedArrayBuilder& endRow() {
+        rowOffsets.push_back(values.size());
+        return *this;
+    }
+
+    // Parameter: slackPerRow - Extra slots reserved after every row for later pushBack calls
+    JaggedArray<T> build(size_t slackPerRow = 0) {
+        JaggedArray<T> result(move(values), rowOffsets, slackPerRow);
+        values.clear();
+        rowOffsets.assign(1, 0);
+        return result;
+    }
+};
+
+// -------------------------------------------------
+// 3. BENCHMARK AGAINST vector<vector<int>>
+// -------------------------------------------------
+
+using Clock = chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start) {
+    return chrono::duration<double, milli>(Clock::now() - start).count();
+}
+
+// Returns: false if the implementations disagree (also reported on cerr)
+bool runBenchmark(size_t rowCount) {
+    cout << "\n=== BENCHMARK: " << rowCount << " rows of 0-15 ints ===" << endl;
+    mt19937 rng(8);
+    vector<uint32_t> lengths(rowCount);
+    size_t totalElements = 0;
+    for (uint32_t& length : lengths) {
+        length = rng() % 16;
+        totalElements += length;
+    }
+
+    // vector<vector<int>>
+    size_t allocationsBefore = heapAllocationCount();
+    auto start = Clock::now();
+    vector<vector<int>> nested;
+    for (size_t r = 0; r < rowCount; ++r) {
+        vector<int> row;
+        for (uint32_t i = 0; i < lengths[r]; ++i) row.push_back(int(r + i));
+        nested.push_back(move(row));
+    }
+    double nestedBuildMs = elapsedMs(start);
+    size_t nestedAllocations = heapAllocationCount() - allocationsBefore;
+    size_t nestedBytes = nested.capacity() * sizeof(vector<int>);
+    for (const auto& row : nested) nestedBytes += row.capacity() * sizeof(int);
+
+    // CSR
+    allocationsBefore = heapAllocationCount();
+    start = Clock::now();
+    JaggedArrayBuilder<int> builder;
+    builder.reserve(rowCount, totalElements);
+    for (size_t r = 0; r < rowCount; ++r) {
+        for (uint32_t i = 0; i < lengths[r]; ++i) builder.push(int(r + i));
+        builder.endRow();
+    }
+    JaggedArray<int> csr = builder.build();
+    double csrBuildMs = elapsedMs(start);
+    size_t csrAllocations = heapAllocationCount() - allocationsBefore;
+
+    const int scans = 5;
+    long long nestedSum = 0, csrSum = 0;
+    start = Clock::now();
+    for (int s = 0; s < scans; ++s) {
+        for (const auto& row : nested) {
+            for (int value : row) nestedSum += value;
+        }
+    }
+    double nestedScanMs = elapsedMs(start) / scans;
+
+    start = Clock::now();
+    for (int s = 0; s < scans; ++s) csr.forEach([&csrSum](int value) { csrSum += value; });
+    double csrScanMs = elapsedMs(start) / scans;
+
+    bool consistent = nestedSum == csrSum;
+    if (!consistent) cerr << "Mismatch between implementations!" << endl;
+
+    double scannedMB = double(totalElements * sizeof(int)) / 1e6;
+    cout << "Layout               allocations  bytes       build(ms)  scan(ms)  scan(MB/s)" << endl;
+    cout << "vector<vector<int>>  " << nestedAllocations << "  " << nestedBytes << "  " << nestedBuildMs << "  "
+         << nestedScanMs << "  " << scannedMB / (nestedScanMs / 1000) << endl;
+    cout << "JaggedArray (CSR)    " << csrAllocations << "  " << csr.sizeInBytes() << "  " << csrBuildMs << "  "
+         << csrScanMs << "  " << scannedMB / (csrScanMs / 1000) << endl;
+    return consistent;
+}
+
+int main(int argc, char* argv[]) {
+    // Insert rows (slack of 2 per row so later push_back calls stay in place)
+    JaggedArrayBuilder<int> builder;
+    builder.addRow({1, 2, 3}).addRow({4, 5}).addRow({6});
+    JaggedArray<int> matrix = builder.build(2);
+
+    // Access and print elements
+    cout << "Matrix contents:" << endl;
+    for (size_t i = 0; i < matrix.rows(); ++i) {
+        for (size_t j = 0; j < matrix[i].size(); ++j) {
+            cout << matrix[i][j] << " ";
+        }
+        cout << endl;
+    }
+
+    // Add an element to a specific row
+    matrix.pushBack(1, 99);
+    cout << "After adding 99 to row 1: ";
+    for (int n : matrix[1]) cout << n << " ";
+    cout << endl;
+
+    // Grow a row past its slack: it moves to the end of the buffer
+    matrix.pushBack(2, 7);
+    matrix.pushBack(2, 8);
+    matrix.pushBack(2, 9);
+    matrix.compact();   // Pack rows back in order with no slack
+
+    // Iterate row by row
+    cout << "All rows:" << endl;
+    for (size_t i = 0; i < matrix.rows(); ++i) {
+        for (int val : matrix[i]) cout << val << " ";
+        cout << endl;
+    }
+
+    // Size
+    cout << "Number of rows: " << matrix.rows() << endl;
+    cout << "Size of row 0: " << matrix[0].size() << endl;
+
+    // Clear a row
+    matrix.clearRow(2);
+    cout << "After clearing row 2, size: " << matrix[2].size() << endl;
+
+    // Checked access
+    try {
+        matrix.row(10);
+    } catch (const out_of_range& e) {
+        cout << "Caught expected error: " << e.what() << endl;
+    }
+
+    // Clear all
+    matrix.clear();
+    cout << "After clearing matrix, number of rows: " << matrix.rows() << endl;
+
+    size_t rowCount = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 2000000;
+    if (!runBenchmark(rowCount)) return 1;
+
+    return 0;
+}
@@ -0,0 +1,515 @@
+/*
+ * membership_filter.cpp
+ * Demonstrates probabilistic membership filters placed in front of std::set and std::map.
+ * Definition: A membership filter answers "definitely not present" or "maybe present" using a few bits
+ * per key. When most lookups miss, checking a small filter first skips the O(log n) tree walk for
+ * almost every miss; only "maybe" answers (real hits plus a tunable false-positive rate) reach the tree.
+ * Shows major operations:
+ *   - Blocked Bloom filter: every key sets 8 bits inside one 256-bit block (one per 32-bit lane), so a
+ *     check touches a single cache line and maps to one AVX2 compare when the CPU supports it.
+ *   - Cuckoo filter: 16-bit fingerprints in 4-way buckets; unlike Bloom it supports deletion.
+ *   - FilteredSet / FilteredMap wrappers with hit/miss statistics, and a benchmark on a miss-heavy workload.
+ * Run this file independently to see filter operations in action.
+ * Usage: ./membership_filter [number_of_keys] [false_positive_rate]   (default 1000000 0.01)
+ */
+#include <iostream>
+#include <set>
+#include <map>
+#include <string>
+#include <vector>
+#include <functional>  // for hash
+#include <chrono>
+#include <random>
+#include <cmath>       // for log2, ceil
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define FILTER_X86 1
+#endif
+using namespace std;
+
+// std::hash is the identity for integers, so mix the bits before using them as a filter hash
+uint64_t mix64(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+template <typename T>
+uint64_t filterHash(const T& value) {
+    return mix64(uint64_t(hash<T>()(value)));
+}
+
+#ifdef FILTER_X86
+bool cpuHasAvx2() {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+#endif
+
+// -------------------------------------------------
+// 1. BLOCKED BLOOM FILTER
+// -------------------------------------------------
+
+/*
+ * Split-block Bloom filter
+ * The upper 32 hash bits pick a 256-bit block. The lower 32 bits are multiplied by 8 odd salts; the
+ * top 5 bits of each product choose one bit in each of the block's eight 32-bit words.
+ * No deletion: clearing a bit could remove other keys.
+ */
+class BlockedBloomFilter {
+private:
+    struct alignas(32) Block {
+        uint32_t words[8];
+    };
+
+    static constexpr uint32_t SALTS[8] = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+                                          0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+    vector<Block> blocks;
+
+    size_t blockIndex(uint64_t h) const {
+        return size_t(((h >> 32) * uint64_t(blocks.size())) >> 32);   // Fast range reduction, no modulo
+    }
+
+#ifdef FILTER_X86
+    __attribute__((target("avx2")))
+    bool containsAvx2(const Block& block, uint32_t h) const {
+        __m256i salts = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(SALTS));
+        __m256i products = _mm256_mullo_epi32(_mm256_set1_epi32(int(h)), salts);
+        __m256i bitIndex = _mm256_srli_epi32(products, 27);
+        __m256i mask = _mm256_sllv_epi32(_mm256_set1_epi32(1), bitIndex);
+        __m256i words = _mm256_load_si256(reinterpret_cast<const __m256i*>(block.words));
+        return _mm256_testc_si256(words, mask);   // All mask bits set in words?
+    }
+#endif
+
+public:
+    // Parameter: expectedKeys - Planned number of keys
+    // Parameter: falsePositiveRate - Target rate in (0, 1)
+    // Throws: invalid_argument if the rate is outside (0, 1)
+    BlockedBloomFilter(size_t expectedKeys, double falsePositiveRate) {
+        if (!(falsePositiveRate > 0.0 && falsePositiveRate < 1.0)) {
+            throw invalid_argument("False positive rate must be between 0 and 1");
+        }
+        // Classic Bloom sizing (1.44 * log2(1/p) bits per key) plus ~20% for blocking imbalance
+        double bitsPerKey = 1.44 * log2(1.0 / falsePositiveRate) * 1.2;
+        size_t totalBits = size_t(ceil(bitsPerKey * double(max<size_t>(expectedKeys, 1))));
+        blocks.assign(max<size_t>(1, (totalBits + 255) / 256), Block{});
+    }
+
+    void insert(uint64_t h) {
+        Block& block = blocks[blockIndex(h)];
+        for (int i = 0; i < 8; ++i) block.words[i] |= 1u << ((uint32_t(h) * SALTS[i]) >> 27);
+    }
+
+    bool mayContain(uint64_t h) const {
+        const Block& block = blocks[blockIndex(h)];
+#ifdef FILTER_X86
+        if (cpuHasAvx2()) return containsAvx2(block, uint32_t(h));
+#endif
+        for (int i = 0; i < 8; ++i) {
+            if (!(block.words[i] & (1u << ((uint32_t(h) * SALTS[i]) >> 27)))) return false;
+        }
+        return true;
+    }
+
+    void clear() {
+        for (Block& block : blocks) block = Block{};
+    }
+
+    size_t sizeInBytes() const { return blocks.size() * sizeof(Block); }
+};
+
+constexpr uint32_t BlockedBloomFilter::SALTS[8];
+
+// -------------------------------------------------
+// 2. CUCKOO FILTER
+// -------------------------------------------------
+
+/*
+ * Cuckoo filter with 4 fingerprints per bucket
+ * Each key has two candidate buckets: i1 = hash, i2 = i1 XOR hash(fingerprint). Because i2 can be
+ * computed from i1 and the fingerprint alone, a stored fingerprint can be moved ("kicked") to its
+ * alternate bucket without knowing the original key. Fingerprints are 1..16 bits; a false positive
+ * needs a fingerprint match in one of 8 slots, so the rate is about 8 / 2^bits.
+ * When MAX_KICKS moves do not free a slot, the fingerprint still being carried belongs to a stored
+ * key, so it goes to a one-entry victim stash that mayContain also checks. Only when the stash is
+ * already taken is an insert refused, and then before anything is moved: no false negatives.
+ */
+class CuckooFilter {
+private:
+    static const int SLOTS_PER_BUCKET = 4;
+    static const int MAX_KICKS = 500;
+
+    vector<uint16_t> slots;   // 0 = empty
+    size_t bucketMask;
+    uint32_t fingerprintMask;
+    size_t stored;
+    mt19937 rng;
+
+    struct Victim {
+        bool used = false;
+        size_t bucket = 0;   // Either of the fingerprint's two buckets
+        uint16_t fp = 0;
+    } victim;
+
+    uint16_t fingerprint(uint64_t h) const {
+        uint16_t fp = uint16_t((h >> 32) & fingerprintMask);
+        return fp ? fp : 1;   // 0 marks an empty slot
+    }
+
+    size_t alternate(size_t bucket, uint16_t fp) const {
+        return (bucket ^ size_t(mix64(fp))) & bucketMask;
+    }
+
+    bool tryStore(size_t bucket, uint16_t fp) {
+        for (int s = 0; s < SLOTS_PER_BUCKET; ++s) {
+            uint16_t& slot = slots[bucket * SLOTS_PER_BUCKET + s];
+            if (slot == 0) {
+                slot = fp;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool bucketHas(size_t bucket, uint16_t fp) const {
+        const uint16_t* b = &slots[bucket * SLOTS_PER_BUCKET];
+        return (b[0] == fp) | (b[1] == fp) | (b[2] == fp) | (b[3] == fp);
+    }
+
+public:
+    // Parameter: expectedKeys - Planned number of keys (the table is sized for ~95% load)
+    // Parameter: falsePositiveRate - Target rate; fingerprint width is chosen from it (max 16 bits)
+    CuckooFilter(size_t expectedKeys, double falsePositiveRate) : stored(0), rng(12345) {
+        if (!(falsePositiveRate > 0.0 && falsePositiveRate < 1.0)) {
+            throw invalid_argument("False positive rate must be between 0 and 1");
+        }
+        int bits = int(ceil(log2(2.0 * SLOTS_PER_BUCKET / falsePositiveRate)));
+        bits = max(4, min(16, bits));
+        fingerprintMask = (1u << bits) - 1;
+
+        size_t buckets = 1;
+        while (buckets * SLOTS_PER_BUCKET * 95 / 100 < expectedKeys) buckets *= 2;
+        bucketMask = buckets - 1;
+        slots.assign(buckets * SLOTS_PER_BUCKET, 0);
+    }
+
+    // Returns: false if the filter is too full to place the key (the caller should rebuild larger);
+    //          the filter is then unchanged
+    bool insert(uint64_t h) {
+        uint16_t fp = fingerprint(h);
+        size_t i1 = size_t(h) & bucketMask;
+        size_t i2 = alternate(i1, fp);
+        if (tryStore(i1, fp) || tryStore(i2, fp)) {
+            ++stored;
+            return true;
+        }
+        if (victim.used) return false;
+        size_t bucket = (rng() & 1) ? i1 : i2;
+        for (int kick = 0; kick < MAX_KICKS; ++kick) {
+            uint16_t& slot = slots[bucket * SLOTS_PER_BUCKET + rng() % SLOTS_PER_BUCKET];
+            swap(fp, slot);
+            bucket = alternate(bucket, fp);
+            if (tryStore(bucket, fp)) {
+                ++stored;
+                return true;
+            }
+        }
+        victim = {true, bucket, fp};   // A displaced key's fingerprint: keep it findable
+        ++stored;
+        return true;
+    }
+
+    bool mayContain(uint64_t h) const {
+        uint16_t fp = fingerprint(h);
+        size_t i1 = size_t(h) & bucketMask;
+        size_t i2 = alternate(i1, fp);
+        if (victim.used && victim.fp == fp && (victim.bucket == i1 || victim.bucket == i2)) return true;
+        return bucketHas(i1, fp) || bucketHas(i2, fp);
+    }
+
+    // Removes one copy of the key's fingerprint. Only call for keys that were inserted.
+    bool erase(uint64_t h) {
+        uint16_t fp = fingerprint(h);
+        size_t i1 = size_t(h) & bucketMask;
+        size_t i2 = alternate(i1, fp);
+        if (victim.used && victim.fp == fp && (victim.bucket == i1 || victim.bucket == i2)) {
+            victim.used = false;
+            --stored;
+            return true;
+        }
+        for (size_t bucket : {i1, i2}) {
+            for (int s = 0; s < SLOTS_PER_BUCKET; ++s) {
+                uint16_t& slot = slots[bucket * SLOTS_PER_BUCKET + s];
+                if (slot == fp) {
+                    slot = 0;
+                    --stored;
+                    // The freed slot may let the stashed fingerprint back into the table
+                    if (victim.used && (tryStore(victim.bucket, victim.fp) ||
+                                        tryStore(alternate(victim.bucket, victim.fp), victim.fp))) {
+                        victim.used = false;
+                    }
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    size_t size() const { return stored; }
+    size_t sizeInBytes() const { return slots.size() * sizeof(uint16_t); }
+};
+
+// -------------------------------------------------
+// 3. FILTERED CONTAINERS
+// -------------------------------------------------
+
+struct FilterStats {
+    uint64_t lookups = 0;
+    uint64_t filterRejected = 0;    // Filter said "definitely not": tree walk skipped
+    uint64_t filterPassed = 0;      // Filter said "maybe": tree was searched
+    uint64_t falsePositives = 0;    // ...and the tree did not have the key
+
+    void print(const string& label) const {
+        cout << label << ": lookups=" << lookups << ", rejected by filter=" << filterRejected
+             << " (" << (lookups ? 100.0 * filterRejected / lookups : 0.0) << "%), passed=" << filterPassed
+             << ", false positives=" << falsePositives
+             << " (observed FP rate " << (lookups ? double(falsePositives) / double(lookups - (filterPassed - falsePositives)) : 0.0)
+             << ")" << endl;
+    }
+};
+
+/*
+ * std::set behind a blocked Bloom filter
+ * Erased keys stay set in the filter (Bloom filters cannot delete), which only raises the false
+ * positive rate; rebuildFilter() clears that drift.
+ */
+template <typename T>
+class FilteredSet {
+private:
+    set<T> elements;
+    BlockedBloomFilter filter;
+    size_t expectedKeys;
+    double falsePositiveRate;
+    mutable FilterStats stats;
+
+public:
+    FilteredSet(size_t expectedKeys, double falsePositiveRate)
+        : filter(expectedKeys, falsePositiveRate), expectedKeys(expectedKeys), falsePositiveRate(falsePositiveRate) {}
+
+    bool insert(const T& value) {
+        filter.insert(filterHash(value));
+        return elements.insert(value).second;
+    }
+
+    size_t erase(const T& value) { return elements.erase(value); }
+
+    bool contains(const T& value) const {
+        ++stats.lookups;
+        if (!filter.mayContain(filterHash(value))) {
+            ++stats.filterRejected;
+            return false;
+        }
+        ++stats.filterPassed;
+        bool found = elements.find(value) != elements.end();
+        if (!found) ++stats.falsePositives;
+        return found;
+    }
+
+    void rebuildFilter() {
+        filter = BlockedBloomFilter(max(expectedKeys, elements.size()), falsePositiveRate);
+        for (const T& value : elements) filter.insert(filterHash(value));
+    }
+
+    size_t size() const { return elements.size(); }
+    const FilterStats& statistics() const { return stats; }
+    size_t filterBytes() const { return filter.sizeInBytes(); }
+};
+
+/*
+ * std::map behind a cuckoo filter
+ * The cuckoo filter supports deletion, so erase keeps the filter exact (no stale bits).
+ */
+template <typename Key, typename Value>
+class FilteredMap {
+private:
+    map<Key, Value> entries;
+    CuckooFilter filter;
+    mutable FilterStats stats;
+
+public:
+    FilteredMap(size_t expectedKeys, double falsePositiveRate) : filter(expectedKeys, falsePositiveRate) {}
+
+    // Throws: overflow_error if the filter is full (construct with a larger expectedKeys); the map
+    //         and the filter are left as they were
+    bool insert(const Key& key, const Value& value) {
+        auto result = entries.insert({key, value});
+        if (result.second && !filter.insert(filterHash(key))) {
+            entries.erase(result.first);
+            throw overflow_error("Cuckoo filter is full");
+        }
+        return result.second;
+    }
+
+    size_t erase(const Key& key) {
+        if (entries.erase(key) == 0) return 0;
+        filter.erase(filterHash(key));
+        return 1;
+    }
+
+    // Returns: pointer to the value, or nullptr if absent
+    const Value* find(const Key& key) const {
+        ++stats.lookups;
+        if (!filter.mayContain(filterHash(key))) {
+            ++stats.filterRejected;
+            return nullptr;
+        }
+        ++stats.filterPassed;
+        auto it = entries.find(key);
+        if (it == entries.end()) {
+            ++stats.falsePositives;
+            return nullptr;
+        }
+        return &it->second;
+    }
+
+    size_t size() const { return entries.size(); }
+    const FilterStats& statistics() const { return stats; }
+    size_t filterBytes() const { return filter.sizeInBytes(); }
+};
+
+// -------------------------------------------------
+// 4. BENCHMARK: 90% of lookups miss
+// -------------------------------------------------
+
+using Clock = chrono::steady_clock;
+
+double nsPerOp(Clock::time_point start, size_t operations) {
+    return chrono::duration<double, nano>(Clock::now() - start).count() / double(operations);
+}
+
+// Returns: false if the implementations disagree (also reported on cerr)
+bool runBenchmark(size_t count, double falsePositiveRate) {
+    cout << "\n=== BENCHMARK: " << count << " keys, 90% misses, target FP rate " << falsePositiveRate << " ===" << endl;
+    mt19937 rng(21);
+    vector<int> keys(count);
+    for (size_t i = 0; i < count; ++i) keys[i] = int(i * 2);   // Even numbers are present
+    vector<int> probes(count);
+    for (int& probe : probes) {
+        probe = (rng() % 10 == 0) ? keys[rng() % count] : int(rng() % (count * 2)) | 1;   // Odd numbers miss
+    }
+
+    set<int> plainSet(keys.begin(), keys.end());
+    FilteredSet<int> filteredSet(count, falsePositiveRate);
+    for (int key : keys) filteredSet.insert(key);
+
+    long long plainHits = 0, filteredHits = 0;
+    auto start = Clock::now();
+    for (int probe : probes) plainHits += plainSet.find(probe) != plainSet.end();
+    double plainNs = nsPerOp(start, probes.size());
+    start = Clock::now();
+    for (int probe : probes) filteredHits += filteredSet.contains(probe);
+    double filteredNs = nsPerOp(start, probes.size());
+
+    map<string, int> plainMap;
+    FilteredMap<string, int> filteredMap(count, falsePositiveRate);
+    for (size_t i = 0; i < count; ++i) {
+        plainMap["user" + to_string(keys[i])] = int(i);
+        filteredMap.insert("user" + to_string(keys[i]), int(i));
+    }
+    vector<string> nameProbes;
+    for (int probe : probes) nameProbes.push_back("user" + to_string(probe));
+
+    long long plainMapHits = 0, filteredMapHits = 0;
+    start = Clock::now();
+    for (const string& probe : nameProbes) plainMapHits += plainMap.find(probe) != plainMap.end();
+    double plainMapNs = nsPerOp(start, nameProbes.size());
+    start = Clock::now();
+    for (const string& probe : nameProbes) filteredMapHits += filteredMap.find(probe) != nullptr;
+    double filteredMapNs = nsPerOp(start, nameProbes.size());
+
+    bool consistent = plainHits == filteredHits && plainMapHits == filteredMapHits;
+    if (!consistent) cerr << "Mismatch between implementations!" << endl;
+
+    cout << "std::set<int>::find          " << plainNs << " ns" << endl;
+    cout << "FilteredSet (blocked Bloom)  " << filteredNs << " ns, filter " << filteredSet.filterBytes() / 1024 << " KB" << endl;
+    cout << "std::map<string,int>::find   " << plainMapNs << " ns" << endl;
+    cout << "FilteredMap (cuckoo)         " << filteredMapNs << " ns, filter " << filteredMap.filterBytes() / 1024 << " KB" << endl;
+    filteredSet.statistics().print("FilteredSet stats");
+    filteredMap.statistics().print("FilteredMap stats");
+    return consistent;
+}
+
+int main(int argc, char* argv[]) {
+    // Set with a Bloom filter in front
+    FilteredSet<int> s(100, 0.01);
+    s.insert(5);
+    s.insert(1);
+    s.insert(3);
+    s.insert(5); // duplicate, will not be added
+
+    for (int value : {3, 4, 100}) {
+        cout << value << (s.contains(value) ? " found in set" : " not found in set") << endl;
+    }
+    s.erase(1);
+    s.rebuildFilter();   // Drop the stale bits of the erased key
+    cout << "After erasing 1 and rebuilding the filter, set size: " << s.size() << endl;
+    s.statistics().print("Set filter stats");
+
+    // Map with a cuckoo filter in front (supports erase)
+    FilteredMap<string, int> age(100, 0.001);
+    age.insert("Alice", 25);
+    age.insert("Bob", 30);
+    age.insert("Charlie", 22);
+
+    for (string name : {"Bob", "Mallory"}) {
+        const int* found = age.find(name);
+        cout << name << (found ? " found, age = " + to_string(*found) : " not found") << endl;
+    }
+    age.erase("Alice");
+    cout << "After erasing Alice, found: " << (age.find("Alice") ? "yes" : "no") << endl;
+    age.statistics().print("Map filter stats");
+
+    // Filling a small map past capacity: the filter refuses the key, and every stored key is still found
+    FilteredMap<int, int> small(16, 0.01);
+    vector<int> stored;
+    try {
+        for (int key = 0; key < 1000; ++key) {
+            small.insert(key, key);
+            stored.push_back(key);
+        }
+    } catch (const overflow_error& e) {
+        cout << "Caught expected error after " << stored.size() << " keys: " << e.what() << endl;
+    }
+    for (int key : stored) {
+        if (!small.find(key)) {
+            cerr << "Mismatch between implementations! Stored key " << key << " not found" << endl;
+            return 1;
+        }
+    }
+    cout << "All " << small.size() << " stored keys found after overflow" << endl;
+
+    // Invalid configuration is rejected
+    try {
+        BlockedBloomFilter broken(10, 1.5);
+    } catch (const invalid_argument& e) {
+        cout << "Caught expected error: " << e.what() << endl;
+    }
+
+#ifdef FILTER_X86
+    cout << "AVX2 Bloom check: " << (cpuHasAvx2() ? "yes" : "no (scalar fallback)") << endl;
+#endif
+
+    size_t count = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 1000000;
+    double falsePositiveRate = (argc > 2) ? atof(argv[2]) : 0.01;
+    if (!runBenchmark(count, falsePositiveRate)) return 1;
+
+    return 0;
+}
@@ -0,0 +1,428 @@
+/*
+ * packed_record.cpp
+ * Demonstrates packed records: pairs/tuples whose fields are laid out by alignment at compile time.
+ * Definition: A struct (or std::pair/std::tuple) places fields in declaration order and pads each one
+ * up to its alignment, so {char, double, short, int, char} takes 32 bytes to hold 16. PackedTuple
+ * computes, at compile time, an order with the most-aligned fields first, which needs no padding
+ * between fields, while get<I>() still uses the declared order.
+ * A record keyed by a string also sorts poorly: every comparison follows the string's pointer. A
+ * PrefixKeyed record caches the first bytes of the key next to it, so most comparisons are one
+ * integer compare and never touch the string data.
+ * Shows major operations: construction, get<I>, first()/second(), assignment, comparison, layout
+ * sizes, prefix-cached keys, and a benchmark sorting millions of records against pair<string,int>.
+ * Run this file independently to see packed record operations in action.
+ * Usage: ./packed_record [number_of_records]   (default 10000000)
+ */
+#include <iostream>
+#include <vector>
+#include <string>
+#include <array>
+#include <tuple>       // for tuple_element_t
+#include <utility>     // for pair, index_sequence, forward, move
+#include <type_traits>
+#include <algorithm>   // for sort, min
+#include <new>         // for placement new, launder
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include <cstdlib>
+#include <cstdio>      // for snprintf
+using namespace std;
+
+// -------------------------------------------------
+// 1. COMPILE-TIME LAYOUT
+// -------------------------------------------------
+
+/*
+ * Offsets of each field when fields are placed by decreasing alignment
+ * Ties keep declaration order. offsets[i] is the byte offset of declared field i.
+ */
+template <typename... Ts>
+struct PackedLayout {
+    static constexpr size_t COUNT = sizeof...(Ts);
+    static constexpr array<size_t, COUNT> SIZES = {sizeof(Ts)...};
+    static constexpr array<size_t, COUNT> ALIGNS = {alignof(Ts)...};
+
+    static constexpr size_t roundUp(size_t value, size_t alignment) {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    static constexpr size_t maxAlign() {
+        size_t result = 1;
+        for (size_t i = 0; i < COUNT; ++i) result = ALIGNS[i] > result ? ALIGNS[i] : result;
+        return result;
+    }
+
+    static constexpr array<size_t, COUNT> computeOffsets() {
+        array<size_t, COUNT> order = {};
+        for (size_t i = 0; i < COUNT; ++i) order[i] = i;
+        for (size_t i = 1; i < COUNT; ++i) {   // stable insertion sort, largest alignment first
+            for (size_t j = i; j > 0 && ALIGNS[order[j - 1]] < ALIGNS[order[j]]; --j) {
+                size_t moved = order[j];
+                order[j] = order[j - 1];
+                order[j - 1] = moved;
+            }
+        }
+        array<size_t, COUNT> offsets = {};
+        size_t cursor = 0;
+        for (size_t k = 0; k < COUNT; ++k) {
+            size_t field = order[k];
+            cursor = roundUp(cursor, ALIGNS[field]);
+            offsets[field] = cursor;
+            cursor += SIZES[field];
+        }
+        return offsets;
+    }
+
+    static constexpr size_t packedSize() {
+        size_t end = 0;
+        for (size_t i = 0; i < COUNT; ++i) {
+            end = OFFSETS[i] + SIZES[i] > end ? OFFSETS[i] + SIZES[i] : end;
+        }
+        return roundUp(end, maxAlign());
+    }
+
+    // Size of a struct with the same fields in declaration order (what pair/tuple/struct would use)
+    static constexpr size_t declaredOrderSize() {
+        size_t cursor = 0;
+        for (size_t i = 0; i < COUNT; ++i) cursor = roundUp(cursor, ALIGNS[i]) + SIZES[i];
+        return roundUp(cursor, maxAlign());
+    }
+
+    static constexpr array<size_t, COUNT> OFFSETS = computeOffsets();
+    static constexpr size_t SIZE = packedSize();
+};
+
+// -------------------------------------------------
+// 2. PACKED TUPLE
+// -------------------------------------------------
+
+/*
+ * Template class for a tuple stored in PackedLayout order
+ *
+ * Fields live in one aligned byte buffer and are constructed in place. get<I>() takes the declared
+ * index, so callers never see the reordering. Comparison is lexicographic in declared order,
+ * like std::tuple.
+ *
+ * Template parameter Ts: The field types (at least two)
+ */
+template <typename... Ts>
+class PackedTuple {
+    static_assert(sizeof...(Ts) >= 2, "PackedTuple needs at least two fields");
+
+private:
+    typedef PackedLayout<Ts...> Layout;
+    typedef index_sequence_for<Ts...> Indices;
+
+    alignas(Ts...) unsigned char storage[Layout::SIZE];
+
+    template <size_t I>
+    void* address() { return storage + Layout::OFFSETS[I]; }
+
+    template <size_t... I>
+    void constructDefault(index_sequence<I...>) { (new (address<I>()) Ts(), ...); }
+
+    template <size_t... I, typename... Us>
+    void constructFrom(index_sequence<I...>, Us&&... values) { (new (address<I>()) Ts(forward<Us>(values)), ...); }
+
+    template <size_t... I>
+    void copyFrom(index_sequence<I...>, const PackedTuple& other) { (new (address<I>()) Ts(other.template get<I>()), ...); }
+
+    template <size_t... I>
+    void moveFrom(index_sequence<I...>, PackedTuple& other) { (new (address<I>()) Ts(move(other.template get<I>())), ...); }
+
+    template <size_t... I>
+    void copyAssign(index_sequence<I...>, const PackedTuple& other) { ((get<I>() = other.template get<I>()), ...); }
+
+    template <size_t... I>
+    void moveAssign(index_sequence<I...>, PackedTuple& other) { ((get<I>() = move(other.template get<I>())), ...); }
+
+    template <size_t... I>
+    void destroyAll(index_sequence<I...>) { (get<I>().~Ts(), ...); }
+
+    template <size_t I>
+    bool lessFrom(const PackedTuple& other) const {
+        if constexpr (I == sizeof...(Ts)) {
+            return false;
+        } else {
+            if (get<I>() < other.template get<I>()) return true;
+            if (other.template get<I>() < get<I>()) return false;
+            return lessFrom<I + 1>(other);
+        }
+    }
+
+    template <size_t... I>
+    bool equalAll(index_sequence<I...>, const PackedTuple& other) const {
+        return ((get<I>() == other.template get<I>()) && ...);
+    }
+
+public:
+    template <size_t I>
+    using Element = tuple_element_t<I, tuple<Ts...>>;
+
+    PackedTuple() { constructDefault(Indices()); }
+
+    template <typename... Us, typename = enable_if_t<sizeof...(Us) == sizeof...(Ts)>>
+    PackedTuple(Us&&... values) { constructFrom(Indices(), forward<Us>(values)...); }
+
+    PackedTuple(const PackedTuple& other) { copyFrom(Indices(), other); }
+    PackedTuple(PackedTuple&& other) noexcept(conjunction<is_nothrow_move_constructible<Ts>...>::value) {
+        moveFrom(Indices(), other);
+    }
+
+    PackedTuple& operator=(const PackedTuple& other) {
+        if (this != &other) copyAssign(Indices(), other);
+        return *this;
+    }
+
+    PackedTuple& operator=(PackedTuple&& other) noexcept(conjunction<is_nothrow_move_assignable<Ts>...>::value) {
+        if (this != &other) moveAssign(Indices(), other);
+        return *this;
+    }
+
+    ~PackedTuple() { destroyAll(Indices()); }
+
+    // Access field I (declared order)
+    template <size_t I>
+    Element<I>& get() { return *launder(reinterpret_cast<Element<I>*>(storage + Layout::OFFSETS[I])); }
+
+    template <size_t I>
+    const Element<I>& get() const { return *launder(reinterpret_cast<const Element<I>*>(storage + Layout::OFFSETS[I])); }
+
+    // Byte offset of field I inside the record
+    template <size_t I>
+    static constexpr size_t offsetOf() { return Layout::OFFSETS[I]; }
+
+    static constexpr size_t declaredOrderSize() { return Layout::declaredOrderSize(); }
+
+    bool operator<(const PackedTuple& other) const { return lessFrom<0>(other); }
+    bool operator==(const PackedTuple& other) const { return equalAll(Indices(), other); }
+    bool operator!=(const PackedTuple& other) const { return !(*this == other); }
+};
+
+/*
+ * Two-field packed record with pair-style accessors
+ * first() / second() replace the .first / .second members of std::pair.
+ */
+template <typename A, typename B>
+class PackedPair : public PackedTuple<A, B> {
+public:
+    using PackedTuple<A, B>::PackedTuple;
+
+    A& first() { return this->template get<0>(); }
+    B& second() { return this->template get<1>(); }
+    const A& first() const { return this->template get<0>(); }
+    const B& second() const { return this->template get<1>(); }
+};
+
+// -------------------------------------------------
+// 3. PREFIX-CACHED STRING KEYS
+// -------------------------------------------------
+
+// First sizeof(Prefix) bytes of key, big-endian, zero padded: comparing prefixes as integers
+// orders keys the same way string comparison does, except that equal prefixes decide nothing
+template <typename Prefix>
+Prefix keyPrefix(const string& key) {
+    Prefix prefix = 0;
+    size_t length = min(key.size(), sizeof(Prefix));
+    for (size_t i = 0; i < sizeof(Prefix); ++i) {
+        prefix <<= 8;
+        if (i < length) prefix |= static_cast<unsigned char>(key[i]);
+    }
+    return prefix;
+}
+
+/*
+ * Template class for a string-keyed record with a cached key prefix
+ *
+ * The key can only be replaced through setKey(), which keeps the prefix in sync. Records order by
+ * key; the string itself is only read when two prefixes are equal.
+ *
+ * Template parameter Value: The payload type
+ * Template parameter Prefix: Unsigned integer holding the cached prefix (uint64_t = 8 bytes)
+ */
+template <typename Value, typename Prefix = uint64_t>
+class PrefixKeyed {
+    static_assert(is_unsigned<Prefix>::value, "Prefix must be an unsigned integer type");
+
+private:
+    PackedTuple<string, Prefix, Value> fields;
+
+public:
+    PrefixKeyed() {}
+    PrefixKeyed(string key, Value value) : fields(key, keyPrefix<Prefix>(key), move(value)) {}
+
+    const string& first() const { return fields.template get<0>(); }
+    Value& second() { return fields.template get<2>(); }
+    const Value& second() const { return fields.template get<2>(); }
+    Prefix prefix() const { return fields.template get<1>(); }
+
+    void setKey(string key) {
+        fields.template get<1>() = keyPrefix<Prefix>(key);
+        fields.template get<0>() = move(key);
+    }
+
+    bool operator<(const PrefixKeyed& other) const {
+        if (prefix() != other.prefix()) return prefix() < other.prefix();
+        return first() < other.first();
+    }
+
+    bool operator==(const PrefixKeyed& other) const {
+        return prefix() == other.prefix() && first() == other.first() && second() == other.second();
+    }
+};
+
+// -------------------------------------------------
+// 4. BENCHMARK
+// -------------------------------------------------
+
+using Clock = chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start) {
+    return chrono::duration<double, milli>(Clock::now() - start).count();
+}
+
+// Deterministic key stream: random lowercase words of 4-24 letters, or keys sharing a long prefix
+class KeyGenerator {
+private:
+    mt19937_64 rng;
+    bool sharedPrefix;
+
+public:
+    KeyGenerator(bool sharedPrefix) : rng(39), sharedPrefix(sharedPrefix) {}
+
+    string next() {
+        if (sharedPrefix) {
+            char buffer[40];
+            snprintf(buffer, sizeof(buffer), "order-2025-%010llu", static_cast<unsigned long long>(rng() % 10000000000ULL));
+            return buffer;
+        }
+        string key(4 + rng() % 21, 'a');
+        for (char& c : key) c = char('a' + rng() % 26);
+        return key;
+    }
+};
+
+uint64_t fnv1a(uint64_t hash, const string& key) {
+    for (unsigned char c : key) hash = (hash ^ c) * 1099511628211ULL;
+    return hash;
+}
+
+struct SortResult {
+    double milliseconds;
+    uint64_t orderHash;
+    size_t recordBytes;
+};
+
+SortResult sortPairs(size_t count, bool sharedPrefix) {
+    KeyGenerator keys(sharedPrefix);
+    vector<pair<string, int>> records;
+    records.reserve(count);
+    for (size_t i = 0; i < count; ++i) records.push_back(make_pair(keys.next(), int(i)));
+    auto start = Clock::now();
+    sort(records.begin(), records.end(),
+         [](const pair<string, int>& a, const pair<string, int>& b) { return a.first < b.first; });
+    SortResult result;
+    result.milliseconds = elapsedMs(start);
+    result.orderHash = 14695981039346656037ULL;
+    for (const auto& record : records) result.orderHash = fnv1a(result.orderHash, record.first);
+    result.recordBytes = sizeof(pair<string, int>);
+    return result;
+}
+
+template <typename Prefix>
+SortResult sortPrefixKeyed(size_t count, bool sharedPrefix) {
+    KeyGenerator keys(sharedPrefix);
+    vector<PrefixKeyed<int, Prefix>> records;
+    records.reserve(count);
+    for (size_t i = 0; i < count; ++i) records.push_back(PrefixKeyed<int, Prefix>(keys.next(), int(i)));
+    auto start = Clock::now();
+    sort(records.begin(), records.end());
+    SortResult result;
+    result.milliseconds = elapsedMs(start);
+    result.orderHash = 14695981039346656037ULL;
+    for (const auto& record : records) result.orderHash = fnv1a(result.orderHash, record.first());
+    result.recordBytes = sizeof(PrefixKeyed<int, Prefix>);
+    return result;
+}
+
+// Returns: false if the implementations disagree (also reported on cerr)
+bool runBenchmark(size_t count) {
+    bool consistent = true;
+    for (int dataset = 0; dataset < 2; ++dataset) {
+        bool sharedPrefix = dataset == 1;
+        cout << "\n=== BENCHMARK: sort " << count << " records, "
+             << (sharedPrefix ? "keys sharing an 11-byte prefix" : "random 4-24 letter keys") << " ===" << endl;
+        SortResult plain = sortPairs(count, sharedPrefix);
+        SortResult prefix8 = sortPrefixKeyed<uint64_t>(count, sharedPrefix);
+        SortResult prefix4 = sortPrefixKeyed<uint32_t>(count, sharedPrefix);
+        if (plain.orderHash != prefix8.orderHash || plain.orderHash != prefix4.orderHash) {
+            cerr << "Mismatch between implementations!" << endl;
+            consistent = false;
+        }
+        cout << "Record                         bytes  sort(ms)  speedup" << endl;
+        cout << "pair<string,int>               " << plain.recordBytes << "  " << plain.milliseconds << "  1x" << endl;
+        cout << "PrefixKeyed<int> (8-byte key)  " << prefix8.recordBytes << "  " << prefix8.milliseconds << "  "
+             << plain.milliseconds / prefix8.milliseconds << "x" << endl;
+        cout << "PrefixKeyed<int> (4-byte key)  " << prefix4.recordBytes << "  " << prefix4.milliseconds << "  "
+             << plain.milliseconds / prefix4.milliseconds << "x" << endl;
+    }
+    return consistent;
+}
+
+struct DeclaredOrder {
+    char tag;
+    double weight;
+    short count;
+    int id;
+    char flag;
+};
+
+int main(int argc, char* argv[]) {
+    // Create packed pairs
+    PackedPair<int, string> p1(1, "apple");
+    PackedPair<int, string> p2(2, "banana");
+
+    // Access elements
+    cout << "p1: (" << p1.first() << ", " << p1.second() << ")" << endl;
+    cout << "p2: (" << p2.first() << ", " << p2.second() << ")" << endl;
+
+    // Assignment
+    p1 = p2;
+    cout << "After assignment, p1: (" << p1.first() << ", " << p1.second() << ")" << endl;
+
+    // Comparison
+    PackedPair<int, string> p3(2, "banana");
+    if (p2 == p3) {
+        cout << "p2 and p3 are equal" << endl;
+    }
+
+    // Layout: fields reordered by alignment, accessed in declared order
+    typedef PackedTuple<char, double, short, int, char> Record;
+    Record record('A', 2.5, short(7), 42, 'z');
+    cout << "Record fields: " << record.get<0>() << " " << record.get<1>() << " " << record.get<2>() << " "
+         << record.get<3>() << " " << record.get<4>() << endl;
+    cout << "struct {char, double, short, int, char}: " << sizeof(DeclaredOrder) << " bytes" << endl;
+    cout << "PackedTuple<char, double, short, int, char>: " << sizeof(Record) << " bytes (double at offset "
+         << Record::offsetOf<1>() << ", first char at offset " << Record::offsetOf<0>() << ")" << endl;
+
+    // Prefix-cached keys
+    vector<PrefixKeyed<int>> people;
+    people.push_back(PrefixKeyed<int>("Charlie", 35));
+    people.push_back(PrefixKeyed<int>("Alice", 30));
+    people.push_back(PrefixKeyed<int>("Bob", 25));
+    people.push_back(PrefixKeyed<int>("Alice Cooper", 77));
+    sort(people.begin(), people.end());
+    cout << "Sorted by key:" << endl;
+    for (const auto& person : people) {
+        cout << "  " << person.first() << " -> " << person.second() << endl;
+    }
+    people[0].setKey("Zed");
+    cout << "After renaming, " << people[0].first() << " sorts after Charlie: "
+         << (people[3] < people[0] ? "yes" : "no") << endl;
+
+    size_t count = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 10000000;
+    if (!runBenchmark(count)) return 1;
+
+    return 0;
+}
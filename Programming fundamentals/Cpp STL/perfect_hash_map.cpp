@@ -0,0 +1,373 @@
+/*
+ * perfect_hash_map.cpp
+ * Demonstrates a static map built on a minimal perfect hash function (CHD: hash, displace, compress).
+ * Definition: When the full key set is known ahead of time, a minimal perfect hash maps each of the
+ * n keys to a distinct slot in 0..n-1. Lookups then take exactly one probe into a flat value array:
+ * no collision chains, no tree walk, no pointer chasing.
+ * Shows major operations: build from a key list, find, contains, access, iterate, emitting the table
+ * as a C++ header at build time, and a benchmark against std::map and std::unordered_map.
+ * Run this file independently to see perfect hash map operations in action.
+ * Usage: ./perfect_hash_map [number_of_keys]            (demo + benchmark, default 5000)
+ *        ./perfect_hash_map --emit keys.txt > table.h    (build-time generator: "key value" per line)
+ */
+#include <iostream>
+#include <fstream>
+#include <map>
+#include <unordered_map>
+#include <string>
+#include <vector>
+#include <algorithm>   // for sort
+#include <numeric>     // for iota
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+using namespace std;
+
+// -------------------------------------------------
+// HASH FUNCTIONS
+// -------------------------------------------------
+
+// FNV-1a: computed once per key, then reused for bucket choice and every displacement attempt
+uint64_t baseHash(const string& key) {
+    uint64_t h = 14695981039346656037ULL;
+    for (unsigned char c : key) {
+        h ^= c;
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+// Murmur3 finaliser: turns (base hash, seed) into a well-mixed slot hash
+uint64_t mixHash(uint64_t base, uint32_t seed) {
+    uint64_t h = base ^ (uint64_t(seed) * 0x9E3779B97F4A7C15ULL);
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+/*
+ * Template class for a static map with a minimal perfect hash
+ *
+ * Build (CHD):
+ *   1. Hash every key into one of n/KEYS_PER_BUCKET buckets.
+ *   2. Process buckets from largest to smallest. For each bucket, try seeds 1, 2, 3, ... until every
+ *      key in the bucket lands (via mixHash(key, seed) % n) on a distinct free slot.
+ *   3. Buckets holding a single key skip the search and take any free slot directly; that slot is
+ *      stored as a negative displacement.
+ * Lookup: bucket = h % buckets, read its displacement, compute the slot, compare one key.
+ *
+ * Template parameter Value: The mapped type
+ */
+template <typename Value>
+class PerfectHashMap {
+private:
+    static const size_t KEYS_PER_BUCKET = 4;
+    static const uint32_t MAX_SEED_ATTEMPTS = 1u << 20;
+
+    vector<int32_t> displacements;  // Per bucket: seed (>0) or -(slot + 1) for singleton buckets
+    vector<uint32_t> keyOffsets;    // Per slot: start of the key inside keyHeap (n + 1 entries)
+    string keyHeap;                 // All keys back to back, in slot order
+    vector<Value> values;           // Per slot: the value
+
+    size_t slotFor(const string& key) const {
+        uint64_t h = baseHash(key);
+        int32_t d = displacements[h % displacements.size()];
+        if (d < 0) return size_t(-d - 1);
+        return mixHash(h, uint32_t(d)) % values.size();
+    }
+
+public:
+    // Build the table from a fixed list of entries
+    // Throws: invalid_argument on duplicate keys, runtime_error if no displacement can be found
+    void build(const vector<pair<string, Value>>& entries) {
+        size_t n = entries.size();
+        size_t bucketCount = max<size_t>(1, n / KEYS_PER_BUCKET);
+
+        vector<uint64_t> hashes(n);
+        vector<vector<size_t>> buckets(bucketCount);
+        for (size_t i = 0; i < n; ++i) {
+            hashes[i] = baseHash(entries[i].first);
+            buckets[hashes[i] % bucketCount].push_back(i);
+        }
+
+        vector<size_t> order(bucketCount);
+        iota(order.begin(), order.end(), 0);
+        sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return buckets[a].size() > buckets[b].size();
+        });
+
+        displacements.assign(bucketCount, 0);
+        vector<size_t> slotOwner(n, SIZE_MAX);
+        vector<size_t> candidateSlots;
+        size_t nextFreeSlot = 0;
+
+        for (size_t bucket : order) {
+            const vector<size_t>& members = buckets[bucket];
+            if (members.empty()) break;   // Sorted by size: the rest are empty too
+
+            if (members.size() == 1) {
+                while (slotOwner[nextFreeSlot] != SIZE_MAX) ++nextFreeSlot;
+                slotOwner[nextFreeSlot] = members[0];
+                displacements[bucket] = -int32_t(nextFreeSlot) - 1;
+                continue;
+            }
+
+            bool placed = false;
+            for (uint32_t seed = 1; seed < MAX_SEED_ATTEMPTS && !placed; ++seed) {
+                candidateSlots.clear();
+                placed = true;
+                for (size_t member : members) {
+                    size_t slot = mixHash(hashes[member], seed) % n;
+                    bool taken = slotOwner[slot] != SIZE_MAX ||
+                                 std::find(candidateSlots.begin(), candidateSlots.end(), slot) != candidateSlots.end();
+                    if (taken) {
+                        placed = false;
+                        break;
+                    }
+                    candidateSlots.push_back(slot);
+                }
+                if (placed) {
+                    for (size_t k = 0; k < members.size(); ++k) slotOwner[candidateSlots[k]] = members[k];
+                    displacements[bucket] = int32_t(seed);
+                }
+            }
+            if (!placed) {
+                // Two identical keys always collide, whatever the seed
+                for (size_t a = 0; a < members.size(); ++a) {
+                    for (size_t b = a + 1; b < members.size(); ++b) {
+                        if (entries[members[a]].first == entries[members[b]].first) {
+                            throw invalid_argument("Duplicate key: " + entries[members[a]].first);
+                        }
+                    }
+                }
+                throw runtime_error("PerfectHashMap: no displacement found for a bucket");
+            }
+        }
+
+        // Lay keys and values out in slot order
+        keyHeap.clear();
+        keyOffsets.assign(1, 0);
+        values.clear();
+        values.reserve(n);
+        for (size_t slot = 0; slot < n; ++slot) {
+            const auto& entry = entries[slotOwner[slot]];
+            keyHeap += entry.first;
+            keyOffsets.push_back(uint32_t(keyHeap.size()));
+            values.push_back(entry.second);
+        }
+    }
+
+    // Find a key (exactly one slot is examined)
+    // Returns: pointer to the value, or nullptr if the key is not part of the set
+    const Value* find(const string& key) const {
+        if (values.empty()) return nullptr;
+        size_t slot = slotFor(key);
+        size_t length = keyOffsets[slot + 1] - keyOffsets[slot];
+        if (length != key.size() || keyHeap.compare(keyOffsets[slot], length, key) != 0) return nullptr;
+        return &values[slot];
+    }
+
+    bool contains(const string& key) const {
+        return find(key) != nullptr;
+    }
+
+    // Access an existing key
+    // Throws: out_of_range if the key is not part of the set
+    const Value& at(const string& key) const {
+        const Value* value = find(key);
+        if (!value) throw out_of_range("PerfectHashMap::at: key not found");
+        return *value;
+    }
+
+    size_t size() const { return values.size(); }
+
+    // Key stored in a slot (slot order is hash order, not sorted order)
+    string keyAt(size_t slot) const {
+        return keyHeap.substr(keyOffsets[slot], keyOffsets[slot + 1] - keyOffsets[slot]);
+    }
+
+    const Value& valueAt(size_t slot) const { return values[slot]; }
+
+    // Total bytes of table data (what has to stay in cache for lookups)
+    size_t tableBytes() const {
+        return displacements.size() * sizeof(int32_t) + keyOffsets.size() * sizeof(uint32_t) +
+               keyHeap.size() + values.size() * sizeof(Value);
+    }
+
+    // Build-time generator: writes a self-contained header with the table as constant arrays
+    // (values are emitted as int, so this is meant for integral Value types)
+    // An empty key set gets a find() that always misses (no zero-length arrays, no modulo by SIZE)
+    // Parameter: out - Destination stream; name - Prefix for the generated identifiers
+    void emitHeader(ostream& out, const string& name) const {
+        out << "// Generated by perfect_hash_map --emit. Do not edit.\n";
+        out << "#pragma once\n#include <cstddef>\n#include <cstdint>\n#include <cstring>\n\n";
+        out << "namespace " << name << " {\n";
+        out << "const uint32_t SIZE = " << values.size() << ";\n";
+        if (values.empty()) {
+            out << "\ninline const int* find(const char*, size_t) { return nullptr; }\n";
+            out << "}  // namespace " << name << "\n";
+            return;
+        }
+        out << "const int32_t DISPLACEMENTS[] = {";
+        for (size_t i = 0; i < displacements.size(); ++i) out << (i % 16 ? " " : "\n    ") << displacements[i] << ",";
+        out << "\n};\nconst uint32_t KEY_OFFSETS[] = {";
+        for (size_t i = 0; i < keyOffsets.size(); ++i) out << (i % 16 ? " " : "\n    ") << keyOffsets[i] << ",";
+        out << "\n};\nconst char KEY_HEAP[] =\n    \"";
+        for (size_t i = 0; i < keyHeap.size(); ++i) {
+            char c = keyHeap[i];
+            if (c == '"' || c == '\\') out << '\\' << c;
+            else out << c;
+            if (i % 64 == 63) out << "\"\n    \"";
+        }
+        out << "\";\nconst int VALUES[] = {";
+        for (size_t i = 0; i < values.size(); ++i) out << (i % 16 ? " " : "\n    ") << values[i] << ",";
+        out << "\n};\n\n";
+        out << "inline const int* find(const char* key, size_t length) {\n"
+               "    uint64_t h = 14695981039346656037ULL;\n"
+               "    for (size_t i = 0; i < length; ++i) { h ^= (unsigned char)key[i]; h *= 1099511628211ULL; }\n"
+               "    int32_t d = DISPLACEMENTS[h % (sizeof(DISPLACEMENTS) / sizeof(DISPLACEMENTS[0]))];\n"
+               "    uint64_t slot;\n"
+               "    if (d < 0) {\n"
+               "        slot = uint64_t(-d - 1);\n"
+               "    } else {\n"
+               "        uint64_t m = h ^ (uint64_t(d) * 0x9E3779B97F4A7C15ULL);\n"
+               "        m ^= m >> 33; m *= 0xFF51AFD7ED558CCDULL;\n"
+               "        m ^= m >> 33; m *= 0xC4CEB9FE1A85EC53ULL;\n"
+               "        m ^= m >> 33;\n"
+               "        slot = m % SIZE;\n"
+               "    }\n"
+               "    if (KEY_OFFSETS[slot + 1] - KEY_OFFSETS[slot] != length) return nullptr;\n"
+               "    if (memcmp(KEY_HEAP + KEY_OFFSETS[slot], key, length) != 0) return nullptr;\n"
+               "    return &VALUES[slot];\n"
+               "}\n";
+        out << "}  // namespace " << name << "\n";
+    }
+};
+
+// -------------------------------------------------
+// BENCHMARK AGAINST std::map AND std::unordered_map
+// -------------------------------------------------
+
+using Clock = chrono::steady_clock;
+
+template <typename Lookup>
+double nsPerLookup(const vector<string>& probes, Lookup lookup, long long& hits) {
+    const int repetitions = 20;
+    hits = 0;
+    auto start = Clock::now();
+    for (int r = 0; r < repetitions; ++r) {
+        for (const string& probe : probes) hits += lookup(probe);
+    }
+    double ns = chrono::duration<double, nano>(Clock::now() - start).count();
+    return ns / (double(probes.size()) * repetitions);
+}
+
+// Returns: false if the implementations disagree (also reported on cerr)
+bool runBenchmark(size_t count) {
+    cout << "\n=== BENCHMARK: " << count << " fixed keys ===" << endl;
+    vector<pair<string, int>> entries;
+    for (size_t i = 0; i < count; ++i) entries.push_back({"config_key_" + to_string(i * 7919), int(i)});
+
+    map<string, int> treeMap(entries.begin(), entries.end());
+    unordered_map<string, int> hashMap(entries.begin(), entries.end());
+    PerfectHashMap<int> perfect;
+    auto start = Clock::now();
+    perfect.build(entries);
+    double buildMs = chrono::duration<double, milli>(Clock::now() - start).count();
+
+    // Half hits, half misses, in random order
+    mt19937 rng(1);
+    vector<string> probes;
+    for (size_t i = 0; i < count; ++i) {
+        probes.push_back(i % 2 ? entries[rng() % count].first : "config_key_" + to_string(rng() % (count * 7919)) + "x");
+    }
+
+    long long treeHits = 0, hashHits = 0, perfectHits = 0;
+    double treeNs = nsPerLookup(probes, [&](const string& k) { return treeMap.count(k); }, treeHits);
+    double hashNs = nsPerLookup(probes, [&](const string& k) { return hashMap.count(k); }, hashHits);
+    double perfectNs = nsPerLookup(probes, [&](const string& k) { return perfect.contains(k) ? 1 : 0; }, perfectHits);
+
+    bool consistent = treeHits == hashHits && treeHits == perfectHits;
+    if (!consistent) cerr << "Mismatch between implementations!" << endl;
+
+    cout << "Perfect hash build: " << buildMs << " ms, table size: " << perfect.tableBytes() << " bytes ("
+         << double(perfect.tableBytes()) / count << " bytes/key)" << endl;
+    cout << "Container             lookup(ns)" << endl;
+    cout << "std::map              " << treeNs << endl;
+    cout << "std::unordered_map    " << hashNs << endl;
+    cout << "PerfectHashMap        " << perfectNs << endl;
+    return consistent;
+}
+
+// Build-time mode: read "key value" lines and write a header to stdout
+int emitFromFile(const string& path) {
+    ifstream in(path);
+    if (!in) {
+        cerr << "Cannot open " << path << endl;
+        return 1;
+    }
+    vector<pair<string, int>> entries;
+    string key;
+    int value;
+    while (in >> key >> value) entries.push_back({key, value});
+
+    try {
+        PerfectHashMap<int> table;
+        table.build(entries);
+        table.emitHeader(cout, "generated_table");
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 2 && string(argv[1]) == "--emit") {
+        return emitFromFile(argv[2]);
+    }
+
+    // Build from a key set known up front
+    PerfectHashMap<int> age;
+    age.build({{"Alice", 25}, {"Bob", 30}, {"Charlie", 22}, {"Diana", 28}, {"Eve", 35}});
+
+    // Access elements
+    cout << "Alice's age: " << age.at("Alice") << endl;
+
+    // Iterate and print (slot order)
+    cout << "All ages:" << endl;
+    for (size_t slot = 0; slot < age.size(); ++slot) {
+        cout << age.keyAt(slot) << ": " << age.valueAt(slot) << endl;
+    }
+
+    // Find element
+    for (string name : {"Bob", "Mallory"}) {
+        const int* found = age.find(name);
+        if (found) {
+            cout << name << " found, age = " << *found << endl;
+        } else {
+            cout << name << " not found" << endl;
+        }
+    }
+
+    // Duplicate keys cannot be perfectly hashed
+    try {
+        PerfectHashMap<int> broken;
+        broken.build({{"Alice", 1}, {"Bob", 2}, {"Alice", 3}, {"Carol", 4}, {"Dan", 5}, {"Eve", 6}, {"Fay", 7}, {"Gus", 8}});
+    } catch (const exception& e) {
+        cout << "Caught expected error: " << e.what() << endl;
+    }
+
+    // Size
+    cout << "Map size: " << age.size() << endl;
+
+    size_t count = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 5000;
+    if (!runBenchmark(count)) return 1;
+
+    return 0;
+}
@@ -0,0 +1,529 @@
+/*
+ * point_soa.cpp
+ * Demonstrates a structure-of-arrays (SoA) point container as a replacement for vector<pair<int,int>>.
+ * Definition: vector<pair<int,int>> stores points as x0 y0 x1 y1 ... (array of structures). PointSoA
+ * keeps all x coordinates in one array and all y coordinates in another, so a SIMD register can load
+ * eight x values (or eight y values) at once and geometry loops vectorize cleanly.
+ * Shows major operations: push_back, pair-like iteration through proxy references, assignment through
+ * a proxy, and AVX2 kernels (picked at runtime, scalar fallback otherwise) for bounding box,
+ * translation, squared distance to a query point and k-nearest candidate filtering, with a benchmark
+ * against the same loops over vector<pair<int,int>>.
+ * Coordinates (points and queries) must satisfy |c| < 2^30: the AVX2 kernels subtract in 32 bits,
+ * and |x - qx| <= 2^31 - 2 is the largest difference that still fits in an int.
+ * Run this file independently to see SoA point operations in action.
+ * Usage: ./point_soa [number_of_points]   (default 10000000)
+ */
+#include <iostream>
+#include <vector>
+#include <utility>     // for pair
+#include <algorithm>   // for min, max, nth_element, partial_sort
+#include <chrono>
+#include <random>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define POINTS_X86 1
+#endif
+using namespace std;
+
+// -------------------------------------------------
+// 1. PROXY REFERENCES
+// -------------------------------------------------
+
+/*
+ * Pair-like view of one point inside a PointSoA
+ * pt.first / pt.second refer to the stored x / y, so reads and writes go straight to the arrays.
+ */
+struct PointRef {
+    int& first;
+    int& second;
+
+    PointRef(int& x, int& y) : first(x), second(y) {}
+
+    PointRef& operator=(const pair<int, int>& point) {
+        first = point.first;
+        second = point.second;
+        return *this;
+    }
+
+    operator pair<int, int>() const { return make_pair(first, second); }
+};
+
+struct ConstPointRef {
+    const int& first;
+    const int& second;
+
+    ConstPointRef(const int& x, const int& y) : first(x), second(y) {}
+
+    operator pair<int, int>() const { return make_pair(first, second); }
+};
+
+// -------------------------------------------------
+// 2. POINT CONTAINER
+// -------------------------------------------------
+
+/*
+ * Points stored as two parallel arrays
+ * xs[i], ys[i] is point i. Iterators yield PointRef / ConstPointRef proxies instead of pair&,
+ * so range-for loops written for vector<pair<int,int>> keep working.
+ */
+class PointSoA {
+private:
+    vector<int> xs;
+    vector<int> ys;
+
+public:
+    template <typename Container, typename Ref>
+    class Iterator {
+    private:
+        Container* owner;
+        size_t index;
+
+    public:
+        Iterator(Container* owner, size_t index) : owner(owner), index(index) {}
+
+        Ref operator*() const { return Ref(owner->xData()[index], owner->yData()[index]); }
+        Iterator& operator++() { ++index; return *this; }
+        Iterator operator+(ptrdiff_t n) const { return Iterator(owner, size_t(ptrdiff_t(index) + n)); }
+        ptrdiff_t operator-(const Iterator& other) const { return ptrdiff_t(index) - ptrdiff_t(other.index); }
+        bool operator==(const Iterator& other) const { return index == other.index; }
+        bool operator!=(const Iterator& other) const { return index != other.index; }
+    };
+
+    typedef Iterator<PointSoA, PointRef> iterator;
+    typedef Iterator<const PointSoA, ConstPointRef> const_iterator;
+
+    PointSoA() {}
+
+    // Convert from the array-of-structures layout
+    explicit PointSoA(const vector<pair<int, int>>& points) {
+        reserve(points.size());
+        for (const auto& pt : points) push_back(pt.first, pt.second);
+    }
+
+    void reserve(size_t count) {
+        xs.reserve(count);
+        ys.reserve(count);
+    }
+
+    void push_back(int x, int y) {
+        xs.push_back(x);
+        ys.push_back(y);
+    }
+
+    void push_back(const pair<int, int>& point) { push_back(point.first, point.second); }
+
+    size_t size() const { return xs.size(); }
+    bool empty() const { return xs.empty(); }
+
+    void clear() {
+        xs.clear();
+        ys.clear();
+    }
+
+    int* xData() { return xs.data(); }
+    int* yData() { return ys.data(); }
+    const int* xData() const { return xs.data(); }
+    const int* yData() const { return ys.data(); }
+
+    PointRef operator[](size_t i) { return PointRef(xs[i], ys[i]); }
+    ConstPointRef operator[](size_t i) const { return ConstPointRef(xs[i], ys[i]); }
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, size()); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size()); }
+};
+
+// -------------------------------------------------
+// 3. SCALAR KERNELS (fallback and vector tails)
+// -------------------------------------------------
+
+struct BoundingBox {
+    int minX, minY, maxX, maxY;
+};
+
+void boundingBoxScalar(const int* xs, const int* ys, size_t from, size_t to, BoundingBox& box) {
+    for (size_t i = from; i < to; ++i) {
+        box.minX = min(box.minX, xs[i]);
+        box.maxX = max(box.maxX, xs[i]);
+        box.minY = min(box.minY, ys[i]);
+        box.maxY = max(box.maxY, ys[i]);
+    }
+}
+
+void translateScalar(int* xs, int* ys, size_t from, size_t to, int dx, int dy) {
+    for (size_t i = from; i < to; ++i) {
+        xs[i] += dx;
+        ys[i] += dy;
+    }
+}
+
+inline int64_t squaredDistance(int x, int y, int qx, int qy) {
+    int64_t dx = int64_t(x) - qx;
+    int64_t dy = int64_t(y) - qy;
+    return dx * dx + dy * dy;
+}
+
+void squaredDistancesScalar(const int* xs, const int* ys, size_t from, size_t to, int qx, int qy, int64_t* out) {
+    for (size_t i = from; i < to; ++i) out[i] = squaredDistance(xs[i], ys[i], qx, qy);
+}
+
+void filterWithinScalar(const int* xs, const int* ys, size_t from, size_t to, int qx, int qy,
+                        int64_t limit, vector<size_t>& candidates) {
+    for (size_t i = from; i < to; ++i) {
+        if (squaredDistance(xs[i], ys[i], qx, qy) <= limit) candidates.push_back(i);
+    }
+}
+
+// -------------------------------------------------
+// 4. AVX2 KERNELS
+// -------------------------------------------------
+
+#ifdef POINTS_X86
+bool cpuHasAvx2() {
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+
+__attribute__((target("avx2")))
+void boundingBoxAvx2(const int* xs, const int* ys, size_t n, BoundingBox& box) {
+    __m256i minX = _mm256_set1_epi32(box.minX), maxX = _mm256_set1_epi32(box.maxX);
+    __m256i minY = _mm256_set1_epi32(box.minY), maxY = _mm256_set1_epi32(box.maxY);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(xs + i));
+        __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ys + i));
+        minX = _mm256_min_epi32(minX, x);
+        maxX = _mm256_max_epi32(maxX, x);
+        minY = _mm256_min_epi32(minY, y);
+        maxY = _mm256_max_epi32(maxY, y);
+    }
+    alignas(32) int lanes[4][8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[0]), minX);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[1]), maxX);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[2]), minY);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes[3]), maxY);
+    for (int lane = 0; lane < 8; ++lane) {
+        box.minX = min(box.minX, lanes[0][lane]);
+        box.maxX = max(box.maxX, lanes[1][lane]);
+        box.minY = min(box.minY, lanes[2][lane]);
+        box.maxY = max(box.maxY, lanes[3][lane]);
+    }
+    boundingBoxScalar(xs, ys, i, n, box);
+}
+
+__attribute__((target("avx2")))
+void translateAvx2(int* xs, int* ys, size_t n, int dx, int dy) {
+    __m256i shiftX = _mm256_set1_epi32(dx), shiftY = _mm256_set1_epi32(dy);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i* px = reinterpret_cast<__m256i*>(xs + i);
+        __m256i* py = reinterpret_cast<__m256i*>(ys + i);
+        _mm256_storeu_si256(px, _mm256_add_epi32(_mm256_loadu_si256(px), shiftX));
+        _mm256_storeu_si256(py, _mm256_add_epi32(_mm256_loadu_si256(py), shiftY));
+    }
+    translateScalar(xs, ys, i, n, dx, dy);
+}
+
+/*
+ * Squared distances of points i..i+7 as 64-bit lanes: first = points 0-3, second = points 4-7
+ * _mm256_mul_epi32 multiplies the even 32-bit lanes into 64-bit products, so the odd lanes are
+ * shifted down and multiplied separately, then the two halves are interleaved back into order.
+ */
+__attribute__((target("avx2")))
+inline void squaredDistance8(const int* xs, const int* ys, __m256i qx, __m256i qy, __m256i& first, __m256i& second) {
+    __m256i dx = _mm256_sub_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(xs)), qx);
+    __m256i dy = _mm256_sub_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(ys)), qy);
+    __m256i even = _mm256_add_epi64(_mm256_mul_epi32(dx, dx), _mm256_mul_epi32(dy, dy));
+    __m256i dxOdd = _mm256_srli_epi64(dx, 32), dyOdd = _mm256_srli_epi64(dy, 32);
+    __m256i odd = _mm256_add_epi64(_mm256_mul_epi32(dxOdd, dxOdd), _mm256_mul_epi32(dyOdd, dyOdd));
+    __m256i low = _mm256_unpacklo_epi64(even, odd);    // points 0 1 | 4 5
+    __m256i high = _mm256_unpackhi_epi64(even, odd);   // points 2 3 | 6 7
+    first = _mm256_permute2x128_si256(low, high, 0x20);
+    second = _mm256_permute2x128_si256(low, high, 0x31);
+}
+
+__attribute__((target("avx2")))
+void squaredDistancesAvx2(const int* xs, const int* ys, size_t n, int qx, int qy, int64_t* out) {
+    __m256i queryX = _mm256_set1_epi32(qx), queryY = _mm256_set1_epi32(qy);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i first, second;
+        squaredDistance8(xs + i, ys + i, queryX, queryY, first, second);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), first);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i + 4), second);
+    }
+    squaredDistancesScalar(xs, ys, i, n, qx, qy, out);
+}
+
+__attribute__((target("avx2")))
+void filterWithinAvx2(const int* xs, const int* ys, size_t n, int qx, int qy, int64_t limit,
+                      vector<size_t>& candidates) {
+    __m256i queryX = _mm256_set1_epi32(qx), queryY = _mm256_set1_epi32(qy);
+    __m256i bound = _mm256_set1_epi64x(limit);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i first, second;
+        squaredDistance8(xs + i, ys + i, queryX, queryY, first, second);
+        int outside = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(first, bound)))
+                    | (_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(second, bound))) << 4);
+        unsigned inside = ~unsigned(outside) & 0xFFu;
+        while (inside) {
+            candidates.push_back(i + size_t(__builtin_ctz(inside)));
+            inside &= inside - 1;
+        }
+    }
+    filterWithinScalar(xs, ys, i, n, qx, qy, limit, candidates);
+}
+#endif
+
+// -------------------------------------------------
+// 5. PUBLIC OPERATIONS
+// -------------------------------------------------
+
+// Smallest axis-aligned box containing every point
+// Throws: invalid_argument if there are no points
+BoundingBox boundingBox(const PointSoA& points) {
+    if (points.empty()) throw invalid_argument("Bounding box of an empty point set");
+    BoundingBox box = {INT_MAX, INT_MAX, INT_MIN, INT_MIN};
+#ifdef POINTS_X86
+    if (cpuHasAvx2()) {
+        boundingBoxAvx2(points.xData(), points.yData(), points.size(), box);
+        return box;
+    }
+#endif
+    boundingBoxScalar(points.xData(), points.yData(), 0, points.size(), box);
+    return box;
+}
+
+// Move every point by (dx, dy)
+void translate(PointSoA& points, int dx, int dy) {
+#ifdef POINTS_X86
+    if (cpuHasAvx2()) {
+        translateAvx2(points.xData(), points.yData(), points.size(), dx, dy);
+        return;
+    }
+#endif
+    translateScalar(points.xData(), points.yData(), 0, points.size(), dx, dy);
+}
+
+// out[i] = squared distance from point i to (qx, qy)
+void squaredDistances(const PointSoA& points, int qx, int qy, vector<int64_t>& out) {
+    out.resize(points.size());
+#ifdef POINTS_X86
+    if (cpuHasAvx2()) {
+        squaredDistancesAvx2(points.xData(), points.yData(), points.size(), qx, qy, out.data());
+        return;
+    }
+#endif
+    squaredDistancesScalar(points.xData(), points.yData(), 0, points.size(), qx, qy, out.data());
+}
+
+// Indices of all points whose squared distance to (qx, qy) is <= limit, in index order
+vector<size_t> filterWithin(const PointSoA& points, int qx, int qy, int64_t limit) {
+    vector<size_t> candidates;
+#ifdef POINTS_X86
+    if (cpuHasAvx2()) {
+        filterWithinAvx2(points.xData(), points.yData(), points.size(), qx, qy, limit, candidates);
+        return candidates;
+    }
+#endif
+    filterWithinScalar(points.xData(), points.yData(), 0, points.size(), qx, qy, limit, candidates);
+    return candidates;
+}
+
+/*
+ * Indices of the k points nearest to (qx, qy), nearest first (ties broken by index)
+ *
+ * A radius is guessed from an evenly spaced sample (about 2k/n of the sample should fall inside),
+ * the SIMD filter keeps only points inside it, and the radius is widened until at least k
+ * candidates survive. Only the candidates are then sorted.
+ */
+vector<size_t> kNearest(const PointSoA& points, int qx, int qy, size_t k) {
+    const size_t n = points.size();
+    k = min(k, n);
+    if (k == 0) return vector<size_t>();
+
+    const size_t SAMPLE_SIZE = 4096;
+    size_t sampleCount = min(n, SAMPLE_SIZE);
+    vector<int64_t> sample(sampleCount);
+    for (size_t s = 0; s < sampleCount; ++s) {
+        size_t i = s * (n / sampleCount);
+        sample[s] = squaredDistance(points.xData()[i], points.yData()[i], qx, qy);
+    }
+    size_t rank = min(sampleCount - 1, (2 * k * sampleCount + n - 1) / n);
+    nth_element(sample.begin(), sample.begin() + rank, sample.end());
+    int64_t limit = sample[rank];
+
+    vector<size_t> candidates = filterWithin(points, qx, qy, limit);
+    while (candidates.size() < k) {
+        limit = (limit >= INT64_MAX / 4) ? INT64_MAX : limit * 4 + 1;
+        candidates = filterWithin(points, qx, qy, limit);
+    }
+
+    vector<pair<int64_t, size_t>> ranked;
+    ranked.reserve(candidates.size());
+    for (size_t i : candidates) ranked.push_back(make_pair(squaredDistance(points.xData()[i], points.yData()[i], qx, qy), i));
+    partial_sort(ranked.begin(), ranked.begin() + k, ranked.end());
+
+    vector<size_t> nearest(k);
+    for (size_t j = 0; j < k; ++j) nearest[j] = ranked[j].second;
+    return nearest;
+}
+
+// -------------------------------------------------
+// 6. BENCHMARK
+// -------------------------------------------------
+
+using Clock = chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start) {
+    return chrono::duration<double, milli>(Clock::now() - start).count();
+}
+
+void printRow(const char* label, double pairMs, double soaMs) {
+    cout << label << pairMs << "  " << soaMs << "  " << pairMs / soaMs << "x" << endl;
+}
+
+// Returns: false if the implementations disagree (also reported on cerr)
+bool runBenchmark(size_t count) {
+    cout << "\n=== BENCHMARK: " << count << " points ===" << endl;
+    mt19937 rng(38);
+    uniform_int_distribution<int> coordinate(-1000000, 1000000);
+    vector<pair<int, int>> pairs(count);
+    for (auto& pt : pairs) pt = make_pair(coordinate(rng), coordinate(rng));
+    PointSoA soa(pairs);
+    const int qx = 1234, qy = -5678;
+    const size_t k = 16;
+
+    // Bounding box
+    auto start = Clock::now();
+    BoundingBox pairBox = {INT_MAX, INT_MAX, INT_MIN, INT_MIN};
+    for (const auto& pt : pairs) {
+        pairBox.minX = min(pairBox.minX, pt.first);
+        pairBox.maxX = max(pairBox.maxX, pt.first);
+        pairBox.minY = min(pairBox.minY, pt.second);
+        pairBox.maxY = max(pairBox.maxY, pt.second);
+    }
+    double pairBoxMs = elapsedMs(start);
+    start = Clock::now();
+    BoundingBox soaBox = boundingBox(soa);
+    double soaBoxMs = elapsedMs(start);
+
+    // Translation (there and back, so the data is unchanged for the next kernels)
+    start = Clock::now();
+    for (auto& pt : pairs) { pt.first += 7; pt.second -= 3; }
+    for (auto& pt : pairs) { pt.first -= 7; pt.second += 3; }
+    double pairMoveMs = elapsedMs(start) / 2;
+    start = Clock::now();
+    translate(soa, 7, -3);
+    translate(soa, -7, 3);
+    double soaMoveMs = elapsedMs(start) / 2;
+
+    // Squared distances
+    vector<int64_t> pairDistances(count), soaDistances(count);   // both touched before timing
+    start = Clock::now();
+    for (size_t i = 0; i < count; ++i) pairDistances[i] = squaredDistance(pairs[i].first, pairs[i].second, qx, qy);
+    double pairDistMs = elapsedMs(start);
+    start = Clock::now();
+    squaredDistances(soa, qx, qy, soaDistances);
+    double soaDistMs = elapsedMs(start);
+
+    // k nearest: the pair version ranks every point
+    start = Clock::now();
+    vector<pair<int64_t, size_t>> ranked(count);
+    for (size_t i = 0; i < count; ++i) ranked[i] = make_pair(squaredDistance(pairs[i].first, pairs[i].second, qx, qy), i);
+    size_t kk = min(k, count);
+    partial_sort(ranked.begin(), ranked.begin() + kk, ranked.end());
+    double pairKnnMs = elapsedMs(start);
+    start = Clock::now();
+    vector<size_t> nearest = kNearest(soa, qx, qy, k);
+    double soaKnnMs = elapsedMs(start);
+
+    bool same = pairBox.minX == soaBox.minX && pairBox.maxX == soaBox.maxX && pairBox.minY == soaBox.minY
+                && pairBox.maxY == soaBox.maxY && pairDistances == soaDistances && nearest.size() == kk;
+    for (size_t j = 0; same && j < kk; ++j) same = ranked[j].second == nearest[j];
+    if (!same) cerr << "Mismatch between implementations!" << endl;
+
+    cout << "Kernel           pair(ms)  SoA(ms)  speedup" << endl;
+    printRow("bounding box     ", pairBoxMs, soaBoxMs);
+    printRow("translate        ", pairMoveMs, soaMoveMs);
+    printRow("squared distance ", pairDistMs, soaDistMs);
+    printRow("16 nearest       ", pairKnnMs, soaKnnMs);
+    return same;
+}
+
+int main(int argc, char* argv[]) {
+    // Build points the same way pairs.cpp does
+    PointSoA points;
+    points.push_back(1, 2);
+    points.push_back(make_pair(3, 4));
+    points.push_back(make_pair(5, 6));
+
+    // Iterate like vector<pair<int,int>>
+    cout << "Points:" << endl;
+    for (auto pt : points) {
+        cout << "(" << pt.first << ", " << pt.second << ") ";
+    }
+    cout << endl;
+
+    // Write through a proxy reference
+    points[1] = make_pair(-3, 10);
+    points[2].first = 8;
+    pair<int, int> copied = points[1];
+    cout << "After assignment, point 1: (" << copied.first << ", " << copied.second << ")" << endl;
+
+    // Geometry kernels
+    BoundingBox box = boundingBox(points);
+    cout << "Bounding box: (" << box.minX << ", " << box.minY << ") - (" << box.maxX << ", " << box.maxY << ")" << endl;
+
+    translate(points, 10, 10);
+    cout << "After translate by (10, 10): ";
+    for (auto pt : points) cout << "(" << pt.first << ", " << pt.second << ") ";
+    cout << endl;
+
+    vector<int64_t> distances;
+    squaredDistances(points, 10, 10, distances);
+    cout << "Squared distances to (10, 10): ";
+    for (int64_t d : distances) cout << d << " ";
+    cout << endl;
+
+    vector<size_t> nearest = kNearest(points, 10, 10, 2);
+    cout << "2 nearest to (10, 10): ";
+    for (size_t i : nearest) cout << i << " ";
+    cout << endl;
+
+    // Opposite corners of the allowed range: the differences are the largest that fit in an int
+    const int edge = (1 << 30) - 1;
+    PointSoA corners;
+    for (int i = 0; i < 9; ++i) corners.push_back(edge, -edge);   // 9 points: one SIMD pass plus a tail
+    squaredDistances(corners, -edge, edge, distances);
+    const int64_t expected = 2 * int64_t(2 * edge) * (2 * edge);
+    for (int64_t d : distances) {
+        if (d != expected) {
+            cerr << "Squared distance at the coordinate limit is " << d << ", expected " << expected << endl;
+            return 1;
+        }
+    }
+    cout << "Squared distance across the coordinate range: " << expected << endl;
+
+    // Error handling
+    try {
+        boundingBox(PointSoA());
+    } catch (const invalid_argument& e) {
+        cout << "Caught expected error: " << e.what() << endl;
+    }
+
+#ifdef POINTS_X86
+    cout << "AVX2 kernels: " << (cpuHasAvx2() ? "yes" : "no (scalar fallback)") << endl;
+#endif
+
+    size_t count = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 10000000;
+    if (!runBenchmark(count)) return 1;
+
+    return 0;
+}
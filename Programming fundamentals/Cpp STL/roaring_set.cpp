@@ -0,0 +1,590 @@
+/*
+ * roaring_set.cpp
+ * Demonstrates a roaring-style compressed bitmap set of 32-bit integers as an alternative to std::set<int>.
+ * Definition: A roaring set splits every value into a 16-bit high part (the chunk key) and a 16-bit low
+ * part. Each chunk keeps its low parts in whichever container is smallest for its density:
+ *   - ARRAY  : sorted uint16 values        (sparse chunks, up to 4096 values, 2 bytes per value)
+ *   - BITMAP : 65536 bits = 8 KB            (dense chunks)
+ *   - RUN    : sorted [start, length] runs  (consecutive ranges, 4 bytes per run)
+ * Shows major operations: insert, erase, contains, ordered iteration, cardinality, rank/select,
+ * run compression, and a benchmark of memory and membership tests against std::set<int>.
+ * Values are unsigned: iteration order is the order of uint32_t.
+ * Run this file independently to see roaring set operations in action.
+ * Usage: ./roaring_set [number_of_values]   (default 5000000)
+ */
+#include <iostream>
+#include <set>
+#include <vector>
+#include <algorithm>   // for lower_bound, upper_bound
+#include <iterator>    // for forward_iterator_tag
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+#include "heap_accounting.h"   // liveHeapBytes() for the memory comparison
+using namespace std;
+
+// -------------------------------------------------
+// 1. CHUNK CONTAINER (array, bitmap or run)
+// -------------------------------------------------
+
+const uint32_t ARRAY_MAX_SIZE = 4096;            // Above this an array is larger than a bitmap
+const uint32_t BITMAP_WORDS = 65536 / 64;        // 1024 x 64-bit words
+
+struct Run {
+    uint16_t start;
+    uint16_t lengthMinusOne;   // Run covers start .. start + lengthMinusOne
+    uint32_t end() const { return uint32_t(start) + lengthMinusOne; }
+};
+
+/*
+ * Holds the low 16 bits of every value in one chunk
+ * Exactly one of the three vectors is in use, chosen by kind.
+ */
+class Container {
+public:
+    enum Kind { ARRAY, BITMAP, RUN };
+
+    Kind kind;
+    uint32_t cardinality;
+    vector<uint16_t> array;
+    vector<uint64_t> bitmap;
+    vector<Run> runs;
+
+    Container() : kind(ARRAY), cardinality(0) {}
+
+    bool contains(uint16_t low) const {
+        switch (kind) {
+            case ARRAY:
+                return binary_search(array.begin(), array.end(), low);
+            case BITMAP:
+                return (bitmap[low >> 6] >> (low & 63)) & 1;
+            case RUN: {
+                size_t i = runIndexFor(low);
+                return i < runs.size() && low >= runs[i].start && low <= runs[i].end();
+            }
+        }
+        return false;
+    }
+
+    // Returns: true if the value was not present before
+    bool insert(uint16_t low) {
+        bool added = false;
+        switch (kind) {
+            case ARRAY: {
+                auto it = lower_bound(array.begin(), array.end(), low);
+                if (it != array.end() && *it == low) return false;
+                if (array.size() == ARRAY_MAX_SIZE) {
+                    convertToBitmap();
+                    return insert(low);
+                }
+                array.insert(it, low);
+                added = true;
+                break;
+            }
+            case BITMAP: {
+                uint64_t bit = uint64_t(1) << (low & 63);
+                added = !(bitmap[low >> 6] & bit);
+                bitmap[low >> 6] |= bit;
+                break;
+            }
+            case RUN:
+                added = insertIntoRuns(low);
+                break;
+        }
+        if (added) ++cardinality;
+        if (added && kind == RUN) shrinkRuns();
+        return added;
+    }
+
+    // Returns: true if the value was present
+    bool erase(uint16_t low) {
+        bool removed = false;
+        switch (kind) {
+            case ARRAY: {
+                auto it = lower_bound(array.begin(), array.end(), low);
+                if (it == array.end() || *it != low) return false;
+                array.erase(it);
+                removed = true;
+                break;
+            }
+            case BITMAP: {
+                uint64_t bit = uint64_t(1) << (low & 63);
+                removed = (bitmap[low >> 6] & bit) != 0;
+                bitmap[low >> 6] &= ~bit;
+                break;
+            }
+            case RUN:
+                removed = eraseFromRuns(low);
+                break;
+        }
+        if (removed) --cardinality;
+        if (removed && kind == BITMAP && cardinality <= ARRAY_MAX_SIZE) convertToArray();
+        if (removed && kind == RUN) shrinkRuns();
+        return removed;
+    }
+
+    // Number of stored values <= low
+    uint32_t rank(uint16_t low) const {
+        switch (kind) {
+            case ARRAY:
+                return uint32_t(upper_bound(array.begin(), array.end(), low) - array.begin());
+            case BITMAP: {
+                uint32_t count = 0;
+                for (uint32_t w = 0; w < uint32_t(low >> 6); ++w) count += __builtin_popcountll(bitmap[w]);
+                uint64_t mask = ((low & 63) == 63) ? ~uint64_t(0) : ((uint64_t(1) << ((low & 63) + 1)) - 1);
+                return count + __builtin_popcountll(bitmap[low >> 6] & mask);
+            }
+            case RUN: {
+                uint32_t count = 0;
+                for (const Run& run : runs) {
+                    if (run.start > low) break;
+                    count += (run.end() <= low) ? run.lengthMinusOne + 1u : uint32_t(low - run.start) + 1u;
+                }
+                return count;
+            }
+        }
+        return 0;
+    }
+
+    // The index-th smallest stored value (0-based, index < cardinality)
+    uint16_t select(uint32_t index) const {
+        switch (kind) {
+            case ARRAY:
+                return array[index];
+            case BITMAP:
+                for (uint32_t w = 0; w < BITMAP_WORDS; ++w) {
+                    uint32_t bits = __builtin_popcountll(bitmap[w]);
+                    if (index < bits) {
+                        uint64_t word = bitmap[w];
+                        for (uint32_t k = 0; k < index; ++k) word &= word - 1;   // Drop lowest set bits
+                        return uint16_t(w * 64 + __builtin_ctzll(word));
+                    }
+                    index -= bits;
+                }
+                break;
+            case RUN:
+                for (const Run& run : runs) {
+                    if (index <= run.lengthMinusOne) return uint16_t(run.start + index);
+                    index -= run.lengthMinusOne + 1u;
+                }
+                break;
+        }
+        throw out_of_range("Container::select: index out of range");
+    }
+
+    // Switch to runs if that is the smallest encoding for the current contents
+    void runOptimize() {
+        vector<Run> encoded;
+        forEach([&encoded](uint16_t low) {
+            if (!encoded.empty() && encoded.back().end() + 1 == low) {
+                ++encoded.back().lengthMinusOne;
+            } else {
+                encoded.push_back({low, 0});
+            }
+        });
+        size_t currentBytes = (kind == RUN) ? runs.size() * sizeof(Run) : sizeInBytes();
+        if (encoded.size() * sizeof(Run) < currentBytes) {
+            array.clear();
+            array.shrink_to_fit();
+            bitmap.clear();
+            bitmap.shrink_to_fit();
+            runs.swap(encoded);
+            kind = RUN;
+        }
+    }
+
+    template <typename Visitor>
+    void forEach(Visitor visit) const {
+        switch (kind) {
+            case ARRAY:
+                for (uint16_t low : array) visit(low);
+                break;
+            case BITMAP:
+                for (uint32_t w = 0; w < BITMAP_WORDS; ++w) {
+                    for (uint64_t word = bitmap[w]; word; word &= word - 1) {
+                        visit(uint16_t(w * 64 + __builtin_ctzll(word)));
+                    }
+                }
+                break;
+            case RUN:
+                for (const Run& run : runs) {
+                    for (uint32_t low = run.start; low <= run.end(); ++low) visit(uint16_t(low));
+                }
+                break;
+        }
+    }
+
+    size_t sizeInBytes() const {
+        return array.capacity() * sizeof(uint16_t) + bitmap.capacity() * sizeof(uint64_t) +
+               runs.capacity() * sizeof(Run);
+    }
+
+private:
+    // Index of the last run whose start <= low (or 0 / runs.size() when none)
+    size_t runIndexFor(uint16_t low) const {
+        auto it = upper_bound(runs.begin(), runs.end(), low,
+                              [](uint16_t value, const Run& run) { return value < run.start; });
+        return (it == runs.begin()) ? runs.size() : size_t(it - runs.begin()) - 1;
+    }
+
+    bool insertIntoRuns(uint16_t low) {
+        size_t i = runIndexFor(low);
+        size_t next = (i == runs.size()) ? 0 : i + 1;
+        if (i < runs.size() && low <= runs[i].end()) return false;
+
+        bool extendsPrevious = i < runs.size() && runs[i].end() + 1 == low;
+        bool extendsNext = next < runs.size() && uint32_t(low) + 1 == runs[next].start;
+        if (extendsPrevious && extendsNext) {
+            runs[i].lengthMinusOne = uint16_t(runs[next].end() - runs[i].start);
+            runs.erase(runs.begin() + next);
+        } else if (extendsPrevious) {
+            ++runs[i].lengthMinusOne;
+        } else if (extendsNext) {
+            --runs[next].start;
+            ++runs[next].lengthMinusOne;
+        } else {
+            runs.insert(runs.begin() + next, Run{low, 0});
+        }
+        return true;
+    }
+
+    bool eraseFromRuns(uint16_t low) {
+        size_t i = runIndexFor(low);
+        if (i == runs.size() || low > runs[i].end()) return false;
+
+        Run& run = runs[i];
+        if (run.lengthMinusOne == 0) {
+            runs.erase(runs.begin() + i);
+        } else if (low == run.start) {
+            ++run.start;
+            --run.lengthMinusOne;
+        } else if (low == run.end()) {
+            --run.lengthMinusOne;
+        } else {
+            // Split [start, end] into [start, low - 1] and [low + 1, end]
+            Run tail{uint16_t(low + 1), uint16_t(run.end() - low - 1)};
+            run.lengthMinusOne = uint16_t(low - run.start - 1);
+            runs.insert(runs.begin() + i + 1, tail);
+        }
+        return true;
+    }
+
+    /*
+     * Scattered inserts or erases split runs, so a RUN container can grow far past the other
+     * encodings (up to 32768 runs = 128 KB) with an O(runs) vector shift per update.
+     * Leave RUN once it is larger than a bitmap, or larger than an array of the same values.
+     */
+    void shrinkRuns() {
+        size_t runBytes = runs.size() * sizeof(Run);
+        if (runBytes > BITMAP_WORDS * sizeof(uint64_t)) {
+            convertToBitmap();
+        } else if (cardinality <= ARRAY_MAX_SIZE && cardinality * sizeof(uint16_t) < runBytes) {
+            convertToArray();
+        }
+    }
+
+    void convertToBitmap() {
+        vector<uint64_t> words(BITMAP_WORDS, 0);
+        forEach([&words](uint16_t low) { words[low >> 6] |= uint64_t(1) << (low & 63); });
+        bitmap.swap(words);
+        array.clear();
+        array.shrink_to_fit();
+        runs.clear();
+        runs.shrink_to_fit();
+        kind = BITMAP;
+    }
+
+    void convertToArray() {
+        vector<uint16_t> values;
+        values.reserve(cardinality);
+        forEach([&values](uint16_t low) { values.push_back(low); });
+        array.swap(values);
+        bitmap.clear();
+        bitmap.shrink_to_fit();
+        runs.clear();
+        runs.shrink_to_fit();
+        kind = ARRAY;
+    }
+};
+
+// -------------------------------------------------
+// 2. ROARING SET
+// -------------------------------------------------
+
+/*
+ * Compressed set of 32-bit unsigned integers
+ * Chunks are kept sorted by their high 16 bits, so iteration is ordered.
+ */
+class RoaringSet {
+private:
+    vector<uint16_t> keys;          // Sorted high-16-bit chunk keys
+    vector<Container> containers;   // containers[i] holds chunk keys[i]
+
+    static uint16_t high(uint32_t value) { return uint16_t(value >> 16); }
+    static uint16_t low(uint32_t value) { return uint16_t(value & 0xFFFF); }
+
+    // Position of chunk key, or -1 if absent
+    long chunkIndex(uint16_t key) const {
+        auto it = lower_bound(keys.begin(), keys.end(), key);
+        return (it != keys.end() && *it == key) ? long(it - keys.begin()) : -1;
+    }
+
+public:
+    // Ordered forward iterator over all values
+    class const_iterator {
+    private:
+        const RoaringSet* owner;
+        size_t chunk;
+        uint32_t position;   // Index within the chunk (0 .. cardinality-1)
+        uint32_t current;
+
+        void load() {
+            while (chunk < owner->keys.size() && position >= owner->containers[chunk].cardinality) {
+                ++chunk;
+                position = 0;
+            }
+            if (chunk < owner->keys.size()) {
+                current = (uint32_t(owner->keys[chunk]) << 16) | owner->containers[chunk].select(position);
+            }
+        }
+
+    public:
+        using iterator_category = forward_iterator_tag;
+        using value_type = uint32_t;
+        using difference_type = ptrdiff_t;
+        using pointer = const uint32_t*;
+        using reference = uint32_t;
+
+        const_iterator(const RoaringSet* owner, size_t chunk) : owner(owner), chunk(chunk), position(0), current(0) {
+            load();
+        }
+        uint32_t operator*() const { return current; }
+        const_iterator& operator++() {
+            // Array containers are indexed directly; other kinds step to the next value in the chunk
+            const Container& c = owner->containers[chunk];
+            if (c.kind != Container::ARRAY && position + 1 < c.cardinality) {
+                uint16_t lowPart = uint16_t(current & 0xFFFF);
+                do {
+                    ++lowPart;
+                } while (!c.contains(lowPart));
+                current = (current & 0xFFFF0000u) | lowPart;
+                ++position;
+                return *this;
+            }
+            ++position;
+            load();
+            return *this;
+        }
+        bool operator==(const const_iterator& other) const {
+            return chunk == other.chunk && (chunk == owner->keys.size() || position == other.position);
+        }
+        bool operator!=(const const_iterator& other) const { return !(*this == other); }
+    };
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, keys.size()); }
+
+    // Returns: true if the value was inserted (false for duplicates, same as set::insert().second)
+    bool insert(uint32_t value) {
+        auto it = lower_bound(keys.begin(), keys.end(), high(value));
+        size_t index = it - keys.begin();
+        if (it == keys.end() || *it != high(value)) {
+            keys.insert(it, high(value));
+            containers.insert(containers.begin() + index, Container());
+        }
+        return containers[index].insert(low(value));
+    }
+
+    // Returns: Number of removed values (0 or 1), same as set::erase(value)
+    size_t erase(uint32_t value) {
+        long index = chunkIndex(high(value));
+        if (index < 0 || !containers[index].erase(low(value))) return 0;
+        if (containers[index].cardinality == 0) {
+            keys.erase(keys.begin() + index);
+            containers.erase(containers.begin() + index);
+        }
+        return 1;
+    }
+
+    bool contains(uint32_t value) const {
+        long index = chunkIndex(high(value));
+        return index >= 0 && containers[index].contains(low(value));
+    }
+
+    // Total number of values
+    uint64_t cardinality() const {
+        uint64_t total = 0;
+        for (const Container& c : containers) total += c.cardinality;
+        return total;
+    }
+
+    // Number of values <= value
+    uint64_t rank(uint32_t value) const {
+        uint64_t total = 0;
+        for (size_t i = 0; i < keys.size() && keys[i] <= high(value); ++i) {
+            total += (keys[i] < high(value)) ? containers[i].cardinality : containers[i].rank(low(value));
+        }
+        return total;
+    }
+
+    // The index-th smallest value (0-based)
+    // Throws: out_of_range if index >= cardinality()
+    uint32_t select(uint64_t index) const {
+        for (size_t i = 0; i < keys.size(); ++i) {
+            if (index < containers[i].cardinality) {
+                return (uint32_t(keys[i]) << 16) | containers[i].select(uint32_t(index));
+            }
+            index -= containers[i].cardinality;
+        }
+        throw out_of_range("RoaringSet::select: index out of range");
+    }
+
+    // Re-encode consecutive ranges as runs where that is smaller
+    void runOptimize() {
+        for (Container& c : containers) c.runOptimize();
+    }
+
+    // Visit every value in order (faster than the iterator for full scans)
+    template <typename Visitor>
+    void forEach(Visitor visit) const {
+        for (size_t i = 0; i < keys.size(); ++i) {
+            uint32_t base = uint32_t(keys[i]) << 16;
+            containers[i].forEach([&](uint16_t lowPart) { visit(base | lowPart); });
+        }
+    }
+
+    size_t sizeInBytes() const {
+        size_t bytes = keys.capacity() * sizeof(uint16_t) + containers.capacity() * sizeof(Container);
+        for (const Container& c : containers) bytes += c.sizeInBytes();
+        return bytes;
+    }
+
+    bool empty() const { return keys.empty(); }
+
+    void clear() {
+        keys.clear();
+        containers.clear();
+    }
+};
+
+// -------------------------------------------------
+// 3. BENCHMARK AGAINST std::set<int>
+// -------------------------------------------------
+
+using Clock = chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start) {
+    return chrono::duration<double, milli>(Clock::now() - start).count();
+}
+
+// Returns: false if the implementations disagree (also reported on cerr)
+bool runBenchmark(size_t count) {
+    cout << "\n=== BENCHMARK: " << count << " IDs (dense random IDs + one long consecutive range) ===" << endl;
+    mt19937 rng(3);
+    vector<uint32_t> ids;
+    ids.reserve(count);
+    for (size_t i = 0; i < count / 2; ++i) ids.push_back(rng() % uint32_t(count * 4));
+    for (size_t i = 0; i < count / 2; ++i) ids.push_back(uint32_t(count * 8 + i));
+
+    size_t heapBefore = liveHeapBytes();
+    auto start = Clock::now();
+    set<int> tree;
+    for (uint32_t id : ids) tree.insert(int(id));
+    double treeBuildMs = elapsedMs(start);
+    size_t treeBytes = liveHeapBytes() - heapBefore;
+
+    heapBefore = liveHeapBytes();
+    start = Clock::now();
+    RoaringSet roaring;
+    for (uint32_t id : ids) roaring.insert(id);
+    roaring.runOptimize();
+    double roaringBuildMs = elapsedMs(start);
+    size_t roaringBytes = liveHeapBytes() - heapBefore;
+
+    vector<uint32_t> probes;
+    for (size_t i = 0; i < count; ++i) probes.push_back(rng() % uint32_t(count * 9));
+
+    long long treeHits = 0, roaringHits = 0;
+    start = Clock::now();
+    for (uint32_t probe : probes) treeHits += tree.count(int(probe));
+    double treeLookupNs = elapsedMs(start) * 1e6 / probes.size();
+
+    start = Clock::now();
+    for (uint32_t probe : probes) roaringHits += roaring.contains(probe);
+    double roaringLookupNs = elapsedMs(start) * 1e6 / probes.size();
+
+    bool consistent = treeHits == roaringHits && tree.size() == roaring.cardinality();
+    if (!consistent) cerr << "Mismatch between implementations!" << endl;
+
+    size_t entries = tree.size();
+    cout << "Unique values: " << entries << endl;
+    cout << "Container       build(ms)  contains(ns)  bytes/value" << endl;
+    cout << "std::set<int>   " << treeBuildMs << "  " << treeLookupNs << "  " << double(treeBytes) / entries << endl;
+    cout << "RoaringSet      " << roaringBuildMs << "  " << roaringLookupNs << "  "
+         << double(roaringBytes) / entries << endl;
+    return consistent;
+}
+
+int main(int argc, char* argv[]) {
+    RoaringSet s;
+
+    // Insert elements
+    s.insert(5);
+    s.insert(1);
+    s.insert(3);
+    s.insert(5); // duplicate, will not be added
+    s.insert(70000);           // lands in a second chunk (high bits = 1)
+    for (uint32_t v = 100; v < 200; ++v) s.insert(v);
+    s.runOptimize();           // 100..199 collapses into a single run
+
+    // Iterate and print (ordered)
+    cout << "Set contents (first 6): ";
+    int shown = 0;
+    for (auto it = s.begin(); it != s.end() && shown < 6; ++it, ++shown) cout << *it << " ";
+    cout << endl;
+
+    // Find element
+    uint32_t value = 3;
+    if (s.contains(value)) {
+        cout << value << " found in set" << endl;
+    } else {
+        cout << value << " not found in set" << endl;
+    }
+
+    // Rank and select
+    cout << "rank(150) = " << s.rank(150) << " (values <= 150)" << endl;
+    cout << "select(3) = " << s.select(3) << " (4th smallest value)" << endl;
+
+    // Erase element (also splits the run 100..199)
+    s.erase(1);
+    s.erase(150);
+    cout << "After erasing 1 and 150, contains(150): " << (s.contains(150) ? "yes" : "no")
+         << ", contains(151): " << (s.contains(151) ? "yes" : "no") << endl;
+
+    // Size
+    cout << "Set cardinality: " << s.cardinality() << ", bytes used: " << s.sizeInBytes() << endl;
+
+    // Clear all
+    s.clear();
+    cout << "After clear, set cardinality: " << s.cardinality() << endl;
+
+    // Scattered erases split a run; the chunk turns into a bitmap once its runs outgrow 8 KB
+    RoaringSet range;
+    for (uint32_t v = 0; v < 65536; ++v) range.insert(v);
+    range.runOptimize();
+    for (uint32_t v = 0; v < 65536; v += 2) range.erase(v);
+    cout << "Full chunk with every other value erased: " << range.cardinality() << " values in "
+         << range.sizeInBytes() << " bytes" << endl;
+    if (range.cardinality() != 32768 || range.contains(0) || !range.contains(65535) || range.sizeInBytes() > 9000) {
+        cerr << "Run container did not convert back to a bitmap" << endl;
+        return 1;
+    }
+
+    size_t count = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 5000000;
+    if (!runBenchmark(count)) return 1;
+
+    return 0;
+}
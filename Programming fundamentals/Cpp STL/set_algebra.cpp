@@ -0,0 +1,306 @@
+/*
+ * set_algebra.cpp
+ * Demonstrates fast set algebra (intersection, union, difference) on sorted integer arrays in C++.
+ * Definition: A sorted array with no duplicates has exactly the semantics of std::set<int> for
+ * membership and ordered iteration, but its elements sit next to each other in memory. That lets
+ * set operations stream through memory and compare several elements per instruction.
+ * Shows major operations: conversion from std::set<int>, SIMD (SSE4.1 shuffle-based) intersection,
+ * galloping intersection for skewed sizes, union, difference, a k-way intersection that picks its
+ * strategy from size ratios, and a throughput benchmark against std::set_intersection on std::set.
+ * Run this file independently to see set algebra operations in action.
+ * The SIMD kernel is picked at runtime, so a plain "g++ -O2 set_algebra.cpp" build still uses it
+ * on CPUs that support SSE4.1 and falls back to the scalar merge elsewhere.
+ * Usage: ./set_algebra [elements_per_list]   (default 2000000)
+ */
+#include <iostream>
+#include <set>
+#include <vector>
+#include <algorithm>   // for set_intersection, sort
+#include <iterator>    // for back_inserter
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include <cstdlib>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SET_ALGEBRA_X86 1
+#endif
+using namespace std;
+
+typedef vector<int> SortedSet;   // Sorted ascending, no duplicates (same invariant as std::set<int>)
+
+// When one list is this many times longer than the other, galloping beats a linear merge
+const size_t GALLOP_RATIO = 32;
+
+// Build a sorted array from the set.cpp container
+SortedSet toSortedSet(const set<int>& source) {
+    return SortedSet(source.begin(), source.end());
+}
+
+// -------------------------------------------------
+// 1. INTERSECTION KERNELS
+// -------------------------------------------------
+
+// Scalar merge: one comparison per step, good for small or similar-sized inputs
+size_t intersectScalar(const int* a, size_t na, const int* b, size_t nb, int* out) {
+    size_t i = 0, j = 0, count = 0;
+    while (i < na && j < nb) {
+        if (a[i] < b[j]) {
+            ++i;
+        } else if (b[j] < a[i]) {
+            ++j;
+        } else {
+            out[count++] = a[i];
+            ++i;
+            ++j;
+        }
+    }
+    return count;
+}
+
+// Galloping: for each element of the small list, exponential then binary search in the large list.
+// Cost is O(small * log(large / small)) instead of O(small + large).
+size_t intersectGalloping(const int* small, size_t nSmall, const int* large, size_t nLarge, int* out) {
+    size_t count = 0, low = 0;
+    for (size_t i = 0; i < nSmall && low < nLarge; ++i) {
+        int target = small[i];
+        size_t step = 1, high = low;
+        while (high < nLarge && large[high] < target) {
+            low = high + 1;
+            high += step;
+            step *= 2;
+        }
+        if (high > nLarge) high = nLarge;
+        low = size_t(lower_bound(large + low, large + high, target) - large);
+        if (low < nLarge && large[low] == target) out[count++] = target;
+    }
+    return count;
+}
+
+#ifdef SET_ALGEBRA_X86
+// For each 4-bit match mask, a byte shuffle that packs the matching 32-bit lanes to the front
+struct ShuffleTable {
+    alignas(16) uint8_t masks[16][16];
+
+    ShuffleTable() {
+        for (int mask = 0; mask < 16; ++mask) {
+            int out = 0;
+            for (int lane = 0; lane < 4; ++lane) {
+                if (!(mask & (1 << lane))) continue;
+                for (int byte = 0; byte < 4; ++byte) masks[mask][out * 4 + byte] = uint8_t(lane * 4 + byte);
+                ++out;
+            }
+            for (int byte = out * 4; byte < 16; ++byte) masks[mask][byte] = 0x80;   // Zero the rest
+        }
+    }
+};
+
+const ShuffleTable SHUFFLE_TABLE;
+
+/*
+ * Shuffle-based SIMD intersection (all-pairs 4x4 block compare)
+ * Compares 4 elements of a against 4 elements of b in all 16 combinations using 4 rotations of b,
+ * then packs the matches with one byte shuffle. Whichever block has the smaller maximum advances.
+ * out needs 3 elements of slack: the packed store always writes 4 lanes.
+ */
+__attribute__((target("sse4.1")))
+size_t intersectSimd(const int* a, size_t na, const int* b, size_t nb, int* out) {
+    size_t i = 0, j = 0, count = 0;
+    size_t na4 = na & ~size_t(3), nb4 = nb & ~size_t(3);
+    while (i < na4 && j < nb4) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+        __m128i hits = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi32(va, vb), _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1)))),
+            _mm_or_si128(_mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))),
+                         _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3)))));
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(hits));
+        __m128i packed = _mm_shuffle_epi8(va, _mm_load_si128(reinterpret_cast<const __m128i*>(SHUFFLE_TABLE.masks[mask])));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + count), packed);
+        count += __builtin_popcount(mask);
+
+        int aMax = a[i + 3], bMax = b[j + 3];
+        if (aMax <= bMax) i += 4;
+        if (bMax <= aMax) j += 4;
+    }
+    return count + intersectScalar(a + i, na - i, b + j, nb - j, out + count);
+}
+
+bool cpuHasSse41() {
+    static const bool supported = __builtin_cpu_supports("sse4.1");
+    return supported;
+}
+#endif
+
+// -------------------------------------------------
+// 2. PUBLIC SET OPERATIONS
+// -------------------------------------------------
+
+enum IntersectStrategy { AUTO, SCALAR, SIMD, GALLOPING };
+
+// Intersection of two sorted sets
+// Parameter: strategy - AUTO picks galloping for skewed sizes and SIMD otherwise
+SortedSet intersect(const SortedSet& a, const SortedSet& b, IntersectStrategy strategy = AUTO) {
+    const SortedSet& small = (a.size() <= b.size()) ? a : b;
+    const SortedSet& large = (a.size() <= b.size()) ? b : a;
+    SortedSet result(small.size() + 4);   // +4: slack for the SIMD packed store
+
+    if (strategy == AUTO) {
+        strategy = (small.size() * GALLOP_RATIO < large.size()) ? GALLOPING : SIMD;
+    }
+
+    size_t count = 0;
+    switch (strategy) {
+        case GALLOPING:
+            count = intersectGalloping(small.data(), small.size(), large.data(), large.size(), result.data());
+            break;
+        case SIMD:
+#ifdef SET_ALGEBRA_X86
+            if (cpuHasSse41()) {
+                count = intersectSimd(small.data(), small.size(), large.data(), large.size(), result.data());
+                break;
+            }
+#endif
+            // Fall through to the scalar merge when SIMD is unavailable
+            [[fallthrough]];
+        default:
+            count = intersectScalar(small.data(), small.size(), large.data(), large.size(), result.data());
+            break;
+    }
+    result.resize(count);
+    return result;
+}
+
+// Union of two sorted sets (branch-light merge; each step writes one element)
+SortedSet unite(const SortedSet& a, const SortedSet& b) {
+    SortedSet result(a.size() + b.size());
+    size_t i = 0, j = 0, count = 0;
+    while (i < a.size() && j < b.size()) {
+        int x = a[i], y = b[j];
+        result[count++] = (x < y) ? x : y;
+        i += (x <= y);
+        j += (y <= x);
+    }
+    while (i < a.size()) result[count++] = a[i++];
+    while (j < b.size()) result[count++] = b[j++];
+    result.resize(count);
+    return result;
+}
+
+// Elements of a that are not in b
+SortedSet difference(const SortedSet& a, const SortedSet& b) {
+    SortedSet result(a.size());
+    size_t i = 0, j = 0, count = 0;
+    while (i < a.size()) {
+        while (j < b.size() && b[j] < a[i]) ++j;
+        result[count] = a[i];
+        count += (j == b.size() || b[j] != a[i]);   // Write always, keep only if absent from b
+        ++i;
+    }
+    result.resize(count);
+    return result;
+}
+
+// Intersection of k sorted sets: smallest first, so the running result only shrinks.
+// Each step chooses galloping or SIMD from the size ratio of the running result and the next list.
+SortedSet intersectAll(vector<const SortedSet*> lists) {
+    if (lists.empty()) return SortedSet();
+    sort(lists.begin(), lists.end(), [](const SortedSet* x, const SortedSet* y) { return x->size() < y->size(); });
+    SortedSet result = *lists[0];
+    for (size_t k = 1; k < lists.size() && !result.empty(); ++k) {
+        result = intersect(result, *lists[k], AUTO);
+    }
+    return result;
+}
+
+// -------------------------------------------------
+// 3. BENCHMARK
+// -------------------------------------------------
+
+using Clock = chrono::steady_clock;
+
+SortedSet randomSortedSet(size_t count, int range, mt19937& rng) {
+    set<int> values;
+    while (values.size() < count) values.insert(int(rng() % unsigned(range)));
+    return toSortedSet(values);
+}
+
+// Returns: Input megabytes processed per second
+template <typename Operation>
+double throughputMBs(size_t inputElements, Operation operation, size_t& resultSize) {
+    const int repetitions = 5;
+    auto start = Clock::now();
+    for (int r = 0; r < repetitions; ++r) resultSize = operation();
+    double seconds = chrono::duration<double>(Clock::now() - start).count();
+    return double(inputElements) * sizeof(int) * repetitions / seconds / 1e6;
+}
+
+// Returns: false if the implementations disagree (also reported on cerr)
+bool runBenchmark(size_t count) {
+    cout << "\n=== BENCHMARK: intersection throughput (input MB/s) ===" << endl;
+    mt19937 rng(11);
+    SortedSet a = randomSortedSet(count, int(count * 4), rng);
+    SortedSet b = randomSortedSet(count, int(count * 4), rng);
+    SortedSet tiny = randomSortedSet(count / 1000 + 1, int(count * 4), rng);
+    set<int> treeA(a.begin(), a.end()), treeB(b.begin(), b.end());
+
+    size_t n = 0, expected = 0;
+    double treeRate = throughputMBs(a.size() + b.size(), [&]() {
+        vector<int> out;
+        set_intersection(treeA.begin(), treeA.end(), treeB.begin(), treeB.end(), back_inserter(out));
+        return out.size();
+    }, expected);
+    double scalarRate = throughputMBs(a.size() + b.size(), [&]() { return intersect(a, b, SCALAR).size(); }, n);
+    bool consistent = n == expected;
+    double simdRate = throughputMBs(a.size() + b.size(), [&]() { return intersect(a, b, SIMD).size(); }, n);
+    consistent = consistent && n == expected;
+
+    size_t skewedExpected = 0;
+    double skewedScalar = throughputMBs(tiny.size() + b.size(), [&]() { return intersect(tiny, b, SCALAR).size(); }, skewedExpected);
+    double skewedGallop = throughputMBs(tiny.size() + b.size(), [&]() { return intersect(tiny, b, GALLOPING).size(); }, n);
+    consistent = consistent && n == skewedExpected;
+    if (!consistent) cerr << "Mismatch between implementations!" << endl;
+
+    cout << "Similar sizes (" << a.size() << " x " << b.size() << ", " << expected << " common):" << endl;
+    cout << "  std::set_intersection on std::set: " << treeRate << endl;
+    cout << "  scalar merge on arrays:            " << scalarRate << endl;
+    cout << "  SIMD shuffle intersection:         " << simdRate << endl;
+    cout << "Skewed sizes (" << tiny.size() << " x " << b.size() << "):" << endl;
+    cout << "  scalar merge:                      " << skewedScalar << endl;
+    cout << "  galloping:                         " << skewedGallop << endl;
+    return consistent;
+}
+
+void printSet(const string& label, const SortedSet& values) {
+    cout << label;
+    for (int n : values) cout << n << " ";
+    cout << endl;
+}
+
+int main(int argc, char* argv[]) {
+    // Start from the same container as set.cpp
+    set<int> s1 = {1, 3, 5, 7, 9, 11, 13, 15};
+    set<int> s2 = {3, 4, 5, 6, 7, 13, 20};
+    set<int> s3 = {5, 7, 13, 100};
+
+    SortedSet a = toSortedSet(s1), b = toSortedSet(s2), c = toSortedSet(s3);
+    printSet("A: ", a);
+    printSet("B: ", b);
+    printSet("C: ", c);
+
+    // Set operations
+    printSet("A intersect B (SIMD):      ", intersect(a, b, SIMD));
+    printSet("A intersect B (galloping): ", intersect(a, b, GALLOPING));
+    printSet("A union B:                 ", unite(a, b));
+    printSet("A minus B:                 ", difference(a, b));
+    printSet("A intersect B intersect C: ", intersectAll({&a, &b, &c}));
+
+#ifdef SET_ALGEBRA_X86
+    cout << "SSE4.1 available: " << (cpuHasSse41() ? "yes" : "no (scalar fallback)") << endl;
+#endif
+
+    size_t count = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 2000000;
+    if (!runBenchmark(count)) return 1;
+
+    return 0;
+}
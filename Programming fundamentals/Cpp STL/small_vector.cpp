@@ -0,0 +1,400 @@
+/*
+ * small_vector.cpp
+ * Demonstrates a small vector: a vector with room for N elements inside the object itself.
+ * Definition: A SmallVector<T, N> behaves like std::vector<T>, but the first N elements live in an
+ * inline buffer, so short sequences never touch the heap. Only when it grows beyond N does it spill
+ * to a heap buffer, after which it grows exactly like a normal vector.
+ * Shows major operations: push_back, insert, erase, front, back, access, iterate, search, size,
+ * capacity, clear, move semantics in both the inline and heap states, and a benchmark (allocations
+ * and time) against std::vector for millions of short vectors.
+ * Run this file independently to see small vector operations in action.
+ * Usage: ./small_vector [number_of_vectors]   (default 4000000)
+ */
+#include <iostream>
+#include <vector>
+#include <algorithm>   // for find, move, move_backward, max
+#include <initializer_list>
+#include <memory>      // for uninitialized_copy, uninitialized_move, destroy
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include "heap_accounting.h"   // heapAllocationCount() for the benchmark
+using namespace std;
+
+// -------------------------------------------------
+// 1. SMALL VECTOR
+// -------------------------------------------------
+
+/*
+ * Template class for a vector with an inline buffer
+ *
+ * first points either at inlineBuffer (inline state) or at a heap block (heap state). The
+ * capacity is N while inline. Moving a heap-state vector steals its block; moving an inline-state
+ * vector has to move the elements one by one, because they live inside the source object.
+ *
+ * Template parameter T: The element type
+ * Template parameter N: Number of elements stored without a heap allocation
+ */
+template <typename T, size_t N>
+class SmallVector {
+    static_assert(N > 0, "SmallVector needs at least one inline element");
+
+private:
+    T* first;
+    size_t count;
+    size_t slots;
+    alignas(T) unsigned char inlineBuffer[N * sizeof(T)];
+
+    T* inlineData() { return reinterpret_cast<T*>(inlineBuffer); }
+
+    void releaseHeap() {
+        if (!isInline()) ::operator delete(first);
+    }
+
+    // Move the elements into a heap block of newCapacity slots
+    void grow(size_t newCapacity) {
+        T* block = static_cast<T*>(::operator new(newCapacity * sizeof(T)));
+        uninitialized_move(first, first + count, block);
+        destroy(first, first + count);
+        releaseHeap();
+        first = block;
+        slots = newCapacity;
+    }
+
+    void growForOneMore() {
+        grow(max(slots * 2, count + 1));
+    }
+
+    // Take over other's elements; other must be empty-able afterwards and *this must hold nothing
+    void stealFrom(SmallVector& other) {
+        if (other.isInline()) {
+            first = inlineData();
+            slots = N;
+            uninitialized_move(other.first, other.first + other.count, first);
+            count = other.count;
+            other.clear();
+        } else {
+            first = other.first;
+            count = other.count;
+            slots = other.slots;
+            other.first = other.inlineData();
+            other.count = 0;
+            other.slots = N;
+        }
+    }
+
+public:
+    typedef T value_type;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+
+    SmallVector() : first(inlineData()), count(0), slots(N) {}
+
+    SmallVector(initializer_list<T> values) : SmallVector() {
+        reserve(values.size());
+        uninitialized_copy(values.begin(), values.end(), first);
+        count = values.size();
+    }
+
+    SmallVector(const SmallVector& other) : SmallVector() {
+        reserve(other.count);
+        uninitialized_copy(other.first, other.first + other.count, first);
+        count = other.count;
+    }
+
+    SmallVector(SmallVector&& other) noexcept(is_nothrow_move_constructible<T>::value) {
+        stealFrom(other);
+    }
+
+    SmallVector& operator=(const SmallVector& other) {
+        if (this != &other) {
+            SmallVector copy(other);
+            *this = move(copy);
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other) noexcept(is_nothrow_move_constructible<T>::value) {
+        if (this != &other) {
+            clear();
+            releaseHeap();
+            stealFrom(other);
+        }
+        return *this;
+    }
+
+    ~SmallVector() {
+        destroy(first, first + count);
+        releaseHeap();
+    }
+
+    // True while the elements live inside the object (no heap block owned)
+    bool isInline() const { return first == reinterpret_cast<const T*>(inlineBuffer); }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    size_t capacity() const { return slots; }
+    static constexpr size_t inlineCapacity() { return N; }
+
+    T* data() { return first; }
+    const T* data() const { return first; }
+    iterator begin() { return first; }
+    iterator end() { return first + count; }
+    const_iterator begin() const { return first; }
+    const_iterator end() const { return first + count; }
+
+    T& operator[](size_t i) { return first[i]; }
+    const T& operator[](size_t i) const { return first[i]; }
+
+    // Checked access
+    // Throws: out_of_range if i >= size()
+    T& at(size_t i) {
+        if (i >= count) {
+            throw out_of_range("Index " + to_string(i) + " out of range (size: " + to_string(count) + ")");
+        }
+        return first[i];
+    }
+
+    T& front() { return first[0]; }
+    T& back() { return first[count - 1]; }
+    const T& front() const { return first[0]; }
+    const T& back() const { return first[count - 1]; }
+
+    void reserve(size_t newCapacity) {
+        if (newCapacity > slots) grow(newCapacity);
+    }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (count == slots) {
+            // Build the element first: args may refer to an element that grow() is about to move
+            T value(forward<Args>(args)...);
+            growForOneMore();
+            new (first + count) T(move(value));
+        } else {
+            new (first + count) T(forward<Args>(args)...);
+        }
+        return first[count++];
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(move(value)); }
+
+    void pop_back() {
+        --count;
+        first[count].~T();
+    }
+
+    // Insert value before pos; returns an iterator to the inserted element
+    iterator insert(const_iterator pos, T value) {
+        size_t index = size_t(pos - first);
+        if (count == slots) growForOneMore();
+        if (index == count) {
+            new (first + count) T(move(value));
+        } else {
+            new (first + count) T(move(first[count - 1]));
+            move_backward(first + index, first + count - 1, first + count);
+            first[index] = move(value);
+        }
+        ++count;
+        return first + index;
+    }
+
+    // Erase the element at pos; returns an iterator to the element that followed it
+    iterator erase(const_iterator pos) {
+        return erase(pos, pos + 1);
+    }
+
+    // Erase [from, to); returns an iterator to the element that followed the range
+    iterator erase(const_iterator from, const_iterator to) {
+        T* gapStart = first + (from - first);
+        T* gapEnd = first + (to - first);
+        T* newEnd = move(gapEnd, end(), gapStart);
+        destroy(newEnd, end());
+        count = size_t(newEnd - first);
+        return gapStart;
+    }
+
+    // Destroys the elements; a heap block is kept for reuse (like std::vector)
+    void clear() {
+        destroy(first, first + count);
+        count = 0;
+    }
+};
+
+// -------------------------------------------------
+// 2. BENCHMARK
+// -------------------------------------------------
+
+using Clock = chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start) {
+    return chrono::duration<double, milli>(Clock::now() - start).count();
+}
+
+struct BenchResult {
+    size_t allocations;
+    double milliseconds;
+    long long checksum;
+};
+
+// Build one short vector per length, keep them all (like vector_of_vectors.cpp), then scan them
+template <typename Vec>
+BenchResult buildAndScan(const vector<uint8_t>& lengths) {
+    size_t allocationsBefore = heapAllocationCount();
+    auto start = Clock::now();
+    vector<Vec> rows;
+    rows.reserve(lengths.size());
+    for (size_t r = 0; r < lengths.size(); ++r) {
+        Vec row;
+        for (int i = 0; i < lengths[r]; ++i) row.push_back(int(r) + i);
+        rows.push_back(move(row));
+    }
+    long long checksum = 0;
+    for (const Vec& row : rows) {
+        for (int value : row) checksum += value;
+    }
+    BenchResult result;
+    result.milliseconds = elapsedMs(start);
+    result.allocations = heapAllocationCount() - allocationsBefore;
+    result.checksum = checksum;
+    return result;
+}
+
+// Short-lived temporaries: build, use, and drop a vector per iteration
+template <typename Vec>
+BenchResult temporaries(const vector<uint8_t>& lengths) {
+    size_t allocationsBefore = heapAllocationCount();
+    auto start = Clock::now();
+    long long checksum = 0;
+    for (size_t r = 0; r < lengths.size(); ++r) {
+        Vec row;
+        for (int i = 0; i < lengths[r]; ++i) row.push_back(int(r) ^ i);
+        if (!row.empty()) checksum += row.front() + row.back();
+    }
+    BenchResult result;
+    result.milliseconds = elapsedMs(start);
+    result.allocations = heapAllocationCount() - allocationsBefore;
+    result.checksum = checksum;
+    return result;
+}
+
+void printRow(const char* label, const BenchResult& result) {
+    cout << label << result.allocations << "  " << result.milliseconds << endl;
+}
+
+// Returns: false if the implementations disagree (also reported on cerr)
+bool runBenchmark(size_t vectorCount) {
+    cout << "\n=== BENCHMARK: " << vectorCount << " short vectors ===" << endl;
+    mt19937 rng(36);
+    vector<uint8_t> shortLengths(vectorCount), mixedLengths(vectorCount);
+    for (size_t i = 0; i < vectorCount; ++i) {
+        shortLengths[i] = uint8_t(rng() % 8);                        // 0-7: always inline
+        mixedLengths[i] = uint8_t((rng() % 10 == 0) ? 8 + rng() % 24 : rng() % 8);  // 10% spill
+    }
+
+    BenchResult a = buildAndScan<vector<int>>(shortLengths);
+    BenchResult b = buildAndScan<SmallVector<int, 8>>(shortLengths);
+    BenchResult c = temporaries<vector<int>>(shortLengths);
+    BenchResult d = temporaries<SmallVector<int, 8>>(shortLengths);
+    BenchResult e = temporaries<vector<int>>(mixedLengths);
+    BenchResult f = temporaries<SmallVector<int, 8>>(mixedLengths);
+    bool consistent = a.checksum == b.checksum && c.checksum == d.checksum && e.checksum == f.checksum;
+    if (!consistent) cerr << "Mismatch between implementations!" << endl;
+
+    cout << "Workload                               allocations  time(ms)" << endl;
+    printRow("keep all, 0-7 elems, vector<int>      ", a);
+    printRow("keep all, 0-7 elems, SmallVector<8>   ", b);
+    printRow("temporaries, 0-7, vector<int>         ", c);
+    printRow("temporaries, 0-7, SmallVector<8>      ", d);
+    printRow("temporaries, 10% spill, vector<int>   ", e);
+    printRow("temporaries, 10% spill, SmallVector<8> ", f);
+    return consistent;
+}
+
+int main(int argc, char* argv[]) {
+    SmallVector<int, 8> numbers;
+
+    // Insert elements
+    numbers.push_back(10);
+    numbers.push_back(20);
+    numbers.push_back(30);
+    numbers.push_back(40);
+    cout << "After push_back: ";
+    for (int n : numbers) cout << n << " ";
+    cout << "(inline: " << (numbers.isInline() ? "yes" : "no") << ")" << endl;
+
+    // Access elements
+    cout << "Element at index 2: " << numbers[2] << endl;
+    cout << "First element: " << numbers.front() << endl;
+    cout << "Last element: " << numbers.back() << endl;
+
+    // Insert at specific position
+    numbers.insert(numbers.begin() + 1, 15);
+    cout << "After insert at index 1: ";
+    for (int n : numbers) cout << n << " ";
+    cout << endl;
+
+    // Erase element at index 2
+    numbers.erase(numbers.begin() + 2);
+    cout << "After erase at index 2: ";
+    for (int n : numbers) cout << n << " ";
+    cout << endl;
+
+    // Iterate using iterator
+    cout << "Iterate using iterator: ";
+    for (auto it = numbers.begin(); it != numbers.end(); ++it) {
+        cout << *it << " ";
+    }
+    cout << endl;
+
+    // Search for an element
+    int value = 20;
+    auto found = find(numbers.begin(), numbers.end(), value);
+    if (found != numbers.end()) {
+        cout << value << " found at index " << (found - numbers.begin()) << endl;
+    } else {
+        cout << value << " not found" << endl;
+    }
+
+    // Size and capacity
+    cout << "Size: " << numbers.size() << endl;
+    cout << "Capacity: " << numbers.capacity() << endl;
+
+    // Grow past the inline buffer: spills to the heap
+    for (int i = 0; i < 6; ++i) numbers.push_back(100 + i);
+    cout << "After 6 more push_backs, size: " << numbers.size() << ", capacity: " << numbers.capacity()
+         << ", inline: " << (numbers.isInline() ? "yes" : "no") << endl;
+
+    // Move semantics: heap state steals the block, inline state moves elements
+    SmallVector<int, 8> heapMoved = move(numbers);
+    cout << "Moved heap vector, size: " << heapMoved.size() << ", source size: " << numbers.size()
+         << ", source inline: " << (numbers.isInline() ? "yes" : "no") << endl;
+
+    SmallVector<string, 4> words = {"alpha", "beta", "gamma"};
+    SmallVector<string, 4> wordsMoved = move(words);
+    cout << "Moved inline vector: ";
+    for (const string& w : wordsMoved) cout << w << " ";
+    cout << "(source size: " << words.size() << ")" << endl;
+
+    // Checked access
+    try {
+        heapMoved.at(100);
+    } catch (const out_of_range& e) {
+        cout << "Caught expected error: " << e.what() << endl;
+    }
+
+    // Clear all elements
+    heapMoved.clear();
+    cout << "After clear, size: " << heapMoved.size() << endl;
+
+    size_t vectorCount = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 4000000;
+    if (!runBenchmark(vectorCount)) return 1;
+
+    return 0;
+}
@@ -0,0 +1,428 @@
+/*
+ * snapshot.cpp
+ * Demonstrates a memory-mappable binary snapshot format for map<string, int> and set<int> contents.
+ * Definition: A snapshot is a read-only file laid out exactly like the in-memory lookup structure
+ * (sorted offsets, a string heap, a value array). Opening it is a single mmap call; nothing is parsed
+ * or re-inserted, and pages are only read from disk when a lookup first touches them.
+ * Shows major operations: write a snapshot from std::map / std::set, open it with mmap, validate the
+ * header (magic, version, bounds), verify the checksum, find, contains, iterate, and a startup-time
+ * benchmark against rebuilding std::map from a text file.
+ * Run this file independently to see snapshot operations in action (Linux/POSIX: uses mmap).
+ * Usage: ./snapshot [number_of_entries]   (default 1000000)
+ */
+#include <iostream>
+#include <fstream>
+#include <map>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <algorithm>   // for lower_bound
+#include <chrono>
+#include <cstdint>
+#include <cstdio>      // for remove
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>     // for open
+#include <sys/mman.h>  // for mmap, munmap
+#include <sys/stat.h>  // for fstat
+#include <unistd.h>    // for close
+using namespace std;
+
+// -------------------------------------------------
+// 1. FILE FORMAT
+// -------------------------------------------------
+
+/*
+ * Layout (integers in the writing host's byte order, every section 8-byte aligned):
+ *
+ *   SnapshotHeader
+ *   MAP: uint64 keyOffsets[count + 1]  -> byte ranges inside the string heap, keys sorted
+ *        int32  values[count]          -> values[i] belongs to key i
+ *        char   heap[heapBytes]        -> all keys back to back
+ *   SET: int32  elements[count]        -> sorted, unique
+ *
+ * The checksum (FNV-1a over everything after the header) detects truncated or corrupted files.
+ * The views read the integers in place, so a file only opens on a host with the byte order it was
+ * written with; the version field tells the two apart and a mismatch is rejected.
+ */
+const char SNAPSHOT_MAGIC[8] = {'D', 'S', 'S', 'N', 'A', 'P', '\0', '\0'};
+const uint32_t SNAPSHOT_VERSION = 1;
+
+enum SnapshotKind : uint32_t {
+    SNAPSHOT_STRING_INT_MAP = 1,
+    SNAPSHOT_INT_SET = 2
+};
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t kind;
+    uint64_t count;
+    uint64_t heapBytes;      // Size of the string heap (0 for sets)
+    uint64_t payloadBytes;   // Bytes following the header
+    uint64_t checksum;       // FNV-1a of the payload
+};
+
+static_assert(sizeof(SnapshotHeader) == 48, "Header layout must not depend on the compiler");
+
+uint64_t fnv1a(const char* data, size_t length, uint64_t h = 14695981039346656037ULL) {
+    for (size_t i = 0; i < length; ++i) {
+        h ^= static_cast<unsigned char>(data[i]);
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+size_t alignTo8(size_t bytes) {
+    return (bytes + 7) & ~size_t(7);
+}
+
+// -------------------------------------------------
+// 2. WRITERS
+// -------------------------------------------------
+
+void writeSnapshotFile(const string& path, SnapshotHeader header, const string& payload) {
+    header.payloadBytes = payload.size();
+    header.checksum = fnv1a(payload.data(), payload.size());
+
+    ofstream out(path, ios::binary | ios::trunc);
+    if (!out) throw runtime_error("Cannot create snapshot: " + path);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(payload.data(), payload.size());
+    if (!out) throw runtime_error("Failed writing snapshot: " + path);
+}
+
+SnapshotHeader makeHeader(SnapshotKind kind, uint64_t count) {
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.kind = kind;
+    header.count = count;
+    return header;
+}
+
+// Write the contents of a map<string, int> (already sorted by key)
+void writeMapSnapshot(const string& path, const map<string, int>& source) {
+    vector<uint64_t> offsets;
+    vector<int32_t> values;
+    string heap;
+    offsets.reserve(source.size() + 1);
+    values.reserve(source.size());
+    for (const auto& entry : source) {
+        offsets.push_back(heap.size());
+        heap += entry.first;
+        values.push_back(entry.second);
+    }
+    offsets.push_back(heap.size());
+
+    string payload;
+    payload.append(reinterpret_cast<const char*>(offsets.data()), offsets.size() * sizeof(uint64_t));
+    payload.append(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(int32_t));
+    payload.resize(alignTo8(payload.size()), '\0');
+    payload += heap;
+
+    SnapshotHeader header = makeHeader(SNAPSHOT_STRING_INT_MAP, source.size());
+    header.heapBytes = heap.size();
+    writeSnapshotFile(path, header, payload);
+}
+
+// Write the contents of a set<int> (already sorted)
+void writeSetSnapshot(const string& path, const set<int>& source) {
+    vector<int32_t> elements(source.begin(), source.end());
+    string payload(reinterpret_cast<const char*>(elements.data()), elements.size() * sizeof(int32_t));
+    writeSnapshotFile(path, makeHeader(SNAPSHOT_INT_SET, source.size()), payload);
+}
+
+// -------------------------------------------------
+// 3. MEMORY-MAPPED READERS
+// -------------------------------------------------
+
+/*
+ * RAII owner of a read-only memory mapping
+ * Opening costs one open + fstat + mmap regardless of file size.
+ */
+class MappedFile {
+private:
+    const char* base;
+    size_t length;
+
+public:
+    explicit MappedFile(const string& path) : base(nullptr), length(0) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw runtime_error("Cannot open snapshot: " + path);
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            close(fd);
+            throw runtime_error("Cannot stat snapshot: " + path);
+        }
+        length = size_t(info.st_size);
+        void* mapped = length ? mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+        close(fd);   // The mapping stays valid after the descriptor is closed
+        if (mapped == MAP_FAILED) throw runtime_error("Cannot mmap snapshot: " + path);
+        base = static_cast<const char*>(mapped);
+    }
+
+    ~MappedFile() {
+        if (base) munmap(const_cast<char*>(base), length);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return base; }
+    size_t size() const { return length; }
+};
+
+/*
+ * Common header validation for both snapshot kinds
+ * Opening only checks that every section lies inside the mapping (O(1), no payload pages read).
+ * Key offsets are checked as lookups read them, so a corrupt file is rejected instead of read out
+ * of bounds; full O(n) scans are available through validate() and verifyChecksum().
+ */
+class SnapshotView {
+protected:
+    MappedFile file;
+    const SnapshotHeader* header;
+
+    const char* payload() const { return file.data() + sizeof(SnapshotHeader); }
+
+    SnapshotView(const string& path, SnapshotKind expectedKind) : file(path), header(nullptr) {
+        if (file.size() < sizeof(SnapshotHeader)) throw runtime_error("Snapshot too small: " + path);
+        header = reinterpret_cast<const SnapshotHeader*>(file.data());
+        if (memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0) {
+            throw runtime_error("Not a snapshot file: " + path);
+        }
+        if (header->version == __builtin_bswap32(SNAPSHOT_VERSION)) {
+            throw runtime_error("Snapshot was written on a host with the other byte order: " + path);
+        }
+        if (header->version != SNAPSHOT_VERSION) {
+            throw runtime_error("Unsupported snapshot version " + to_string(header->version));
+        }
+        if (header->kind != expectedKind) throw runtime_error("Snapshot holds a different container kind");
+        if (header->payloadBytes != file.size() - sizeof(SnapshotHeader)) {
+            throw runtime_error("Snapshot is truncated: " + path);
+        }
+    }
+
+public:
+    // Full integrity check (reads every page of the file)
+    // Returns: true if the payload matches the stored checksum
+    bool verifyChecksum() const {
+        return fnv1a(payload(), header->payloadBytes) == header->checksum;
+    }
+
+    size_t size() const { return size_t(header->count); }
+};
+
+// Read-only, in-place view of a map<string, int> snapshot
+class MapSnapshotView : public SnapshotView {
+private:
+    const uint64_t* offsets;
+    const int32_t* values;
+    const char* heap;
+
+public:
+    // Throws: runtime_error if the sections do not fit the file
+    explicit MapSnapshotView(const string& path) : SnapshotView(path, SNAPSHOT_STRING_INT_MAP) {
+        uint64_t count = header->count;
+        uint64_t payloadBytes = header->payloadBytes;
+        // Every entry needs at least an offset and a value; checking this first keeps the sizes below from overflowing
+        if (payloadBytes < sizeof(uint64_t) || count > (payloadBytes - sizeof(uint64_t)) / (sizeof(uint64_t) + sizeof(int32_t))) {
+            throw runtime_error("Snapshot entry count does not fit the file");
+        }
+        size_t heapStart = alignTo8((count + 1) * sizeof(uint64_t) + count * sizeof(int32_t));
+        if (heapStart > payloadBytes || header->heapBytes != payloadBytes - heapStart) {
+            throw runtime_error("Snapshot section sizes are inconsistent");
+        }
+        offsets = reinterpret_cast<const uint64_t*>(payload());
+        values = reinterpret_cast<const int32_t*>(payload() + (count + 1) * sizeof(uint64_t));
+        heap = payload() + heapStart;
+    }
+
+    // Offsets must never decrease and stay within the heap: only the entries touched are checked
+    // Throws: runtime_error if the key's offsets point outside the heap
+    string_view keyAt(size_t index) const {
+        uint64_t begin = offsets[index], end = offsets[index + 1];
+        if (begin > end || end > header->heapBytes) throw runtime_error("Snapshot key offsets are out of bounds");
+        return string_view(heap + begin, end - begin);
+    }
+
+    // Full offset check (reads the whole offset section)
+    // Returns: true if the offsets start at 0, never decrease and end at the heap size
+    bool validate() const {
+        if (offsets[0] != 0 || offsets[size()] != header->heapBytes) return false;
+        for (size_t i = 0; i < size(); ++i) {
+            if (offsets[i] > offsets[i + 1]) return false;
+        }
+        return true;
+    }
+
+    int valueAt(size_t index) const { return values[index]; }
+
+    // Binary search over the sorted keys; only the pages that are touched get loaded
+    // Returns: pointer to the value inside the mapping, or nullptr if the key is absent
+    // Throws: runtime_error if a probed key's offsets are corrupt
+    const int32_t* find(string_view key) const {
+        size_t low = 0, high = size();
+        while (low < high) {
+            size_t mid = low + (high - low) / 2;
+            if (keyAt(mid) < key) low = mid + 1;
+            else high = mid;
+        }
+        if (low < size() && keyAt(low) == key) return &values[low];
+        return nullptr;
+    }
+};
+
+// Read-only, in-place view of a set<int> snapshot
+class SetSnapshotView : public SnapshotView {
+private:
+    const int32_t* elements;
+
+public:
+    explicit SetSnapshotView(const string& path) : SnapshotView(path, SNAPSHOT_INT_SET) {
+        if (header->count > header->payloadBytes / sizeof(int32_t) ||
+            header->count * sizeof(int32_t) != header->payloadBytes) {
+            throw runtime_error("Snapshot section sizes are inconsistent");
+        }
+        elements = reinterpret_cast<const int32_t*>(payload());
+    }
+
+    const int32_t* begin() const { return elements; }
+    const int32_t* end() const { return elements + size(); }
+
+    bool contains(int value) const {
+        return binary_search(begin(), end(), value);
+    }
+};
+
+// -------------------------------------------------
+// 4. STARTUP BENCHMARK
+// -------------------------------------------------
+
+using Clock = chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start) {
+    return chrono::duration<double, milli>(Clock::now() - start).count();
+}
+
+void runBenchmark(size_t count) {
+    cout << "\n=== BENCHMARK: startup with " << count << " entries ===" << endl;
+    const string textPath = "snapshot_bench.txt";
+    const string snapshotPath = "snapshot_bench.snap";
+
+    {
+        ofstream text(textPath);
+        for (size_t i = 0; i < count; ++i) text << "person_" << (i * 2654435761u) % 1000000007u << " " << (i % 100) << "\n";
+    }
+
+    // Old startup: parse text and insert into std::map
+    auto start = Clock::now();
+    map<string, int> rebuilt;
+    {
+        ifstream text(textPath);
+        string name;
+        int value;
+        while (text >> name >> value) rebuilt[name] = value;
+    }
+    double rebuildMs = elapsedMs(start);
+
+    writeMapSnapshot(snapshotPath, rebuilt);
+
+    // New startup: mmap the snapshot
+    start = Clock::now();
+    MapSnapshotView view(snapshotPath);
+    double openMs = elapsedMs(start);
+
+    start = Clock::now();
+    bool intact = view.verifyChecksum() && view.validate();
+    double verifyMs = elapsedMs(start);
+
+    // Cold-ish lookups straight after opening
+    long long hits = 0;
+    start = Clock::now();
+    for (size_t i = 0; i < 100000; ++i) {
+        hits += view.find("person_" + to_string((i * 7 * 2654435761u) % 1000000007u)) != nullptr;
+    }
+    double lookupNs = elapsedMs(start) * 1e6 / 100000;
+
+    cout << "Rebuild std::map from text: " << rebuildMs << " ms" << endl;
+    cout << "mmap snapshot open:         " << openMs << " ms" << endl;
+    cout << "Optional full validation:   " << verifyMs << " ms (" << (intact ? "ok" : "CORRUPT") << ")" << endl;
+    cout << "Lookup in mapped snapshot:  " << lookupNs << " ns (hits: " << hits << ")" << endl;
+
+    remove(textPath.c_str());
+    remove(snapshotPath.c_str());
+}
+
+int main(int argc, char* argv[]) {
+    const string mapPath = "ages.snap";
+    const string setPath = "numbers.snap";
+
+    try {
+        // Build the containers the usual way, then save them once
+        map<string, int> age = {{"Alice", 25}, {"Bob", 30}, {"Charlie", 22}};
+        set<int> s = {5, 1, 3};
+        writeMapSnapshot(mapPath, age);
+        writeSetSnapshot(setPath, s);
+        cout << "Snapshots written: " << mapPath << ", " << setPath << endl;
+
+        // Open in place: no parsing, no insertion
+        MapSnapshotView ages(mapPath);
+        SetSnapshotView numbers(setPath);
+        cout << "Checksums valid: " << (ages.verifyChecksum() && numbers.verifyChecksum() ? "yes" : "no") << endl;
+
+        // Iterate and print
+        cout << "All ages:" << endl;
+        for (size_t i = 0; i < ages.size(); ++i) {
+            cout << ages.keyAt(i) << ": " << ages.valueAt(i) << endl;
+        }
+        cout << "Set contents: ";
+        for (int n : numbers) cout << n << " ";
+        cout << endl;
+
+        // Find elements
+        const int32_t* bob = ages.find("Bob");
+        cout << "Bob " << (bob ? "found, age = " + to_string(*bob) : "not found") << endl;
+        cout << "3 " << (numbers.contains(3) ? "found" : "not found") << " in set" << endl;
+
+        // Size
+        cout << "Map size: " << ages.size() << ", set size: " << numbers.size() << endl;
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << endl;
+        return 1;
+    }
+
+    // Opening a file of the wrong kind is rejected by the header check
+    try {
+        MapSnapshotView wrongKind(setPath);
+    } catch (const runtime_error& e) {
+        cout << "Caught expected error: " << e.what() << endl;
+    }
+
+    // A corrupted key offset is caught by validate() and by the first lookup that reads it
+    {
+        fstream corrupt(mapPath, ios::in | ios::out | ios::binary);
+        uint64_t badOffset = ~uint64_t(0) >> 1;
+        corrupt.seekp(sizeof(SnapshotHeader) + sizeof(uint64_t));
+        corrupt.write(reinterpret_cast<const char*>(&badOffset), sizeof(badOffset));
+    }
+    try {
+        MapSnapshotView corrupted(mapPath);
+        cout << "Corrupted snapshot offsets valid: " << (corrupted.validate() ? "yes" : "no") << endl;
+        corrupted.find("Bob");
+    } catch (const runtime_error& e) {
+        cout << "Caught expected error: " << e.what() << endl;
+    }
+
+    remove(mapPath.c_str());
+    remove(setPath.c_str());
+
+    size_t count = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 1000000;
+    runBenchmark(count);
+
+    return 0;
+}
@@ -0,0 +1,244 @@
+/*
+ * File: array_operations.h
+ * Template-based array operations: traversal, insertion, and deletion
+ * Author: Gaurav
+ * Date: 2025
+ * 
+ * Header-only so the class can be shared: array_operations.cpp holds the demonstrations,
+ * and any other program can include this file (CMake target: containers).
+ */
+
+#ifndef ARRAY_OPERATIONS_H
+#define ARRAY_OPERATIONS_H
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "container_tracing.h"
+
+/*
+ * Template class for array operations
+ * 
+ * This class provides basic array operations including traversal,
+ * insertion, and deletion with proper error handling.
+ * 
+ * Template parameter T: The data type for array elements
+ * Template parameter Tracer: NoTracing (default, no cost) or OperationTracing, see container_tracing.h
+ */
+template <typename T, typename Tracer = NoTracing>
+class ArrayOperations {
+public:
+    // Constants for better maintainability (class-scoped so other containers can reuse the names)
+    static constexpr int MAX_ARRAY_SIZE = 50;
+    static constexpr int INVALID_INDEX = -1;
+
+private:
+    T data[MAX_ARRAY_SIZE];    // Array to store elements
+    int size;                  // Current number of elements
+    [[no_unique_address]] mutable typename Tracer::Recorder recorder;   // empty unless tracing
+    
+public:
+    // Constructor to initialize the array
+    ArrayOperations() : size(0) {
+        // Initialize all elements to default value for type T
+        for (int i = 0; i < MAX_ARRAY_SIZE; ++i) {
+            data[i] = T();
+        }
+    }
+    
+    // Get the current size of the array
+    // Returns: Number of elements currently in the array
+    int getSize() const {
+        return size;
+    }
+    
+    // Check if the array is empty
+    // Returns: true if array is empty, false otherwise
+    bool isEmpty() const {
+        return size == 0;
+    }
+    
+    // Check if the array is full
+    // Returns: true if array is full, false otherwise
+    bool isFull() const {
+        return size == MAX_ARRAY_SIZE;
+    }
+    
+    // Direct access to the stored elements [begin(), end()), e.g. to sort them in place
+    T* begin() { return data; }
+    T* end() { return data + size; }
+    const T* begin() const { return data; }
+    const T* end() const { return data + size; }
+    
+    // Validate if an index is within bounds
+    // Parameter: index - The index to validate
+    // Returns: true if index is valid, false otherwise
+    bool isValidIndex(int index) const {
+        return index >= 0 && index < size;
+    }
+    
+    // TRAVERSAL: Display all elements in the array
+    void traverse() const {
+        if (isEmpty()) {
+            std::cout << "Array is empty - nothing to traverse" << std::endl;
+            return;
+        }
+        
+        std::cout << "Array traversal (forward): ";
+        for (int i = 0; i < size; ++i) {
+            std::cout << data[i];
+            if (i < size - 1) std::cout << " -> ";
+        }
+        std::cout << std::endl;
+    }
+    
+    // TRAVERSAL: Display elements in reverse order
+    void traverseReverse() const {
+        if (isEmpty()) {
+            std::cout << "Array is empty - nothing to traverse" << std::endl;
+            return;
+        }
+        
+        std::cout << "Array traversal (reverse): ";
+        for (int i = size - 1; i >= 0; --i) {
+            std::cout << data[i];
+            if (i > 0) std::cout << " -> ";
+        }
+        std::cout << std::endl;
+    }
+    
+    // TRAVERSAL: Find and display element at specific index
+    // Parameter: index - The index to access
+    void traverseAtIndex(int index) const {
+        if (!isValidIndex(index)) {
+            std::cout << "Invalid index: " << index << " (valid range: 0 to " << size - 1 << ")" << std::endl;
+            return;
+        }
+        
+        std::cout << "Element at index " << index << ": " << data[index] << std::endl;
+    }
+    
+    // INSERTION: Add element at the end of array
+    // Parameter: value - The value to insert
+    // Throws: std::overflow_error if array is full
+    void insertAtEnd(T value) {
+        if (isFull()) {
+            throw std::overflow_error("Array is full - cannot insert more elements");
+        }
+        
+        auto trace = recorder.begin(TraceOp::ARRAY_INSERT_END);
+        data[size] = value;
+        size++;
+        std::cout << "Inserted " << value << " at the end (index " << size - 1 << ")" << std::endl;
+        recorder.end(TraceOp::ARRAY_INSERT_END, trace, 0);
+    }
+    
+    // INSERTION: Add element at specific position
+    // Parameter: value - The value to insert
+    // Parameter: position - The position where to insert (0-based index)
+    // Throws: std::overflow_error if array is full
+    // Throws: std::invalid_argument if position is invalid
+    void insertAtPosition(T value, int position) {
+        if (isFull()) {
+            throw std::overflow_error("Array is full - cannot insert more elements");
+        }
+        
+        if (position < 0 || position > size) {
+            throw std::invalid_argument("Invalid position: " + std::to_string(position) + 
+                                 " (valid range: 0 to " + std::to_string(size) + ")");
+        }
+        
+        auto trace = recorder.begin(TraceOp::ARRAY_INSERT_POSITION);
+        
+        // Shift elements to make room for new element
+        for (int i = size; i > position; --i) {
+            data[i] = data[i - 1];
+        }
+        
+        data[position] = value;
+        size++;
+        std::cout << "Inserted " << value << " at position " << position << std::endl;
+        recorder.end(TraceOp::ARRAY_INSERT_POSITION, trace, std::uint64_t(size - 1 - position));
+    }
+    
+    // INSERTION: Add element at the beginning
+    // Parameter: value - The value to insert
+    void insertAtBeginning(T value) {
+        insertAtPosition(value, 0);
+    }
+    
+    // DELETION: Remove element from the end
+    // Returns: The removed element
+    // Throws: std::underflow_error if array is empty
+    T deleteFromEnd() {
+        if (isEmpty()) {
+            throw std::underflow_error("Array is empty - cannot delete elements");
+        }
+        
+        auto trace = recorder.begin(TraceOp::ARRAY_DELETE_END);
+        T removedElement = data[size - 1];
+        size--;
+        std::cout << "Deleted " << removedElement << " from the end" << std::endl;
+        recorder.end(TraceOp::ARRAY_DELETE_END, trace, 0);
+        return removedElement;
+    }
+    
+    // DELETION: Remove element from specific position
+    // Parameter: position - The position to delete from (0-based index)
+    // Returns: The removed element
+    // Throws: std::underflow_error if array is empty
+    // Throws: std::invalid_argument if position is invalid
+    T deleteFromPosition(int position) {
+        if (isEmpty()) {
+            throw std::underflow_error("Array is empty - cannot delete elements");
+        }
+        
+        if (!isValidIndex(position)) {
+            throw std::invalid_argument("Invalid position: " + std::to_string(position) + 
+                                 " (valid range: 0 to " + std::to_string(size - 1) + ")");
+        }
+        
+        auto trace = recorder.begin(TraceOp::ARRAY_DELETE_POSITION);
+        T removedElement = data[position];
+        
+        // Shift elements to fill the gap
+        for (int i = position; i < size - 1; ++i) {
+            data[i] = data[i + 1];
+        }
+        
+        size--;
+        std::cout << "Deleted " << removedElement << " from position " << position << std::endl;
+        recorder.end(TraceOp::ARRAY_DELETE_POSITION, trace, std::uint64_t(size - position));
+        return removedElement;
+    }
+    
+    // DELETION: Remove element from the beginning
+    // Returns: The removed element
+    T deleteFromBeginning() {
+        return deleteFromPosition(0);
+    }
+    
+    // Display current array state
+    void displayArray() const {
+        std::cout << "\n--- Current Array State ---" << std::endl;
+        std::cout << "Size: " << size << "/" << MAX_ARRAY_SIZE << std::endl;
+        std::cout << "Empty: " << (isEmpty() ? "Yes" : "No") << std::endl;
+        std::cout << "Full: " << (isFull() ? "Yes" : "No") << std::endl;
+        
+        if (!isEmpty()) {
+            std::cout << "Elements: ";
+            for (int i = 0; i < size; ++i) {
+                std::cout << "[" << i << ":" << data[i] << "]";
+                if (i < size - 1) std::cout << " ";
+            }
+            std::cout << std::endl;
+        }
+        std::cout << "------------------------" << std::endl;
+    }
+};
+
+// ArrayOperations that records counts, shifts and latencies (container_tracing.h)
+template <typename T>
+using TracedArrayOperations = ArrayOperations<T, OperationTracing>;
+
+#endif // ARRAY_OPERATIONS_H
@@ -0,0 +1,266 @@
+/*
+ * File: container_tracing.cpp
+ * Operation tracing for ArrayOperations and Stack (container_tracing.h)
+ * Author: Gaurav
+ * Date: 2025
+ *
+ * This file demonstrates:
+ * 1. Turning tracing on for one container type: TracedArrayOperations<int>, TracedStack<int>
+ * 2. Reading a snapshot: operation counts, shifted elements, latency percentiles
+ * 3. A TraceDumper rewriting a report file while threads keep working
+ * 4. The cost of tracing: plain vs traced (switched on) vs traced (switched off), same checksum
+ *
+ * Run this file independently to see the tracing layer in action.
+ * Usage: ./container_tracing [operations per thread] [trace_file] [threads]
+ *        (defaults: 20000000, container_trace.txt, all hardware threads)
+ * Set CONTAINER_TRACE=<file>[,<interval ms>] to also dump the report while it runs.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <memory>
+#include "array_operations.h"
+#include "template_stack.h"
+
+using namespace std;
+
+using Clock = chrono::steady_clock;
+
+// The default policy adds nothing to the containers
+static_assert(sizeof(Stack<int>) == sizeof(int) * (Stack<int>::MAX_ARRAY_SIZE + 1), "NoTracing must be free");
+static_assert(sizeof(ArrayOperations<int>) == sizeof(int) * (ArrayOperations<int>::MAX_ARRAY_SIZE + 1), "NoTracing must be free");
+
+double elapsedSeconds(Clock::time_point start) {
+    return chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Small fast generator so the workload, not the random numbers, dominates the timing
+struct XorShift {
+    uint64_t state;
+    uint64_t next() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+};
+
+// -------------------------------------------------
+// 1. WORKLOADS (identical for every tracing policy)
+// -------------------------------------------------
+
+// Random pushes, pops and peeks on one stack
+// Returns: checksum of every value read back
+template <typename Tracer>
+uint64_t stackWorkload(uint64_t operations, uint64_t seed) {
+    Stack<int, Tracer> stack;
+    XorShift rng{seed};
+    uint64_t checksum = 0;
+    for (uint64_t i = 0; i < operations; ++i) {
+        uint64_t r = rng.next();
+        switch (r % 4) {
+            case 0:
+            case 1:
+                if (!stack.isFull()) stack.push(int(r >> 32));
+                else checksum += uint64_t(stack.pop());
+                break;
+            case 2:
+                if (!stack.isEmpty()) checksum += uint64_t(stack.pop());
+                break;
+            default:
+                if (!stack.isEmpty()) checksum ^= uint64_t(stack.peek()) << 1;
+                break;
+        }
+    }
+    return checksum;
+}
+
+// Inserts and deletes at random positions (the shifting operations) on one array
+// Returns: checksum of every deleted value
+template <typename Tracer>
+uint64_t arrayWorkload(uint64_t operations, uint64_t seed) {
+    ArrayOperations<int, Tracer> array;
+    XorShift rng{seed};
+    uint64_t checksum = 0;
+    for (uint64_t i = 0; i < operations; ++i) {
+        uint64_t r = rng.next();
+        int size = array.getSize();
+        bool insert = !array.isFull() && (array.isEmpty() || (r & 1) == 0);
+        if (insert) {
+            if ((r & 6) == 0) array.insertAtEnd(int(r >> 40));
+            else array.insertAtPosition(int(r >> 40), int((r >> 8) % uint64_t(size + 1)));
+        } else {
+            if ((r & 6) == 0) checksum += uint64_t(array.deleteFromEnd());
+            else checksum += uint64_t(array.deleteFromPosition(int((r >> 8) % uint64_t(size))));
+        }
+    }
+    return checksum;
+}
+
+// Runs work(threadIndex) on every thread
+// Returns: wall seconds and the sum of the per-thread checksums
+template <typename Work>
+pair<double, uint64_t> runThreads(unsigned threads, Work work) {
+    vector<uint64_t> checksums(threads);
+    vector<thread> workers;
+    auto start = Clock::now();
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] { checksums[t] = work(t); });
+    }
+    for (thread& worker : workers) worker.join();
+    double seconds = elapsedSeconds(start);
+    uint64_t total = 0;
+    for (uint64_t checksum : checksums) total += checksum;
+    return {seconds, total};
+}
+
+// -------------------------------------------------
+// 2. DEMONSTRATION
+// -------------------------------------------------
+
+void demonstrateSnapshot() {
+    cout << "=== Traced containers ===" << endl;
+    setTraceSamplePeriod(1);   // time every operation for the small demo
+
+    TracedArrayOperations<int> array;
+    array.insertAtEnd(10);
+    array.insertAtEnd(20);
+    array.insertAtEnd(30);
+    array.insertAtBeginning(5);     // shifts 3 elements
+    array.insertAtPosition(15, 2);  // shifts 2 elements
+    array.deleteFromPosition(1);    // shifts 3 elements
+    array.deleteFromEnd();
+
+    TracedStack<char> stack;
+    for (char c : string("trace")) stack.push(c);
+    cout << "Stack peek: " << stack.peek() << ", pop: " << stack.pop() << endl;
+    try {
+        Stack<char, OperationTracing> empty;
+        empty.pop();
+    } catch (const underflow_error& e) {
+        cout << "Caught expected error (not counted): " << e.what() << endl;
+    }
+
+    TraceSnapshot snapshot = traceSnapshot();
+    cout << "\nSnapshot: insertAtPosition ran " << snapshot[TraceOp::ARRAY_INSERT_POSITION].count
+         << " times and shifted " << snapshot[TraceOp::ARRAY_INSERT_POSITION].shifted << " elements" << endl;
+    writeTraceReport(cout, snapshot);
+
+    try {
+        setTraceSamplePeriod(0);
+    } catch (const invalid_argument& e) {
+        cout << "Caught expected error: " << e.what() << endl;
+    }
+    setTraceSamplePeriod(256);
+}
+
+// -------------------------------------------------
+// 3. OVERHEAD BENCHMARK
+// -------------------------------------------------
+
+// Best of REPETITIONS runs, with the three policies interleaved so they see the same machine noise
+constexpr int REPETITIONS = 5;
+
+struct PolicyTiming {
+    const char* name;
+    double stackSeconds = 1e300;
+    double arraySeconds = 1e300;
+    uint64_t stackChecksum = 0;
+    uint64_t arrayChecksum = 0;
+};
+
+template <typename Tracer>
+void timePolicy(PolicyTiming& timing, uint64_t operations, unsigned threads) {
+    auto stack = runThreads(threads, [&](unsigned t) { return stackWorkload<Tracer>(operations, 88172645463325252ull + t); });
+    auto start = Clock::now();
+    uint64_t array = arrayWorkload<Tracer>(operations / 20, 2463534242ull);
+    double arraySeconds = elapsedSeconds(start);
+    timing.stackSeconds = min(timing.stackSeconds, stack.first);
+    timing.arraySeconds = min(timing.arraySeconds, arraySeconds);
+    timing.stackChecksum = stack.second;
+    timing.arrayChecksum = array;
+}
+
+// Returns: false if a policy changed the results or the trace file differs (also reported on cerr)
+bool runBenchmark(uint64_t operations, const string& path, unsigned threads) {
+    cout << "\n=== BENCHMARK: " << operations << " stack operations x " << threads << " thread(s), "
+         << operations / 20 << " array operations, best of " << REPETITIONS << " ===" << endl;
+
+    PolicyTiming plain{"NoTracing                         "};
+    PolicyTiming off{"OperationTracing, switched off    "};
+    PolicyTiming on{"OperationTracing, 1 in 256 timed  "};
+    uint64_t dumps;
+    {
+        TraceDumper dumper(path, chrono::milliseconds(100));
+        // ArrayOperations prints every change; silence cout so the timing is the operation itself
+        streambuf* console = cout.rdbuf(nullptr);
+        for (int rep = 0; rep < REPETITIONS; ++rep) {
+            timePolicy<NoTracing>(plain, operations, threads);
+            setTracingEnabled(false);
+            timePolicy<OperationTracing>(off, operations, threads);
+            setTracingEnabled(true);
+            timePolicy<OperationTracing>(on, operations, threads);
+        }
+        cout.rdbuf(console);
+        dumps = dumper.completedDumps();
+    }
+
+    cout << "Policy                            stack s    M ops/s   array s   overhead (stack, array)" << endl;
+    bool consistent = true;
+    for (const PolicyTiming* timing : {&plain, &off, &on}) {
+        if (timing->stackChecksum != plain.stackChecksum || timing->arrayChecksum != plain.arrayChecksum) {
+            cerr << "Mismatch between implementations!" << endl;
+            consistent = false;
+        }
+        cout << timing->name << timing->stackSeconds << "   " << operations * threads / timing->stackSeconds / 1e6
+             << "   " << timing->arraySeconds << "   " << (timing->stackSeconds / plain.stackSeconds - 1) * 100 << "%, "
+             << (timing->arraySeconds / plain.arraySeconds - 1) * 100 << "%" << endl;
+    }
+
+    TraceSnapshot snapshot = traceSnapshot();
+    cout << "\nFinal snapshot (includes the demonstration above):" << endl;
+    writeTraceReport(cout, snapshot);
+
+    ifstream file(path);
+    stringstream contents;
+    contents << file.rdbuf();
+    ostringstream expected;
+    writeTraceReport(expected, snapshot);
+    cout << "Trace file " << path << ": " << dumps << " periodic dump(s) during the run, final dump "
+         << (contents.str() == expected.str() ? "matches the snapshot" : "DIFFERS from the snapshot") << endl;
+    if (contents.str() != expected.str()) {
+        cerr << "Mismatch between implementations!" << endl;
+        consistent = false;
+    }
+    return consistent;
+}
+
+int main(int argc, char* argv[]) {
+    // Off unless CONTAINER_TRACE is set; the demonstration below switches it on explicitly
+    unique_ptr<TraceDumper> environmentDumper;
+    try {
+        environmentDumper = startTracingFromEnvironment();
+    } catch (const invalid_argument& e) {
+        cerr << "Ignoring " << e.what() << endl;
+    }
+    setTracingEnabled(true);
+
+    demonstrateSnapshot();
+
+    uint64_t operations = (argc > 1) ? strtoull(argv[1], nullptr, 10) : 20000000;
+    string path = (argc > 2) ? argv[2] : "container_trace.txt";
+    unsigned threads = (argc > 3) ? unsigned(atoi(argv[3])) : thread::hardware_concurrency();
+    if (threads == 0) threads = 1;
+    if (!runBenchmark(operations, path, threads)) return 1;
+
+    cout << "\n=== Demo completed successfully ===" << endl;
+    return 0;
+}
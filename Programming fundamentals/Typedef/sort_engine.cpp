@@ -0,0 +1,252 @@
+/*
+ * File: sort_engine.cpp
+ * Sorting ArrayOperations and vectors with sort_engine.h
+ * Author: Gaurav
+ * Date: 2025
+ *
+ * This file demonstrates:
+ * 1. Sorting an ArrayOperations<int> in place, and vectors of double, char and string
+ * 2. Which algorithm sortRange picks for each type and size (already ordered input is finished
+ *    by a linear scan first, shown as "presorted")
+ * 3. A benchmark of std::sort, introsort, radix sort and parallel merge sort on uniform, sorted,
+ *    reversed and many-duplicates inputs, for int, double, char and string keys
+ *
+ * Every result is checked: it must be in order and hold the same multiset of keys as the input
+ * (an order-independent fingerprint), so no reference copy is kept: above 4M keys the input is
+ * regenerated for each algorithm, and 10^9 ints need only the data plus one buffer (8 GB).
+ *
+ * Run this file independently to see the sort engine in action.
+ * Usage: ./sort_engine [max_keys] [threads]
+ *        (defaults: 10000000 keys, all hardware threads; sizes run from 1000 up to max_keys)
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include "array_operations.h"
+#include "sort_engine.h"
+
+using namespace std;
+
+using Clock = chrono::steady_clock;
+
+double elapsedSeconds(Clock::time_point start) {
+    return chrono::duration<double>(Clock::now() - start).count();
+}
+
+// -------------------------------------------------
+// 1. INPUTS AND CHECKS
+// -------------------------------------------------
+
+enum class Distribution { UNIFORM, SORTED, REVERSED, MANY_DUPLICATES };
+const Distribution DISTRIBUTIONS[] = {Distribution::UNIFORM, Distribution::SORTED, Distribution::REVERSED,
+                                      Distribution::MANY_DUPLICATES};
+
+const char* distributionName(Distribution distribution) {
+    switch (distribution) {
+        case Distribution::UNIFORM: return "uniform";
+        case Distribution::SORTED: return "sorted";
+        case Distribution::REVERSED: return "reversed";
+        default: return "many duplicates";
+    }
+}
+
+// Random key of each type; duplicates mode draws from 16 distinct values
+int makeKey(mt19937_64& rng, int*, bool duplicates) {
+    return duplicates ? int(rng() % 16) * 1000003 : int(uint32_t(rng()));
+}
+double makeKey(mt19937_64& rng, double*, bool duplicates) {
+    if (duplicates) return double(int(rng() % 16) - 8) * 0.25;
+    return (double(rng() >> 11) / double(1ull << 53) - 0.5) * 2e6;
+}
+char makeKey(mt19937_64& rng, char*, bool duplicates) {
+    return char(duplicates ? 'a' + rng() % 4 : rng() % 256);
+}
+string makeKey(mt19937_64& rng, string*, bool duplicates) {
+    if (duplicates) return "key-" + to_string(rng() % 16);
+    string key(8 + rng() % 9, ' ');
+    for (char& c : key) c = char('a' + rng() % 26);
+    return key;
+}
+
+// Fills values with size keys; sorted and reversed inputs are sorted with std::sort (not timed)
+template <typename T>
+void fillInput(vector<T>& values, size_t size, Distribution distribution) {
+    mt19937_64 rng(50);
+    values.resize(size);
+    for (T& value : values) value = makeKey(rng, (T*)nullptr, distribution == Distribution::MANY_DUPLICATES);
+    if (distribution == Distribution::SORTED) sort(values.begin(), values.end());
+    if (distribution == Distribution::REVERSED) sort(values.begin(), values.end(), greater<T>());
+}
+
+uint64_t mix(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdull;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ull;
+    return x ^ (x >> 33);
+}
+
+template <typename T>
+uint64_t keyBits(const T& value) {
+    uint64_t bits = 0;
+    memcpy(&bits, &value, sizeof(T));
+    return bits;
+}
+uint64_t keyBits(const string& value) {
+    return hash<string>()(value);
+}
+
+// Same value for any ordering of the same keys
+template <typename T>
+uint64_t fingerprint(const vector<T>& values) {
+    uint64_t sum = 0;
+    for (const T& value : values) sum += mix(keyBits(value));
+    return sum;
+}
+
+// -------------------------------------------------
+// 2. DEMONSTRATION
+// -------------------------------------------------
+
+void demonstrateSorting() {
+    cout << "=== Sorting ArrayOperations in place ===" << endl;
+    ArrayOperations<int> numbers;
+    for (int value : {42, 7, 19, -3, 88, 0, 19, 5}) numbers.insertAtEnd(value);
+    numbers.traverse();
+    SortAlgorithm used = sortInPlace(numbers);
+    numbers.traverse();
+    cout << "Algorithm: " << sortAlgorithmName(used) << endl;
+
+    cout << "\n=== Sorting vectors ===" << endl;
+    vector<double> prices = {3.5, -0.0, -12.25, 1e-9, 0.0, 99.99, -1e300};
+    sortInPlace(prices, 1, SortAlgorithm::RADIX);
+    cout << "Radix-sorted doubles:";
+    for (double price : prices) cout << " " << price;
+    cout << endl;
+
+    vector<char> letters = {'s', 'o', 'r', 't', 'i', 'n', 'g'};
+    sortInPlace(letters);
+    cout << "Counting-sorted chars: " << string(letters.begin(), letters.end()) << endl;
+
+    vector<string> names = {"pear", "apple", "fig", "banana", "cherry"};
+    sortInPlace(names);
+    cout << "Introsorted strings:";
+    for (const string& name : names) cout << " " << name;
+    cout << endl;
+
+    try {
+        sortInPlace(names, 1, SortAlgorithm::RADIX);
+    } catch (const invalid_argument& e) {
+        cout << "Caught expected error: " << e.what() << endl;
+    }
+
+    cout << "\nAutomatic choice (4 threads):" << endl;
+    for (size_t size : {size_t(50), size_t(100000), size_t(10000000)}) {
+        cout << "  " << setw(9) << size << " keys: int " << sortAlgorithmName(chooseSortAlgorithm<int>(size, 4))
+             << ", double " << sortAlgorithmName(chooseSortAlgorithm<double>(size, 4))
+             << ", string " << sortAlgorithmName(chooseSortAlgorithm<string>(size, 4)) << endl;
+    }
+}
+
+// -------------------------------------------------
+// 3. BENCHMARK
+// -------------------------------------------------
+
+// Results that failed the order or fingerprint check; main exits non-zero if any did
+size_t failedChecks = 0;
+
+// Inputs up to this size are kept and copied for repeated runs; larger ones are regenerated
+const size_t KEEP_INPUT_MAX = size_t(1) << 22;
+
+// Times one algorithm on fresh copies of the input, repeating small sizes to run for ~50 ms
+// Returns: seconds per sort, or a negative value if memory ran out
+template <typename T, typename Sort>
+double timeSort(vector<T>& values, const vector<T>& original, size_t size, Distribution distribution,
+                uint64_t expected, Sort sortValues) {
+    double total = 0;
+    int runs = 0;
+    try {
+        do {
+            if (original.empty()) fillInput(values, size, distribution);
+            else values = original;
+            auto start = Clock::now();
+            sortValues(values);
+            total += elapsedSeconds(start);
+            ++runs;
+        } while (total < 0.05 && runs < 1000);
+    } catch (const bad_alloc&) {
+        return -1;
+    }
+    if (!is_sorted(values.begin(), values.end()) || fingerprint(values) != expected) {
+        cerr << "Mismatch between implementations!" << endl;
+        ++failedChecks;
+    }
+    return total / runs;
+}
+
+template <typename T>
+void benchmarkType(const char* typeName, size_t maxKeys, unsigned threads) {
+    cout << "\n--- " << typeName << " keys (ms per sort; auto = sortRange's own choice) ---" << endl;
+    cout << left << setw(11) << "keys" << setw(17) << "distribution" << right << setw(11) << "std::sort"
+         << setw(11) << "introsort" << setw(11) << "radix" << setw(11) << "merge" << setw(11) << "auto" << "  (picked)" << endl;
+    vector<T> values;
+    for (size_t size = 1000; size <= maxKeys; size = (size * 10 > maxKeys && size < maxKeys) ? maxKeys : size * 10) {
+        for (Distribution distribution : DISTRIBUTIONS) {
+            fillInput(values, size, distribution);
+            uint64_t expected = fingerprint(values);
+            vector<T> original;
+            if (size <= KEEP_INPUT_MAX) original = values;
+            auto show = [](double seconds) {
+                ostringstream cell;
+                if (seconds < 0) cell << "no memory";
+                else cell << fixed << setprecision(seconds < 0.01 ? 4 : 1) << seconds * 1000;
+                return cell.str();
+            };
+            double standard = timeSort(values, original, size, distribution, expected, [](vector<T>& v) { sort(v.begin(), v.end()); });
+            double intro = timeSort(values, original, size, distribution, expected, [](vector<T>& v) { sortInPlace(v, 1, SortAlgorithm::INTROSORT); });
+            string radix = "-";
+            if constexpr (RadixKey<T>::available) {
+                radix = show(timeSort(values, original, size, distribution, expected, [](vector<T>& v) { sortInPlace(v, 1, SortAlgorithm::RADIX); }));
+            }
+            double merge = timeSort(values, original, size, distribution, expected,
+                                    [threads](vector<T>& v) { sortInPlace(v, threads, SortAlgorithm::PARALLEL_MERGE); });
+            SortAlgorithm picked = SortAlgorithm::AUTO;
+            double automatic = timeSort(values, original, size, distribution, expected,
+                                        [threads, &picked](vector<T>& v) { picked = sortInPlace(v, threads); });
+            cout << left << setw(11) << size << setw(17) << distributionName(distribution) << right << setw(11)
+                 << show(standard) << setw(11) << show(intro) << setw(11) << radix << setw(11) << show(merge)
+                 << setw(11) << show(automatic) << "  " << sortAlgorithmName(picked) << endl;
+        }
+        if (size == maxKeys) break;
+    }
+}
+
+void runBenchmark(size_t maxKeys, unsigned threads) {
+    cout << "\n=== BENCHMARK: up to " << maxKeys << " keys, merge sort on " << threads << " thread(s) ===" << endl;
+    benchmarkType<int>("int", maxKeys, threads);
+    benchmarkType<double>("double", maxKeys, threads);
+    benchmarkType<char>("char", maxKeys, threads);
+    benchmarkType<string>("string", max<size_t>(1000, maxKeys / 10), threads);   // strings cost ~10x more per key
+}
+
+int main(int argc, char* argv[]) {
+    demonstrateSorting();
+
+    size_t maxKeys = (argc > 1) ? strtoull(argv[1], nullptr, 10) : 10000000;
+    unsigned threads = resolveSortThreads((argc > 2) ? unsigned(atoi(argv[2])) : 0);
+    runBenchmark(max<size_t>(maxKeys, 1000), threads);
+    if (failedChecks > 0) return 1;
+
+    cout << "\n=== Demo completed successfully ===" << endl;
+    return 0;
+}
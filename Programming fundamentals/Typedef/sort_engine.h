@@ -0,0 +1,611 @@
+/*
+ * File: sort_engine.h
+ * Sorting for ArrayOperations<T> and std::vector<T>: radix, parallel merge and introsort
+ * Author: Gaurav
+ * Date: 2025
+ *
+ * Three algorithms, one entry point:
+ *   introSort          pattern-defeating quicksort for any T with operator< (or a comparator):
+ *                      median-of-3 / ninther pivots, insertion sort below 24 elements, linear time
+ *                      on sorted and reversed runs, equal keys grouped in one pass, and heapsort if
+ *                      partitions keep going badly, so O(n log n) in the worst case
+ *   radixSort          LSD radix sort, one byte per pass, for integers, char, float and double.
+ *                      Floating point values are sorted by their bits: flipping the sign bit of
+ *                      positive values and all bits of negative values makes the bit patterns
+ *                      order like the numbers (-0.0 sorts before +0.0; NaNs go to the ends).
+ *                      Passes where every key has the same byte are skipped, and 1-byte keys are
+ *                      a single counting pass with no extra memory
+ *   parallelMergeSort  splits the data into chunks sorted on a thread pool (radix or introsort),
+ *                      then merges pairs of runs; each merge is cut into equal pieces with a
+ *                      binary search along the merge path so every round uses every thread
+ *
+ * sortRange() / sortInPlace() choose by type and size (chooseSortAlgorithm) unless told which to
+ * use, after a scan that finishes already ascending or descending input, and return the
+ * algorithm they ran. None of the algorithms is stable. Radix and merge sort
+ * use a buffer as large as the input; merge sort needs T to be default-constructible.
+ */
+
+#ifndef SORT_ENGINE_H
+#define SORT_ENGINE_H
+
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "array_operations.h"
+
+// -------------------------------------------------
+// 1. INTROSORT (pattern-defeating quicksort)
+// -------------------------------------------------
+
+constexpr std::ptrdiff_t INSERTION_SORT_THRESHOLD = 24;
+constexpr std::ptrdiff_t NINTHER_THRESHOLD = 128;
+constexpr std::ptrdiff_t PARTIAL_INSERTION_SORT_LIMIT = 8;   // moves allowed before giving up
+
+template <typename T, typename Compare>
+void insertionSort(T* first, T* last, Compare less) {
+    if (first == last) return;
+    for (T* current = first + 1; current != last; ++current) {
+        if (less(*current, *(current - 1))) {
+            T value = std::move(*current);
+            T* hole = current;
+            do {
+                *hole = std::move(*(hole - 1));
+                --hole;
+            } while (hole != first && less(value, *(hole - 1)));
+            *hole = std::move(value);
+        }
+    }
+}
+
+// Insertion sort that relies on *(first - 1) being no greater than any element (no bounds check)
+template <typename T, typename Compare>
+void unguardedInsertionSort(T* first, T* last, Compare less) {
+    if (first == last) return;
+    for (T* current = first + 1; current != last; ++current) {
+        if (less(*current, *(current - 1))) {
+            T value = std::move(*current);
+            T* hole = current;
+            do {
+                *hole = std::move(*(hole - 1));
+                --hole;
+            } while (less(value, *(hole - 1)));
+            *hole = std::move(value);
+        }
+    }
+}
+
+// Insertion sort that gives up after PARTIAL_INSERTION_SORT_LIMIT moves
+// Returns: true if the range is now sorted
+template <typename T, typename Compare>
+bool partialInsertionSort(T* first, T* last, Compare less) {
+    if (first == last) return true;
+    std::ptrdiff_t moves = 0;
+    for (T* current = first + 1; current != last; ++current) {
+        if (moves > PARTIAL_INSERTION_SORT_LIMIT) return false;
+        if (less(*current, *(current - 1))) {
+            T value = std::move(*current);
+            T* hole = current;
+            do {
+                *hole = std::move(*(hole - 1));
+                --hole;
+            } while (hole != first && less(value, *(hole - 1)));
+            *hole = std::move(value);
+            moves += current - hole;
+        }
+    }
+    return true;
+}
+
+template <typename T, typename Compare>
+void sort3(T* a, T* b, T* c, Compare less) {
+    if (less(*b, *a)) std::iter_swap(a, b);
+    if (less(*c, *b)) std::iter_swap(b, c);
+    if (less(*b, *a)) std::iter_swap(a, b);
+}
+
+/*
+ * Partitions around the pivot *first: smaller elements left, the rest right
+ * Returns: the pivot's final position, and whether the range was already partitioned (no swaps)
+ * Needs an element not less than the pivot at the end (the pivot selection guarantees it).
+ */
+template <typename T, typename Compare>
+std::pair<T*, bool> partitionRight(T* first, T* last, Compare less) {
+    T pivot = std::move(*first);
+    T* left = first;
+    T* right = last;
+    while (less(*++left, pivot)) {}
+    if (left - 1 == first) {
+        while (left < right && !less(*--right, pivot)) {}
+    } else {
+        while (!less(*--right, pivot)) {}
+    }
+    bool alreadyPartitioned = left >= right;
+    while (left < right) {
+        std::iter_swap(left, right);
+        while (less(*++left, pivot)) {}
+        while (!less(*--right, pivot)) {}
+    }
+    T* pivotPosition = left - 1;
+    *first = std::move(*pivotPosition);
+    *pivotPosition = std::move(pivot);
+    return {pivotPosition, alreadyPartitioned};
+}
+
+// Puts every element equal to the pivot *first on the left, for ranges full of duplicates
+// Returns: the last position holding a pivot-equal element
+template <typename T, typename Compare>
+T* partitionLeft(T* first, T* last, Compare less) {
+    T pivot = std::move(*first);
+    T* left = first;
+    T* right = last;
+    while (less(pivot, *--right)) {}
+    if (right + 1 == last) {
+        while (left < right && !less(pivot, *++left)) {}
+    } else {
+        while (!less(pivot, *++left)) {}
+    }
+    while (left < right) {
+        std::iter_swap(left, right);
+        while (less(pivot, *--right)) {}
+        while (!less(pivot, *++left)) {}
+    }
+    *first = std::move(*right);
+    *right = std::move(pivot);
+    return right;
+}
+
+// Swaps a few elements near the ends of a badly split part, breaking patterns that fool the pivot
+template <typename T>
+void breakPatterns(T* first, T* last) {
+    std::ptrdiff_t size = last - first;
+    if (size < INSERTION_SORT_THRESHOLD) return;
+    std::ptrdiff_t quarter = size / 4;
+    std::iter_swap(first, first + quarter);
+    std::iter_swap(last - 1, last - quarter);
+    if (size > NINTHER_THRESHOLD) {
+        std::iter_swap(first + 1, first + (quarter + 1));
+        std::iter_swap(first + 2, first + (quarter + 2));
+        std::iter_swap(last - 2, last - (quarter + 1));
+        std::iter_swap(last - 3, last - (quarter + 2));
+    }
+}
+
+// leftmost is false when *(first - 1) is a pivot no greater than anything in [first, last)
+template <typename T, typename Compare>
+void introSortLoop(T* first, T* last, Compare less, int badAllowed, bool leftmost) {
+    while (true) {
+        std::ptrdiff_t size = last - first;
+        if (size < INSERTION_SORT_THRESHOLD) {
+            if (leftmost) insertionSort(first, last, less);
+            else unguardedInsertionSort(first, last, less);
+            return;
+        }
+
+        // Pivot: median of 3, or pseudomedian of 9 for larger parts, moved to *first
+        std::ptrdiff_t half = size / 2;
+        if (size > NINTHER_THRESHOLD) {
+            sort3(first, first + half, last - 1, less);
+            sort3(first + 1, first + (half - 1), last - 2, less);
+            sort3(first + 2, first + (half + 1), last - 3, less);
+            sort3(first + (half - 1), first + half, first + (half + 1), less);
+            std::iter_swap(first, first + half);
+        } else {
+            sort3(first + half, first, last - 1, less);
+        }
+
+        // Pivot equal to the one before this part: everything equal to it is done in one pass
+        if (!leftmost && !less(*(first - 1), *first)) {
+            first = partitionLeft(first, last, less) + 1;
+            continue;
+        }
+
+        std::pair<T*, bool> split = partitionRight(first, last, less);
+        T* pivot = split.first;
+        std::ptrdiff_t leftSize = pivot - first;
+        std::ptrdiff_t rightSize = last - (pivot + 1);
+        bool unbalanced = leftSize < size / 8 || rightSize < size / 8;
+        if (unbalanced) {
+            if (--badAllowed == 0) {
+                std::make_heap(first, last, less);
+                std::sort_heap(first, last, less);
+                return;
+            }
+            breakPatterns(first, pivot);
+            breakPatterns(pivot + 1, last);
+        } else if (split.second && partialInsertionSort(first, pivot, less) &&
+                   partialInsertionSort(pivot + 1, last, less)) {
+            return;   // already sorted (or nearly): linear time on sorted input
+        }
+
+        introSortLoop(first, pivot, less, badAllowed, leftmost);
+        first = pivot + 1;
+        leftmost = false;
+    }
+}
+
+template <typename T, typename Compare>
+void introSort(T* first, T* last, Compare less) {
+    std::ptrdiff_t size = last - first;
+    if (size < 2) return;
+    int log2Size = 0;
+    while (size >>= 1) ++log2Size;
+    introSortLoop(first, last, less, log2Size, true);
+}
+
+template <typename T>
+void introSort(T* first, T* last) {
+    introSort(first, last, std::less<T>());
+}
+
+// -------------------------------------------------
+// 2. LSD RADIX SORT
+// -------------------------------------------------
+
+/*
+ * RadixKey<T>::of(value) maps T to an unsigned integer with the same order
+ * available is false for types radix sort cannot handle.
+ */
+template <typename T, typename Enable = void>
+struct RadixKey {
+    static constexpr bool available = false;
+};
+
+template <typename T>
+struct RadixKey<T, std::enable_if_t<std::is_integral<T>::value && !std::is_same<T, bool>::value>> {
+    static constexpr bool available = true;
+    using Key = std::make_unsigned_t<T>;
+    static Key of(T value) {
+        constexpr Key SIGN = std::is_signed<T>::value ? Key(Key(1) << (8 * sizeof(T) - 1)) : Key(0);
+        return Key(Key(value) ^ SIGN);
+    }
+};
+
+template <typename T>
+struct RadixKey<T, std::enable_if_t<std::is_floating_point<T>::value && (sizeof(T) == 4 || sizeof(T) == 8)>> {
+    static constexpr bool available = true;
+    using Key = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+    static Key of(T value) {
+        constexpr Key SIGN = Key(1) << (8 * sizeof(T) - 1);
+        Key bits;
+        std::memcpy(&bits, &value, sizeof(T));
+        return (bits & SIGN) ? Key(~bits) : Key(bits ^ SIGN);
+    }
+};
+
+/*
+ * Sorts [first, last) using scratch, which must hold as many elements (unused for 1-byte keys)
+ * Each pass is stable, so after the last pass the keys are in order byte by byte.
+ */
+template <typename T>
+void radixSort(T* first, T* last, T* scratch) {
+    static_assert(RadixKey<T>::available, "radixSort needs an integer, char, float or double type");
+    using Key = typename RadixKey<T>::Key;
+    constexpr int BYTES = int(sizeof(Key));
+    std::size_t size = std::size_t(last - first);
+    if (size < 2) return;
+
+    // One read of the data fills the histogram of every byte
+    std::vector<std::array<std::size_t, 256>> counts(BYTES);   // zero-initialized
+    for (std::size_t i = 0; i < size; ++i) {
+        Key key = RadixKey<T>::of(first[i]);
+        for (int b = 0; b < BYTES; ++b) ++counts[b][(key >> (8 * b)) & 0xFF];
+    }
+
+    if constexpr (BYTES == 1) {
+        // Counting sort: rewrite the values in key order, no scratch needed (of(0) is the sign flip)
+        T* out = first;
+        for (int key = 0; key < 256; ++key) out = std::fill_n(out, counts[0][key], T(Key(key) ^ RadixKey<T>::of(T(0))));
+        (void)scratch;
+        return;
+    }
+
+    T* from = first;
+    T* to = scratch;
+    for (int b = 0; b < BYTES; ++b) {
+        std::array<std::size_t, 256>& histogram = counts[b];
+        int shift = 8 * b;
+        if (histogram[(RadixKey<T>::of(from[0]) >> shift) & 0xFF] == size) continue;   // byte is the same everywhere
+        std::size_t offset = 0;
+        for (std::size_t& count : histogram) {
+            std::size_t bucketSize = count;
+            count = offset;
+            offset += bucketSize;
+        }
+        for (std::size_t i = 0; i < size; ++i) {
+            to[histogram[(RadixKey<T>::of(from[i]) >> shift) & 0xFF]++] = from[i];
+        }
+        std::swap(from, to);
+    }
+    if (from != first) std::copy(from, from + size, first);
+}
+
+// Throws: std::bad_alloc if the scratch buffer cannot be allocated
+template <typename T>
+void radixSort(T* first, T* last) {
+    std::vector<T> scratch(sizeof(T) == 1 ? 0 : std::size_t(last - first));   // 1-byte keys need none
+    radixSort(first, last, scratch.data());
+}
+
+// -------------------------------------------------
+// 3. PARALLEL MERGE SORT
+// -------------------------------------------------
+
+/*
+ * Fixed set of worker threads pulling tasks from one queue
+ * wait() blocks until every submitted task has finished.
+ */
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex lock;
+    std::condition_variable taskReady;
+    std::condition_variable allDone;
+    std::size_t unfinished;
+    bool stopping;
+
+    void workerLoop() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                taskReady.wait(guard, [this] { return stopping || !tasks.empty(); });
+                if (tasks.empty()) return;   // stopping and drained
+                task = std::move(tasks.front());
+                tasks.pop();
+            }
+            task();
+            std::lock_guard<std::mutex> guard(lock);
+            if (--unfinished == 0) allDone.notify_all();
+        }
+    }
+
+public:
+    explicit ThreadPool(std::size_t threadCount) : unfinished(0), stopping(false) {
+        if (threadCount == 0) threadCount = 1;
+        for (std::size_t t = 0; t < threadCount; ++t) workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+        }
+        taskReady.notify_all();
+        for (std::thread& worker : workers) worker.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    std::size_t size() const { return workers.size(); }
+
+    void submit(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            tasks.push(std::move(task));
+            ++unfinished;
+        }
+        taskReady.notify_one();
+    }
+
+    void wait() {
+        std::unique_lock<std::mutex> guard(lock);
+        allDone.wait(guard, [this] { return unfinished == 0; });
+    }
+};
+
+constexpr std::size_t MERGE_MIN_CHUNK = std::size_t(1) << 14;   // smallest run worth a task
+
+// Returns: how many of the first outputIndex merged elements come from a (ties go to a, like std::merge)
+template <typename T, typename Compare>
+std::size_t mergePathSplit(const T* a, std::size_t aSize, const T* b, std::size_t bSize,
+                           std::size_t outputIndex, Compare less) {
+    std::size_t low = outputIndex > bSize ? outputIndex - bSize : 0;
+    std::size_t high = std::min(outputIndex, aSize);
+    while (low < high) {
+        std::size_t middle = low + (high - low) / 2;
+        if (!less(b[outputIndex - 1 - middle], a[middle])) low = middle + 1;
+        else high = middle;
+    }
+    return low;
+}
+
+// Returns: the number of threads 0 ("all") stands for
+inline unsigned resolveSortThreads(unsigned threads) {
+    if (threads != 0) return threads;
+    unsigned hardware = std::thread::hardware_concurrency();
+    return hardware == 0 ? 1 : hardware;
+}
+
+/*
+ * Sorts chunks with sortChunk(first, last, scratch) on the pool, then merges runs pairwise
+ * (moving between the data and a buffer of the same size) until one run is left
+ * Throws: std::bad_alloc if the buffer cannot be allocated
+ */
+template <typename T, typename Compare, typename ChunkSort>
+void parallelMergeSort(T* first, T* last, Compare less, ThreadPool& pool, ChunkSort sortChunk) {
+    std::size_t size = std::size_t(last - first);
+    std::size_t threads = pool.size();
+    std::size_t chunks = 1;
+    while (chunks < threads * 4 && size / (chunks * 2) >= MERGE_MIN_CHUNK) chunks *= 2;
+    std::unique_ptr<T[]> buffer(new T[size]);
+    T* scratch = buffer.get();
+    if (chunks == 1) {
+        sortChunk(first, last, scratch);
+        return;
+    }
+
+    std::vector<std::size_t> bounds(chunks + 1);
+    for (std::size_t c = 0; c <= chunks; ++c) bounds[c] = size * c / chunks;
+    for (std::size_t c = 0; c < chunks; ++c) {
+        std::size_t from = bounds[c], to = bounds[c + 1];
+        pool.submit([=] { sortChunk(first + from, first + to, scratch + from); });
+    }
+    pool.wait();
+
+    T* from = first;
+    T* to = scratch;
+    std::size_t grain = std::max(MERGE_MIN_CHUNK, size / (threads * 4));
+    while (bounds.size() > 2) {
+        std::vector<std::size_t> merged;
+        for (std::size_t r = 0; r + 1 < bounds.size(); r += 2) {
+            std::size_t begin = bounds[r];
+            std::size_t middle = bounds[r + 1];
+            std::size_t end = r + 2 < bounds.size() ? bounds[r + 2] : middle;   // odd run out: copied as is
+            merged.push_back(begin);
+            T* a = from + begin;
+            T* b = from + middle;
+            std::size_t aSize = middle - begin, bSize = end - middle;
+            std::size_t pieces = std::max<std::size_t>(1, (end - begin) / grain);
+            for (std::size_t p = 0; p < pieces; ++p) {
+                std::size_t outBegin = (end - begin) * p / pieces;
+                std::size_t outEnd = (end - begin) * (p + 1) / pieces;
+                T* out = to + begin + outBegin;
+                pool.submit([=] {
+                    std::size_t i0 = mergePathSplit(a, aSize, b, bSize, outBegin, less);
+                    std::size_t i1 = mergePathSplit(a, aSize, b, bSize, outEnd, less);
+                    std::size_t j0 = outBegin - i0, j1 = outEnd - i1;
+                    std::merge(std::make_move_iterator(a + i0), std::make_move_iterator(a + i1),
+                               std::make_move_iterator(b + j0), std::make_move_iterator(b + j1), out, less);
+                });
+            }
+        }
+        merged.push_back(size);
+        pool.wait();
+        bounds.swap(merged);
+        std::swap(from, to);
+    }
+
+    if (from != first) {
+        for (std::size_t start = 0; start < size; start += grain) {
+            std::size_t stop = std::min(size, start + grain);
+            pool.submit([=] { std::move(from + start, from + stop, first + start); });
+        }
+        pool.wait();
+    }
+}
+
+// Chunks sorted with introSort
+template <typename T, typename Compare>
+void parallelMergeSort(T* first, T* last, Compare less, unsigned threads = 0) {
+    ThreadPool pool(resolveSortThreads(threads));
+    parallelMergeSort(first, last, less, pool, [less](T* begin, T* end, T*) { introSort(begin, end, less); });
+}
+
+// -------------------------------------------------
+// 4. CHOOSING AN ALGORITHM
+// -------------------------------------------------
+
+// PRESORTED: AUTO found the input already ascending, or descending and reversed it
+enum class SortAlgorithm { AUTO, PRESORTED, INTROSORT, RADIX, PARALLEL_MERGE };
+
+inline const char* sortAlgorithmName(SortAlgorithm algorithm) {
+    switch (algorithm) {
+        case SortAlgorithm::PRESORTED: return "presorted";
+        case SortAlgorithm::INTROSORT: return "introsort";
+        case SortAlgorithm::RADIX: return "radix";
+        case SortAlgorithm::PARALLEL_MERGE: return "parallel merge";
+        default: return "auto";
+    }
+}
+
+constexpr std::size_t RADIX_MIN_SIZE = 2048;                       // below this introsort is faster (see sort_engine.cpp)
+constexpr std::size_t PARALLEL_MIN_SIZE = std::size_t(1) << 20;    // below this threads cost more than they save
+
+// Returns: what sortRange uses for size elements of T on threads threads (0 = all)
+template <typename T>
+SortAlgorithm chooseSortAlgorithm(std::size_t size, unsigned threads = 0) {
+    if (resolveSortThreads(threads) > 1 && size >= PARALLEL_MIN_SIZE) return SortAlgorithm::PARALLEL_MERGE;
+    if (RadixKey<T>::available && (sizeof(T) == 1 || size >= RADIX_MIN_SIZE)) return SortAlgorithm::RADIX;
+    return SortAlgorithm::INTROSORT;
+}
+
+/*
+ * Finishes ranges that are already in order: ascending is left alone, descending is reversed
+ * Returns: true if the range is now sorted
+ * Both scans stop at the first element out of order, so unordered data costs a few comparisons.
+ */
+template <typename T>
+bool finishIfOrdered(T* first, T* last) {
+    if (std::is_sorted(first, last)) return true;
+    if (std::is_sorted(first, last, [](const T& a, const T& b) { return b < a; })) {
+        std::reverse(first, last);
+        return true;
+    }
+    return false;
+}
+
+template <typename T>
+void radixOrIntroSort(T* first, T* last, T* scratch) {
+    if (finishIfOrdered(first, last)) return;
+    if constexpr (RadixKey<T>::available) {
+        if (sizeof(T) == 1 || std::size_t(last - first) >= RADIX_MIN_SIZE) {
+            radixSort(first, last, scratch);
+            return;
+        }
+    }
+    (void)scratch;
+    introSort(first, last);
+}
+
+/*
+ * Sorts [first, last) ascending with the given algorithm. AUTO first finishes already ordered
+ * input (finishIfOrdered), then runs what chooseSortAlgorithm picks.
+ * Returns: the algorithm that ran
+ * Throws: std::invalid_argument if RADIX is requested for a type it cannot sort
+ * Throws: std::bad_alloc if RADIX or PARALLEL_MERGE cannot allocate its buffer
+ */
+template <typename T>
+SortAlgorithm sortRange(T* first, T* last, unsigned threads = 0, SortAlgorithm algorithm = SortAlgorithm::AUTO) {
+    if (algorithm == SortAlgorithm::AUTO) {
+        if (finishIfOrdered(first, last)) return SortAlgorithm::PRESORTED;
+        algorithm = chooseSortAlgorithm<T>(std::size_t(last - first), threads);
+    }
+    switch (algorithm) {
+        case SortAlgorithm::PRESORTED:
+            if (!finishIfOrdered(first, last)) introSort(first, last);
+            break;
+        case SortAlgorithm::RADIX:
+            if constexpr (RadixKey<T>::available) radixSort(first, last);
+            else throw std::invalid_argument("Radix sort needs an integer, char, float or double type");
+            break;
+        case SortAlgorithm::PARALLEL_MERGE: {
+            ThreadPool pool(resolveSortThreads(threads));
+            parallelMergeSort(first, last, std::less<T>(), pool,
+                              [](T* begin, T* end, T* scratch) { radixOrIntroSort(begin, end, scratch); });
+            break;
+        }
+        default:
+            introSort(first, last);
+            break;
+    }
+    return algorithm;
+}
+
+// Sorts the elements of an ArrayOperations in place (traced arrays do not record the moves)
+template <typename T, typename Tracer>
+SortAlgorithm sortInPlace(ArrayOperations<T, Tracer>& array, unsigned threads = 0,
+                          SortAlgorithm algorithm = SortAlgorithm::AUTO) {
+    return sortRange(array.begin(), array.end(), threads, algorithm);
+}
+
+template <typename T>
+SortAlgorithm sortInPlace(std::vector<T>& values, unsigned threads = 0, SortAlgorithm algorithm = SortAlgorithm::AUTO) {
+    return sortRange(values.data(), values.data() + values.size(), threads, algorithm);
+}
+
+#endif // SORT_ENGINE_H
@@ -0,0 +1,124 @@
+/*
+ * File: template_stack.h
+ * Template-based stack that works with any data type
+ * Author: Gaurav
+ * Date: 2025
+ * 
+ * Header-only so the class can be shared: typedef_impl.cpp holds the demonstrations,
+ * and any other program can include this file (CMake target: containers).
+ */
+
+#ifndef TEMPLATE_STACK_H
+#define TEMPLATE_STACK_H
+
+#include <iostream>
+#include <stdexcept>
+#include "container_tracing.h"
+
+/*
+ * Template class representing a generic stack data structure
+ * 
+ * This template class implements a stack that can work with any data type.
+ * It provides basic stack operations: push, pop, peek, and isEmpty.
+ * 
+ * Template parameter T: The data type for the stack elements
+ * Template parameter Tracer: NoTracing (default, no cost) or OperationTracing, see container_tracing.h
+ */
+template <typename T, typename Tracer = NoTracing>
+class Stack {
+public:
+    // Constants for better maintainability (class-scoped so other containers can reuse the names)
+    static constexpr int MAX_ARRAY_SIZE = 100;
+    static constexpr int STACK_EMPTY_VALUE = -1;
+
+private:
+    T data[MAX_ARRAY_SIZE];    // Array to store elements of type T
+    int top;                   // Index of the top element
+    [[no_unique_address]] mutable typename Tracer::Recorder recorder;   // empty unless tracing
+    
+public:
+    // Constructor to initialize the stack
+    Stack() : top(STACK_EMPTY_VALUE) {
+        // Initialize all elements to default value for type T
+        for (int i = 0; i < MAX_ARRAY_SIZE; ++i) {
+            data[i] = T();
+        }
+    }
+    
+    // Check if the stack is empty
+    // Returns: true if stack is empty, false otherwise
+    bool isEmpty() const {
+        return top == STACK_EMPTY_VALUE;
+    }
+    
+    // Check if the stack is full
+    // Returns: true if stack is full, false otherwise
+    bool isFull() const {
+        return top == MAX_ARRAY_SIZE - 1;
+    }
+    
+    // Push an element onto the stack
+    // Parameter: value - The value of type T to push
+    // Throws: std::overflow_error if stack is full
+    void push(T value) {
+        if (isFull()) {
+            throw std::overflow_error("Stack overflow: Cannot push to full stack");
+        }
+        auto trace = recorder.begin(TraceOp::STACK_PUSH);
+        data[++top] = value;
+        recorder.end(TraceOp::STACK_PUSH, trace, 0);
+    }
+    
+    // Pop an element from the stack
+    // Returns: The top element of the stack
+    // Throws: std::underflow_error if stack is empty
+    T pop() {
+        if (isEmpty()) {
+            throw std::underflow_error("Stack underflow: Cannot pop from empty stack");
+        }
+        auto trace = recorder.begin(TraceOp::STACK_POP);
+        T value = data[top--];
+        recorder.end(TraceOp::STACK_POP, trace, 0);
+        return value;
+    }
+    
+    // Peek at the top element without removing it
+    // Returns: The top element of the stack
+    // Throws: std::underflow_error if stack is empty
+    T peek() const {
+        if (isEmpty()) {
+            throw std::underflow_error("Stack underflow: Cannot peek empty stack");
+        }
+        auto trace = recorder.begin(TraceOp::STACK_PEEK);
+        T value = data[top];
+        recorder.end(TraceOp::STACK_PEEK, trace, 0);
+        return value;
+    }
+    
+    // Get the current size of the stack
+    // Returns: Number of elements in the stack
+    int size() const {
+        return top + 1;
+    }
+    
+    // Display all elements in the stack
+    void display() const {
+        if (isEmpty()) {
+            std::cout << "Stack is empty" << std::endl;
+            return;
+        }
+        
+        std::cout << "Stack contents (top to bottom): ";
+        for (int i = top; i >= 0; --i) {
+            std::cout << data[i];
+            if (i > 0) std::cout << " -> ";
+        }
+        std::cout << std::endl;
+    }
+};
+
+// Stack that records counts and latencies (container_tracing.h)
+template <typename T>
+using TracedStack = Stack<T, OperationTracing>;
+
+#endif // TEMPLATE_STACK_H
@@ -8,104 +8,16 @@
  * 1. Integer data type (stack<int>)
  * 2. Character data type (stack<char>)
  * 3. Double data type (stack<double>)
+ * 
+ * The Stack class itself lives in template_stack.h.
  */
 
 #include <iostream>
 #include <stdexcept>
+#include "template_stack.h"
 
 using namespace std;
 
-// Constants for better maintainability
-const int MAX_ARRAY_SIZE = 100;
-const int STACK_EMPTY_VALUE = -1;
-
-/*
- * Template class representing a generic stack data structure
- * 
- * This template class implements a stack that can work with any data type.
- * It provides basic stack operations: push, pop, peek, and isEmpty.
- * 
- * Template parameter T: The data type for the stack elements
- */
-template <typename T>
-class Stack {
-private:
-    T data[MAX_ARRAY_SIZE];    // Array to store elements of type T
-    int top;                   // Index of the top element
-    
-public:
-    // Constructor to initialize the stack
-    Stack() : top(STACK_EMPTY_VALUE) {
-        // Initialize all elements to default value for type T
-        for (int i = 0; i < MAX_ARRAY_SIZE; ++i) {
-            data[i] = T();
-        }
-    }
-    
-    // Check if the stack is empty
-    // Returns: true if stack is empty, false otherwise
-    bool isEmpty() const {
-        return top == STACK_EMPTY_VALUE;
-    }
-    
-    // Check if the stack is full
-    // Returns: true if stack is full, false otherwise
-    bool isFull() const {
-        return top == MAX_ARRAY_SIZE - 1;
-    }
-    
-    // Push an element onto the stack
-    // Parameter: value - The value of type T to push
-    // Throws: overflow_error if stack is full
-    void push(T value) {
-        if (isFull()) {
-            throw overflow_error("Stack overflow: Cannot push to full stack");
-        }
-        data[++top] = value;
-    }
-    
-    // Pop an element from the stack
-    // Returns: The top element of the stack
-    // Throws: underflow_error if stack is empty
-    T pop() {
-        if (isEmpty()) {
-            throw underflow_error("Stack underflow: Cannot pop from empty stack");
-        }
-        return data[top--];
-    }
-    
-    // Peek at the top element without removing it
-    // Returns: The top element of the stack
-    // Throws: underflow_error if stack is empty
-    T peek() const {
-        if (isEmpty()) {
-            throw underflow_error("Stack underflow: Cannot peek empty stack");
-        }
-        return data[top];
-    }
-    
-    // Get the current size of the stack
-    // Returns: Number of elements in the stack
-    int size() const {
-        return top + 1;
-    }
-    
-    // Display all elements in the stack
-    void display() const {
-        if (isEmpty()) {
-            cout << "Stack is empty" << endl;
-            return;
-        }
-        
-        cout << "Stack contents (top to bottom): ";
-        for (int i = top; i >= 0; --i) {
-            cout << data[i];
-            if (i > 0) cout << " -> ";
-        }
-        cout << endl;
-    }
-};
-
 // Function to demonstrate the use of template stack with different data types
 void demonstrateTemplateStack() {
     cout << "=== Template Stack Implementation Demo ===" << endl;
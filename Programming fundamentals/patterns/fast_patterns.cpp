@@ -0,0 +1,146 @@
+/*
+ * fast_patterns.cpp
+ * Prints the same 15 patterns as patterns.cpp, but renders them into one preallocated buffer and
+ * hands it to the operating system with a single write.
+ * Theory: patterns.cpp does one cout << per cell and flushes with endl after every row, so large n
+ * spends its time in per-call and per-flush overhead. Here the exact output size is computed first
+ * (pattern_engine.h), the buffer is allocated once, numbers are converted with a table-driven
+ * integer-to-ASCII routine, and the output is written in one system call.
+ * Usage:
+ *   ./fast_patterns                          prompts for n like patterns.cpp
+ *   ./fast_patterns n                        prints every pattern for n
+ *   ./fast_patterns --bench [n] [output]     MB/s per pattern (default n = 10000, output /dev/null)
+ */
+#include <iostream>
+#include <fstream>
+#include <memory>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>    // for open
+#include <unistd.h>   // for close
+#include "pattern_engine.h"
+using namespace std;
+
+using Clock = chrono::steady_clock;
+
+double elapsedSeconds(Clock::time_point start) {
+    return chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Print all 15 patterns for n with one write to stdout
+int printAllPatterns(uint64_t n) {
+    uint64_t total = 1;   // the blank line patterns.cpp prints after reading n
+    for (int p = 0; p < PATTERN_COUNT; ++p) total += pattern_bytes(pattern_at(p), n);
+
+    unique_ptr<char[]> buffer(new char[total]);
+    char* cursor = buffer.get();
+    *cursor++ = '\n';
+    for (int p = 0; p < PATTERN_COUNT; ++p) cursor = render_pattern(pattern_at(p), n, cursor);
+
+    if (uint64_t(cursor - buffer.get()) != total) {
+        cerr << "Mismatch between implementations! (precomputed size)" << endl;
+        return 1;
+    }
+    if (!write_fully(STDOUT_FILENO, buffer.get(), total)) {
+        perror("write");
+        return 1;
+    }
+    return 0;
+}
+
+// The patterns.cpp approach for comparison: one << per cell, endl per row
+void renderWithStream(Pattern pattern, uint64_t n, ostream& out) {
+    if (pattern == Pattern::SQUARE_STARS) {
+        for (uint64_t i = 0; i < n; ++i) {
+            for (uint64_t j = 0; j < n; ++j) out << "* ";
+            out << endl;
+        }
+    } else {   // SQUARE_CONSECUTIVE_NUMBERS
+        uint64_t num = 1;
+        for (uint64_t i = 0; i < n; ++i) {
+            for (uint64_t j = 0; j < n; ++j) out << num++ << " ";
+            out << endl;
+        }
+    }
+    out << endl;
+}
+
+int runBenchmark(uint64_t n, const char* path) {
+    cout << "=== BENCHMARK: n = " << n << ", output " << path << " ===" << endl;
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        perror(path);
+        return 1;
+    }
+
+    // One buffer sized for the largest pattern, touched once so page faults are not timed
+    uint64_t largest = 0;
+    for (int p = 0; p < PATTERN_COUNT; ++p) {
+        uint64_t bytes = pattern_bytes(pattern_at(p), n);
+        if (bytes > largest) largest = bytes;
+    }
+    unique_ptr<char[]> buffer(new char[largest]);
+    memset(buffer.get(), 0, largest);
+
+    cout << "Pattern                          MB      render(s)  write(s)  MB/s" << endl;
+    uint64_t totalBytes = 0;
+    double totalSeconds = 0;
+    for (int p = 0; p < PATTERN_COUNT; ++p) {
+        Pattern pattern = pattern_at(p);
+        auto start = Clock::now();
+        uint64_t bytes = uint64_t(render_pattern(pattern, n, buffer.get()) - buffer.get());
+        double renderSeconds = elapsedSeconds(start);
+        start = Clock::now();
+        if (!write_fully(fd, buffer.get(), bytes)) {
+            perror("write");
+            close(fd);
+            return 1;
+        }
+        double writeSeconds = elapsedSeconds(start);
+        double seconds = renderSeconds + writeSeconds;
+        totalBytes += bytes;
+        totalSeconds += seconds;
+        cout << pattern_name(pattern) << "  " << bytes / 1e6 << "  " << renderSeconds << "  " << writeSeconds
+             << "  " << bytes / 1e6 / seconds << endl;
+    }
+    close(fd);
+    cout << "All patterns: " << totalBytes / 1e6 << " MB in " << totalSeconds << " s = "
+         << totalBytes / 1e6 / totalSeconds << " MB/s" << endl;
+
+    // Baseline: the cout-per-cell loop on two of the patterns, into the same destination
+    cout << "\nBaseline (<< per cell, endl per row):" << endl;
+    Pattern baselines[2] = {Pattern::SQUARE_STARS, Pattern::SQUARE_CONSECUTIVE_NUMBERS};
+    for (Pattern pattern : baselines) {
+        ofstream out(path, ios::binary | ios::trunc);
+        auto start = Clock::now();
+        renderWithStream(pattern, n, out);
+        double seconds = elapsedSeconds(start);
+        uint64_t bytes = pattern_bytes(pattern, n);
+        cout << pattern_name(pattern) << "  " << bytes / 1e6 << " MB  " << seconds << " s  "
+             << bytes / 1e6 / seconds << " MB/s" << endl;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0) {
+        uint64_t n = (argc > 2) ? strtoull(argv[2], nullptr, 10) : 10000;
+        const char* path = (argc > 3) ? argv[3] : "/dev/null";
+        return runBenchmark(n, path);
+    }
+
+    long long n;
+    if (argc > 1) {
+        n = atoll(argv[1]);
+    } else {
+        cout << "Enter n: " << flush;
+        cin >> n;
+    }
+    if (n < 0) {
+        cerr << "n must not be negative" << endl;
+        return 1;
+    }
+    return printAllPatterns(uint64_t(n));
+}
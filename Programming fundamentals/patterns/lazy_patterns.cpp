@@ -0,0 +1,145 @@
+/*
+ * lazy_patterns.cpp
+ * Demonstrates pulling pattern rows on demand with PatternRows (pattern_rows.h).
+ * Theory: patterns.cpp prints straight to cout, so another consumer only gets the output by
+ * capturing stdout. A pull-based range lets the consumer decide: read the first k rows of a huge
+ * pattern, sample every k-th row, compare row by row against a reference, or stream rows into a
+ * socket while they are produced, always holding just one row in memory.
+ * Shows: take, drop and skip on huge patterns, a row-by-row test comparator, a streaming checksum
+ * and run-length "compression" stand-in, and streaming into a socket read by another thread.
+ * Usage: ./lazy_patterns [n]   (default 3000; the take/sample demos use n = 1000000)
+ */
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <chrono>
+#include <algorithm>   // for min
+#include <cstdint>
+#include <cstdlib>
+#include <sys/socket.h>   // for socketpair
+#include <unistd.h>       // for read, close
+#include "pattern_rows.h"
+using namespace std;
+
+// Compare the lazy rows of every pattern with the buffer renderer for n
+bool matchesReference(uint64_t n) {
+    for (int p = 0; p < PATTERN_COUNT; ++p) {
+        Pattern pattern = pattern_at(p);
+        string expected(pattern_bytes(pattern, n), '\0');
+        render_pattern(pattern, n, &expected[0]);
+        string_view remaining(expected);
+        for (string_view row : PatternRows(pattern, n)) {
+            if (remaining.substr(0, row.size()) != row) {
+                cerr << "Mismatch between implementations! (" << pattern_name(pattern) << ")" << endl;
+                return false;
+            }
+            remaining.remove_prefix(row.size());
+        }
+        if (remaining != "\n") {
+            cerr << "Mismatch between implementations! (" << pattern_name(pattern) << " length)" << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Streaming consumers: each sees one row at a time
+struct StreamStats {
+    uint64_t rows = 0;
+    uint64_t bytes = 0;
+    uint64_t checksum = 14695981039346656037ULL;   // FNV-1a
+    uint64_t runs = 0;                              // byte runs, as a run-length coder would emit
+    size_t largestRow = 0;
+    char previous = 0;
+
+    void consume(string_view row) {
+        ++rows;
+        bytes += row.size();
+        if (row.size() > largestRow) largestRow = row.size();
+        for (char c : row) {
+            checksum = (checksum ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+            if (c != previous) ++runs;
+            previous = c;
+        }
+    }
+};
+
+// Stream one pattern through a socket pair: this thread produces rows, a reader thread drains them
+uint64_t streamThroughSocket(Pattern pattern, uint64_t n) {
+    int ends[2];
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, ends) != 0) {
+        perror("socketpair");
+        return 0;
+    }
+    uint64_t received = 0;
+    thread reader([&received, &ends] {
+        char chunk[1 << 16];
+        ssize_t count;
+        while ((count = read(ends[1], chunk, sizeof(chunk))) > 0) received += uint64_t(count);
+    });
+    for (string_view row : PatternRows(pattern, n)) {
+        if (!write_fully(ends[0], row.data(), row.size())) break;
+    }
+    write_fully(ends[0], "\n", 1);
+    close(ends[0]);   // reader sees end of stream
+    reader.join();
+    close(ends[1]);
+    return received;
+}
+
+int main(int argc, char* argv[]) {
+    uint64_t n = (argc > 1) ? strtoull(argv[1], nullptr, 10) : 3000;
+    const uint64_t HUGE_N = 1000000;
+
+    // First rows of patterns far too large to print (square_consecutive_numbers: ~13 TB)
+    cout << "First 4 rows of left_triangle_consecutive, n = " << HUGE_N << ":" << endl;
+    for (string_view row : PatternRows(Pattern::LEFT_TRIANGLE_CONSECUTIVE, HUGE_N).take(4)) cout << row;
+
+    PatternRows square(Pattern::SQUARE_CONSECUTIVE_NUMBERS, HUGE_N);
+    cout << "square_consecutive_numbers, n = " << HUGE_N << ": " << square.bytes() / 1e12 << " TB in total" << endl;
+    auto first = square.begin();
+    cout << "  row 1 starts with: " << (*first).substr(0, 40) << "..." << endl;
+
+    // Jump straight to the last row: closed-form start values, nothing in between is rendered
+    auto last = square.begin();
+    last.skip(HUGE_N - 1);
+    string_view lastRow = *last;
+    cout << "  row " << last.rowNumber() << " ends with: ..." << lastRow.substr(lastRow.size() - 41, 40) << endl;
+
+    // Sample every 250000th row of a triangle
+    cout << "Every 250000th row of left_triangle_decreasing_start, n = " << HUGE_N << " (first 30 bytes):" << endl;
+    PatternRows triangle(Pattern::LEFT_TRIANGLE_DECREASING_START, HUGE_N);
+    for (auto it = triangle.begin(); it != triangle.end(); it.skip(250000)) {
+        string_view row = *it;
+        cout << "  row " << it.rowNumber() << ": " << row.substr(0, min<size_t>(30, row.size() - 1)) << "..." << endl;
+    }
+
+    // Rows 3..5 of a small pattern with drop + take
+    cout << "Rows 3-5 of square_same_alphabets, n = 6:" << endl;
+    for (string_view row : PatternRows(Pattern::SQUARE_SAME_ALPHABETS, 6).drop(2).take(3)) cout << row;
+
+    // Test comparator
+    bool identical = matchesReference(1) && matchesReference(7) && matchesReference(150);
+    cout << "Lazy rows match pattern_engine.h: " << (identical ? "yes" : "NO") << endl;
+    if (!identical) return 1;
+
+    // Streaming consumers with O(row) memory
+    cout << "\nStreaming every pattern for n = " << n << ":" << endl;
+    cout << "Pattern  MB  largest row (KB)  run-length ratio  checksum  socket MB/s" << endl;
+    for (int p = 0; p < PATTERN_COUNT; ++p) {
+        Pattern pattern = pattern_at(p);
+        StreamStats stats;
+        for (string_view row : PatternRows(pattern, n)) stats.consume(row);
+
+        auto start = chrono::steady_clock::now();
+        uint64_t received = streamThroughSocket(pattern, n);
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        cout << pattern_name(pattern) << "  " << stats.bytes / 1e6 << "  " << stats.largestRow / 1e3 << "  "
+             << double(stats.bytes) / double(stats.runs ? stats.runs : 1) << "  " << hex << stats.checksum << dec
+             << "  " << received / 1e6 / seconds << endl;
+    }
+
+    return 0;
+}
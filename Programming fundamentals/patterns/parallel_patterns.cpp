@@ -0,0 +1,263 @@
+/*
+ * parallel_patterns.cpp
+ * Writes the same 15 patterns as patterns.cpp to a file, rendering rows on several threads.
+ * Theory: Every row of every pattern can be rendered on its own. Most rows depend only on the row
+ * number; the two consecutive-number patterns get their first value from a closed form
+ * (row_start_value: (i-1)*n + 1 for the square, (i-1)*i/2 + 1 for the triangle). Exact row sizes
+ * (pattern_engine.h) give every chunk of rows its byte offset in the output before anything is
+ * rendered, so the output file is sized and memory-mapped up front. A thread pool then renders each
+ * chunk straight into its own slice of the mapping; the chunks land in order without any copying
+ * or merging step.
+ * Usage: ./parallel_patterns [n] [output_file] [max_threads]
+ *        (defaults: n = 5, patterns_output.txt, all hardware threads; runs 1, 2, 4, ... threads)
+ * The output grows with n^2 (n = 2000 is ~180 MB, n = 10000 ~4.8 GB, rewritten once per thread
+ * count), so large runs need n given explicitly.
+ * The file holds exactly what "./fast_patterns n" prints.
+ */
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>     // for strerror
+#include <cerrno>
+#include <fcntl.h>     // for open
+#include <sys/mman.h>  // for mmap, msync, munmap
+#include <unistd.h>    // for ftruncate, close
+#include "pattern_engine.h"
+using namespace std;
+
+const uint64_t CHUNK_TARGET_BYTES = uint64_t(4) << 20;   // ~4 MB of output per task
+
+// -------------------------------------------------
+// 1. THREAD POOL
+// -------------------------------------------------
+
+/*
+ * Fixed set of worker threads pulling tasks from one queue
+ * wait() blocks until every submitted task has finished.
+ */
+class ThreadPool {
+private:
+    vector<thread> workers;
+    queue<function<void()>> tasks;
+    mutex lock;
+    condition_variable taskReady;
+    condition_variable allDone;
+    size_t unfinished;
+    bool stopping;
+
+    void workerLoop() {
+        while (true) {
+            function<void()> task;
+            {
+                unique_lock<mutex> guard(lock);
+                taskReady.wait(guard, [this] { return stopping || !tasks.empty(); });
+                if (tasks.empty()) return;   // stopping and drained
+                task = move(tasks.front());
+                tasks.pop();
+            }
+            task();
+            lock_guard<mutex> guard(lock);
+            if (--unfinished == 0) allDone.notify_all();
+        }
+    }
+
+public:
+    explicit ThreadPool(size_t threadCount) : unfinished(0), stopping(false) {
+        if (threadCount == 0) threadCount = 1;
+        for (size_t t = 0; t < threadCount; ++t) workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+
+    ~ThreadPool() {
+        {
+            lock_guard<mutex> guard(lock);
+            stopping = true;
+        }
+        taskReady.notify_all();
+        for (thread& worker : workers) worker.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const { return workers.size(); }
+
+    void submit(function<void()> task) {
+        {
+            lock_guard<mutex> guard(lock);
+            tasks.push(move(task));
+            ++unfinished;
+        }
+        taskReady.notify_one();
+    }
+
+    void wait() {
+        unique_lock<mutex> guard(lock);
+        allDone.wait(guard, [this] { return unfinished == 0; });
+    }
+};
+
+// -------------------------------------------------
+// 2. MEMORY-MAPPED OUTPUT FILE
+// -------------------------------------------------
+
+/*
+ * Output file of a fixed size, mapped writable into memory
+ * Throws: runtime_error if the file cannot be created, sized or mapped
+ */
+class MappedOutput {
+private:
+    int fd;
+    char* base;
+    uint64_t length;
+
+    static runtime_error failure(const string& what, const string& path) {
+        return runtime_error(what + " " + path + ": " + strerror(errno));
+    }
+
+public:
+    MappedOutput(const string& path, uint64_t length) : fd(-1), base(nullptr), length(length) {
+        fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) throw failure("Cannot create", path);
+        if (ftruncate(fd, off_t(length)) != 0) {
+            close(fd);
+            throw failure("Cannot size", path);
+        }
+        if (length > 0) {
+            void* mapping = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (mapping == MAP_FAILED) {
+                close(fd);
+                throw failure("Cannot map", path);
+            }
+            base = static_cast<char*>(mapping);
+        }
+    }
+
+    ~MappedOutput() {
+        if (base) munmap(base, length);
+        close(fd);
+    }
+
+    MappedOutput(const MappedOutput&) = delete;
+    MappedOutput& operator=(const MappedOutput&) = delete;
+
+    char* data() { return base; }
+    uint64_t size() const { return length; }
+
+    // Flush dirty pages to the disk and wait for it
+    void sync() {
+        if (base) msync(base, length, MS_SYNC);
+    }
+};
+
+// -------------------------------------------------
+// 3. PARALLEL GENERATION
+// -------------------------------------------------
+
+// Rows firstRow..lastRow-1 of one pattern, rendered at byte offset `offset` of the output
+struct Chunk {
+    Pattern pattern;
+    uint64_t firstRow;
+    uint64_t lastRow;
+    uint64_t offset;
+    uint64_t bytes;
+};
+
+// Split every pattern into ~CHUNK_TARGET_BYTES chunks and give each its output offset.
+// separatorOffsets receives the position of each pattern's trailing blank line.
+uint64_t planChunks(uint64_t n, vector<Chunk>& chunks, vector<uint64_t>& separatorOffsets) {
+    uint64_t cursor = 1;   // leading blank line, as after "Enter n:" in patterns.cpp
+    for (int p = 0; p < PATTERN_COUNT; ++p) {
+        Pattern pattern = pattern_at(p);
+        uint64_t row = 1;
+        while (row <= n) {
+            Chunk chunk = {pattern, row, row, cursor, 0};
+            while (chunk.lastRow <= n && chunk.bytes < CHUNK_TARGET_BYTES) {
+                chunk.bytes += row_bytes(pattern, n, chunk.lastRow);
+                ++chunk.lastRow;
+            }
+            chunks.push_back(chunk);
+            cursor += chunk.bytes;
+            row = chunk.lastRow;
+        }
+        separatorOffsets.push_back(cursor);
+        cursor += 1;
+    }
+    return cursor;
+}
+
+struct RunResult {
+    uint64_t bytes;
+    size_t chunks;
+    double renderSeconds;   // plan + map + render, data in the page cache
+    double syncSeconds;     // msync: until the data is on disk
+};
+
+// Generate all patterns for n into path using `threads` workers
+// Throws: runtime_error on file errors or if a chunk does not match its planned size
+RunResult generateParallel(uint64_t n, const string& path, size_t threads) {
+    auto start = chrono::steady_clock::now();
+    vector<Chunk> chunks;
+    vector<uint64_t> separatorOffsets;
+    uint64_t total = planChunks(n, chunks, separatorOffsets);
+
+    MappedOutput output(path, total);
+    char* base = output.data();
+    base[0] = '\n';
+    for (uint64_t offset : separatorOffsets) base[offset] = '\n';
+
+    atomic<size_t> mismatches(0);
+    {
+        ThreadPool pool(threads);
+        for (const Chunk& chunk : chunks) {
+            pool.submit([&, chunk] {
+                char* begin = base + chunk.offset;
+                char* end = render_rows(chunk.pattern, n, chunk.firstRow, chunk.lastRow, begin);
+                if (uint64_t(end - begin) != chunk.bytes) ++mismatches;
+            });
+        }
+        pool.wait();
+    }
+    if (mismatches > 0) throw runtime_error("Rendered chunk size differs from the precomputed size");
+
+    RunResult result;
+    result.bytes = total;
+    result.chunks = chunks.size();
+    result.renderSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    start = chrono::steady_clock::now();
+    output.sync();
+    result.syncSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+    uint64_t n = (argc > 1) ? strtoull(argv[1], nullptr, 10) : 5;
+    string path = (argc > 2) ? argv[2] : "patterns_output.txt";
+    size_t maxThreads = (argc > 3) ? strtoul(argv[3], nullptr, 10) : thread::hardware_concurrency();
+    if (maxThreads == 0) maxThreads = 1;
+
+    cout << "=== PARALLEL PATTERNS: n = " << n << ", output " << path << " ===" << endl;
+    cout << "Threads  MB      chunks  render(s)  MB/s    sync(s)" << endl;
+    try {
+        for (size_t threads = 1; ; threads *= 2) {
+            if (threads > maxThreads) threads = maxThreads;
+            RunResult result = generateParallel(n, path, threads);
+            cout << threads << "  " << result.bytes / 1e6 << "  " << result.chunks << "  " << result.renderSeconds
+                 << "  " << result.bytes / 1e6 / result.renderSeconds << "  " << result.syncSeconds << endl;
+            if (threads == maxThreads) break;
+        }
+    } catch (const runtime_error& e) {
+        cerr << "Error: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,291 @@
+/*
+ * pattern_engine.h
+ * Byte-exact, buffer-based rendering of the 15 patterns from patterns.cpp.
+ * Definition: Instead of one cout << per cell and an endl (flush) per row, a pattern is formatted
+ * straight into a byte buffer. Every row's size is known in closed form, so the buffer can be sized
+ * exactly before rendering, any row can be rendered on its own (rows are independent), and the
+ * finished buffer goes to the output in a single write.
+ * The output is identical to patterns.cpp: every cell is followed by a space, every row by '\n',
+ * and every pattern by one blank line. Rows are numbered 1..n.
+ * Numbers are 64-bit here, so the consecutive patterns stay correct past n = 46340, where the
+ * int counters of patterns.cpp overflow.
+ */
+#ifndef PATTERN_ENGINE_H
+#define PATTERN_ENGINE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>   // for write
+
+// -------------------------------------------------
+// 1. PATTERN CATALOGUE
+// -------------------------------------------------
+
+enum class Pattern {
+    SQUARE_STARS,
+    SQUARE_SAME_NUMBERS,
+    SQUARE_INCREASING_NUMBERS,
+    SQUARE_DECREASING_NUMBERS,
+    SQUARE_CONSECUTIVE_NUMBERS,
+    LEFT_TRIANGLE_STARS,
+    LEFT_TRIANGLE_NUMBERS,
+    LEFT_TRIANGLE_CONSECUTIVE,
+    LEFT_TRIANGLE_INCREASING_START,
+    LEFT_TRIANGLE_DECREASING_START,
+    SQUARE_SAME_ALPHABETS,
+    SQUARE_INCREASING_ALPHABETS,
+    DIAGONAL_STARS,
+    V_SHAPE_STARS,
+    RIGHT_TRIANGLE_STARS
+};
+
+const int PATTERN_COUNT = 15;
+
+// Patterns in the order main() of patterns.cpp prints them
+inline Pattern pattern_at(int index) {
+    return static_cast<Pattern>(index);
+}
+
+inline const char* pattern_name(Pattern pattern) {
+    static const char* const NAMES[PATTERN_COUNT] = {
+        "square_stars", "square_same_numbers", "square_increasing_numbers", "square_decreasing_numbers",
+        "square_consecutive_numbers", "left_triangle_stars", "left_triangle_numbers",
+        "left_triangle_consecutive", "left_triangle_increasing_start", "left_triangle_decreasing_start",
+        "square_same_alphabets", "square_increasing_alphabets", "diagonal_stars", "v_shape_stars",
+        "right_triangle_stars"};
+    return NAMES[static_cast<int>(pattern)];
+}
+
+// -------------------------------------------------
+// 2. EXACT SIZES
+// -------------------------------------------------
+
+inline int decimal_digits(uint64_t value) {
+    int digits = 1;
+    while (value >= 10) {
+        value /= 10;
+        ++digits;
+    }
+    return digits;
+}
+
+// Total number of decimal digits in all integers from..to (0 when from > to)
+inline uint64_t digit_sum(uint64_t from, uint64_t to) {
+    if (from > to) return 0;
+    uint64_t total = 0;
+    uint64_t low = 1;   // smallest number with `digits` digits
+    for (int digits = 1; digits <= 20 && low <= to; ++digits) {
+        uint64_t high = (digits == 20) ? UINT64_MAX : low * 10 - 1;
+        uint64_t first = from > low ? from : low;
+        uint64_t last = to < high ? to : high;
+        if (first <= last) total += (last - first + 1) * uint64_t(digits);
+        if (digits < 20) low *= 10;
+    }
+    return total;
+}
+
+// First number printed on a row of the consecutive patterns (closed form, so rows are independent)
+inline uint64_t row_start_value(Pattern pattern, uint64_t n, uint64_t row) {
+    switch (pattern) {
+        case Pattern::SQUARE_CONSECUTIVE_NUMBERS: return (row - 1) * n + 1;
+        case Pattern::LEFT_TRIANGLE_CONSECUTIVE: return (row - 1) * row / 2 + 1;
+        case Pattern::LEFT_TRIANGLE_INCREASING_START:
+        case Pattern::LEFT_TRIANGLE_DECREASING_START: return row;
+        default: return 1;
+    }
+}
+
+// Number of cells on a row (triangles grow by one cell per row)
+inline uint64_t row_cells(Pattern pattern, uint64_t n, uint64_t row) {
+    switch (pattern) {
+        case Pattern::LEFT_TRIANGLE_STARS:
+        case Pattern::LEFT_TRIANGLE_NUMBERS:
+        case Pattern::LEFT_TRIANGLE_CONSECUTIVE:
+        case Pattern::LEFT_TRIANGLE_INCREASING_START:
+        case Pattern::LEFT_TRIANGLE_DECREASING_START: return row;
+        default: return n;
+    }
+}
+
+// Exact bytes of one row, including the trailing '\n'
+inline uint64_t row_bytes(Pattern pattern, uint64_t n, uint64_t row) {
+    uint64_t cells = row_cells(pattern, n, row);
+    switch (pattern) {
+        case Pattern::SQUARE_SAME_NUMBERS:
+        case Pattern::LEFT_TRIANGLE_NUMBERS:
+            return cells * uint64_t(decimal_digits(row) + 1) + 1;
+        case Pattern::SQUARE_INCREASING_NUMBERS:
+        case Pattern::SQUARE_DECREASING_NUMBERS:
+            return digit_sum(1, n) + cells + 1;
+        case Pattern::SQUARE_CONSECUTIVE_NUMBERS:
+        case Pattern::LEFT_TRIANGLE_CONSECUTIVE:
+        case Pattern::LEFT_TRIANGLE_INCREASING_START: {
+            uint64_t start = row_start_value(pattern, n, row);
+            return digit_sum(start, start + cells - 1) + cells + 1;
+        }
+        case Pattern::LEFT_TRIANGLE_DECREASING_START:
+            return digit_sum(1, row) + cells + 1;
+        default:   // one character plus a space per cell (blank cells are two spaces)
+            return cells * 2 + 1;
+    }
+}
+
+// Exact bytes of rows first..last-1
+inline uint64_t rows_bytes(Pattern pattern, uint64_t n, uint64_t first, uint64_t last) {
+    uint64_t total = 0;
+    for (uint64_t row = first; row < last; ++row) total += row_bytes(pattern, n, row);
+    return total;
+}
+
+// Exact bytes of a whole pattern, including the blank line after it
+inline uint64_t pattern_bytes(Pattern pattern, uint64_t n) {
+    return rows_bytes(pattern, n, 1, n + 1) + 1;
+}
+
+// -------------------------------------------------
+// 3. FORMATTING
+// -------------------------------------------------
+
+// Write value in decimal, two digits per step from a lookup table; returns the end of the text
+inline char* write_decimal(char* out, uint64_t value) {
+    static const char DIGIT_PAIRS[201] =
+        "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+        "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+    int digits = decimal_digits(value);
+    char* end = out + digits;
+    char* cursor = end;
+    while (value >= 100) {
+        uint64_t pair = (value % 100) * 2;
+        value /= 100;
+        cursor -= 2;
+        cursor[0] = DIGIT_PAIRS[pair];
+        cursor[1] = DIGIT_PAIRS[pair + 1];
+    }
+    if (value >= 10) {
+        cursor -= 2;
+        cursor[0] = DIGIT_PAIRS[value * 2];
+        cursor[1] = DIGIT_PAIRS[value * 2 + 1];
+    } else {
+        *--cursor = char('0' + value);
+    }
+    return end;
+}
+
+// Same byte patterns.cpp prints for char('A' + index): wraps modulo 256 past 'Z'
+inline char alphabet_cell(uint64_t index) {
+    return static_cast<char>(static_cast<unsigned char>('A' + index));
+}
+
+// Render one row (1-based) into out; returns the end of the row (after its '\n')
+inline char* render_row(Pattern pattern, uint64_t n, uint64_t row, char* out) {
+    uint64_t cells = row_cells(pattern, n, row);
+    switch (pattern) {
+        case Pattern::SQUARE_STARS:
+        case Pattern::LEFT_TRIANGLE_STARS:
+            for (uint64_t j = 0; j < cells; ++j) {
+                *out++ = '*';
+                *out++ = ' ';
+            }
+            break;
+        case Pattern::SQUARE_SAME_NUMBERS:
+        case Pattern::LEFT_TRIANGLE_NUMBERS:
+            for (uint64_t j = 0; j < cells; ++j) {
+                out = write_decimal(out, row);
+                *out++ = ' ';
+            }
+            break;
+        case Pattern::SQUARE_INCREASING_NUMBERS:
+            for (uint64_t j = 1; j <= n; ++j) {
+                out = write_decimal(out, j);
+                *out++ = ' ';
+            }
+            break;
+        case Pattern::SQUARE_DECREASING_NUMBERS:
+            for (uint64_t j = n; j >= 1; --j) {
+                out = write_decimal(out, j);
+                *out++ = ' ';
+            }
+            break;
+        case Pattern::SQUARE_CONSECUTIVE_NUMBERS:
+        case Pattern::LEFT_TRIANGLE_CONSECUTIVE:
+        case Pattern::LEFT_TRIANGLE_INCREASING_START: {
+            uint64_t value = row_start_value(pattern, n, row);
+            for (uint64_t j = 0; j < cells; ++j) {
+                out = write_decimal(out, value++);
+                *out++ = ' ';
+            }
+            break;
+        }
+        case Pattern::LEFT_TRIANGLE_DECREASING_START:
+            for (uint64_t value = row; value >= 1; --value) {
+                out = write_decimal(out, value);
+                *out++ = ' ';
+            }
+            break;
+        case Pattern::SQUARE_SAME_ALPHABETS:
+            for (uint64_t j = 0; j < n; ++j) {
+                *out++ = alphabet_cell(row - 1);
+                *out++ = ' ';
+            }
+            break;
+        case Pattern::SQUARE_INCREASING_ALPHABETS:
+            for (uint64_t j = 0; j < n; ++j) {
+                *out++ = alphabet_cell(j);
+                *out++ = ' ';
+            }
+            break;
+        case Pattern::DIAGONAL_STARS:
+        case Pattern::RIGHT_TRIANGLE_STARS:   // stars from column n + 1 - row onwards
+            for (uint64_t j = 1; j <= n; ++j) {
+                *out++ = (j >= n + 1 - row) ? '*' : ' ';
+                *out++ = ' ';
+            }
+            break;
+        case Pattern::V_SHAPE_STARS:          // stars from column row onwards
+            for (uint64_t j = 1; j <= n; ++j) {
+                *out++ = (j >= row) ? '*' : ' ';
+                *out++ = ' ';
+            }
+            break;
+    }
+    *out++ = '\n';
+    return out;
+}
+
+// Render rows first..last-1; returns the end of the text
+inline char* render_rows(Pattern pattern, uint64_t n, uint64_t first, uint64_t last, char* out) {
+    for (uint64_t row = first; row < last; ++row) out = render_row(pattern, n, row, out);
+    return out;
+}
+
+// Render a whole pattern plus its trailing blank line; out must hold pattern_bytes(pattern, n)
+inline char* render_pattern(Pattern pattern, uint64_t n, char* out) {
+    out = render_rows(pattern, n, 1, n + 1, out);
+    *out++ = '\n';
+    return out;
+}
+
+// -------------------------------------------------
+// 4. OUTPUT
+// -------------------------------------------------
+
+// Write the whole buffer, retrying after partial writes and EINTR
+// Returns: false on a write error (errno is left set)
+inline bool write_fully(int fd, const char* data, size_t length) {
+    const size_t MAX_CHUNK = size_t(1) << 30;   // Linux caps a single write at about 2 GB
+    while (length > 0) {
+        ssize_t written = ::write(fd, data, length < MAX_CHUNK ? length : MAX_CHUNK);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += written;
+        length -= size_t(written);
+    }
+    return true;
+}
+
+#endif // PATTERN_ENGINE_H
@@ -0,0 +1,109 @@
+/*
+ * pattern_rows.h
+ * Lazy, pull-based access to the rows of the patterns from patterns.cpp.
+ * Definition: PatternRows is an input range. Iterating it yields one row at a time as a
+ * string_view (text plus its '\n'); a row is rendered only when it is dereferenced, into a buffer
+ * owned by the iterator, so memory stays O(one row) however large n is. Because every row has a
+ * closed form (pattern_engine.h), take(), drop() and iterator skip() jump ahead without rendering
+ * the rows in between.
+ * The full output of patterns.cpp for one pattern is every row followed by one extra "\n".
+ *
+ * Usage:
+ *   for (string_view row : PatternRows(Pattern::SQUARE_CONSECUTIVE_NUMBERS, 1000000).take(3)) { ... }
+ *
+ * A row view is valid until its iterator is advanced or destroyed. Requires C++17 (string_view);
+ * written as an iterator rather than a C++20 coroutine so it builds with the rest of the tree.
+ */
+#ifndef PATTERN_ROWS_H
+#define PATTERN_ROWS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include "pattern_engine.h"
+
+/*
+ * Rows firstRow..lastRow-1 (1-based) of one pattern for size n
+ */
+class PatternRows {
+private:
+    Pattern pattern;
+    uint64_t n;
+    uint64_t firstRow;
+    uint64_t lastRow;
+
+public:
+    class iterator {
+    private:
+        const PatternRows* owner;
+        uint64_t row;
+        uint64_t renderedRow;   // 0 = nothing rendered yet
+        std::string buffer;
+
+        void render() {
+            buffer.resize(row_bytes(owner->pattern, owner->n, row));
+            render_row(owner->pattern, owner->n, row, &buffer[0]);
+            renderedRow = row;
+        }
+
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef std::string_view value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const std::string_view* pointer;
+        typedef std::string_view reference;
+
+        iterator(const PatternRows* owner, uint64_t row) : owner(owner), row(row), renderedRow(0) {}
+
+        // The current row, rendered on first access
+        std::string_view operator*() {
+            if (renderedRow != row) render();
+            return std::string_view(buffer.data(), buffer.size());
+        }
+
+        iterator& operator++() {
+            ++row;
+            return *this;
+        }
+
+        // Jump ahead `rows` rows without rendering them (stops at the end of the range)
+        iterator& skip(uint64_t rows) {
+            row = (owner->lastRow - row > rows) ? row + rows : owner->lastRow;
+            return *this;
+        }
+
+        // 1-based row number in the pattern
+        uint64_t rowNumber() const { return row; }
+
+        bool operator==(const iterator& other) const { return row == other.row; }
+        bool operator!=(const iterator& other) const { return row != other.row; }
+    };
+
+    PatternRows(Pattern pattern, uint64_t n) : pattern(pattern), n(n), firstRow(1), lastRow(n + 1) {}
+
+    PatternRows(Pattern pattern, uint64_t n, uint64_t firstRow, uint64_t lastRow)
+        : pattern(pattern), n(n), firstRow(firstRow), lastRow(lastRow < firstRow ? firstRow : lastRow) {}
+
+    iterator begin() const { return iterator(this, firstRow); }
+    iterator end() const { return iterator(this, lastRow); }
+
+    uint64_t size() const { return lastRow - firstRow; }
+    bool empty() const { return lastRow == firstRow; }
+
+    // First k rows of this range
+    PatternRows take(uint64_t k) const {
+        return PatternRows(pattern, n, firstRow, size() > k ? firstRow + k : lastRow);
+    }
+
+    // This range without its first k rows
+    PatternRows drop(uint64_t k) const {
+        return PatternRows(pattern, n, size() > k ? firstRow + k : lastRow, lastRow);
+    }
+
+    // Exact bytes of all rows in the range (without the blank line after the pattern)
+    uint64_t bytes() const { return rows_bytes(pattern, n, firstRow, lastRow); }
+};
+
+#endif // PATTERN_ROWS_H
@@ -0,0 +1,532 @@
+/*
+ * reuse_patterns.cpp
+ * Produces patterns from patterns.cpp by reusing rendered rows instead of rendering every cell.
+ * Theory: Many patterns repeat work. square_stars, square_increasing_numbers,
+ * square_decreasing_numbers and square_increasing_alphabets print the same row n times.
+ * left_triangle_stars prints growing prefixes of one row, diagonal/right_triangle_stars and
+ * v_shape_stars print sliding windows over "    ...* * *", and left_triangle_decreasing_start
+ * prints growing suffixes of "n ... 2 1 ". So one shared buffer of a single row (O(n) bytes) plus
+ * an (offset, length) window per row describes the whole O(n^2) pattern. The windows are sent with
+ * writev (iovecs pointing into the shared buffer) or copied with memcpy when a full buffer is needed.
+ * The triangle shapes also get a run-length representation: each row is a short list of
+ * (cell, count) runs, so a whole triangle takes O(n) memory and expands back on demand.
+ * Usage: ./reuse_patterns [n] [output_file]   (defaults: n = 2000, /dev/null)
+ * Writing to /dev/null measures CPU only (the kernel discards writev data without reading it);
+ * give a file to include the copy into the page cache.
+ */
+#include <iostream>
+#include <vector>
+#include <string>
+#include <memory>
+#include <chrono>
+#include <algorithm>   // for min
+#include <cstdint>
+#include <cstdio>      // for tmpfile, fileno
+#include <cstdlib>
+#include <cstring>     // for memcpy
+#include <cerrno>
+#include <fcntl.h>     // for open
+#include <sys/uio.h>   // for writev, iovec
+#include <unistd.h>    // for lseek, read, close
+#include "pattern_engine.h"
+using namespace std;
+
+const size_t IOV_BATCH = 1024;   // IOV_MAX on Linux: iovecs per writev call
+
+// -------------------------------------------------
+// 1. IOVEC WRITER
+// -------------------------------------------------
+
+/*
+ * Collects (pointer, length) pieces and sends them with as few writev calls as possible
+ * The pointed-to bytes must stay alive until flush() returns.
+ */
+class IovecWriter {
+private:
+    int fd;
+    vector<iovec> batch;
+    uint64_t written;
+    bool failed;
+
+public:
+    explicit IovecWriter(int fd) : fd(fd), written(0), failed(false) { batch.reserve(IOV_BATCH); }
+
+    void add(const char* data, size_t length) {
+        if (length == 0) return;
+        if (batch.size() == IOV_BATCH) flush();
+        iovec piece;
+        piece.iov_base = const_cast<char*>(data);
+        piece.iov_len = length;
+        batch.push_back(piece);
+    }
+
+    // Send everything collected so far, resuming after partial writes
+    // Returns: false if a write failed (errno is left set)
+    bool flush() {
+        size_t first = 0;
+        while (first < batch.size() && !failed) {
+            ssize_t count = writev(fd, batch.data() + first, int(batch.size() - first));
+            if (count < 0) {
+                if (errno == EINTR) continue;
+                failed = true;
+                break;
+            }
+            written += uint64_t(count);
+            size_t left = size_t(count);
+            while (first < batch.size() && left >= batch[first].iov_len) {
+                left -= batch[first].iov_len;
+                ++first;
+            }
+            if (left > 0) {
+                batch[first].iov_base = static_cast<char*>(batch[first].iov_base) + left;
+                batch[first].iov_len -= left;
+            }
+        }
+        batch.clear();
+        return !failed;
+    }
+
+    uint64_t bytesWritten() const { return written; }
+};
+
+// -------------------------------------------------
+// 2. SHARED-ROW PLANS
+// -------------------------------------------------
+
+/*
+ * One shared buffer plus a closed-form window for every row
+ * Row i is shared[offset .. offset + length) followed by '\n' (the newline is inside the window
+ * for repeated rows, so each such row is a single iovec).
+ */
+class SharedRowPlan {
+private:
+    Pattern pattern;
+    uint64_t n;
+    string shared;
+    bool repeatedRow;
+
+public:
+    // Returns: false if this pattern has no shared-row form (rows differ in their content)
+    bool build(Pattern p, uint64_t size) {
+        pattern = p;
+        n = size;
+        shared.clear();
+        repeatedRow = false;
+        switch (pattern) {
+            case Pattern::SQUARE_STARS:
+            case Pattern::SQUARE_INCREASING_NUMBERS:
+            case Pattern::SQUARE_DECREASING_NUMBERS:
+            case Pattern::SQUARE_INCREASING_ALPHABETS:
+                repeatedRow = true;
+                shared.resize(row_bytes(pattern, n, 1));
+                render_row(pattern, n, 1, &shared[0]);
+                return true;
+            case Pattern::LEFT_TRIANGLE_STARS:
+                for (uint64_t j = 0; j < n; ++j) shared += "* ";
+                return true;
+            case Pattern::DIAGONAL_STARS:
+            case Pattern::RIGHT_TRIANGLE_STARS:
+            case Pattern::V_SHAPE_STARS:
+                shared.assign(2 * n, ' ');
+                for (uint64_t j = 0; j < n; ++j) shared += "* ";
+                return true;
+            case Pattern::LEFT_TRIANGLE_DECREASING_START:
+                if (n == 0) return true;
+                shared.resize(row_bytes(pattern, n, n));
+                render_row(pattern, n, n, &shared[0]);
+                shared.pop_back();   // newline is added per row
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    bool rowsIncludeNewline() const { return repeatedRow; }
+    uint64_t sharedBytes() const { return shared.size(); }
+
+    // Window of row (1-based) inside the shared buffer
+    void window(uint64_t row, const char*& data, size_t& length) const {
+        uint64_t offset = 0, bytes = shared.size();
+        switch (pattern) {
+            case Pattern::LEFT_TRIANGLE_STARS:
+                bytes = 2 * row;
+                break;
+            case Pattern::DIAGONAL_STARS:
+            case Pattern::RIGHT_TRIANGLE_STARS:   // n - row blanks, then row stars
+                offset = 2 * row;
+                bytes = 2 * n;
+                break;
+            case Pattern::V_SHAPE_STARS:          // row - 1 blanks, then n - row + 1 stars
+                offset = 2 * (n - row + 1);
+                bytes = 2 * n;
+                break;
+            case Pattern::LEFT_TRIANGLE_DECREASING_START:   // skip the text of n .. row + 1
+                offset = digit_sum(row + 1, n) + (n - row);
+                bytes = shared.size() - offset;
+                break;
+            default:
+                break;
+        }
+        data = shared.data() + offset;
+        length = size_t(bytes);
+    }
+};
+
+// Send a whole pattern (plus its blank line) through writev; falls back to one row buffer at a time
+// Returns: false on a write error
+bool write_pattern_shared(Pattern pattern, uint64_t n, int fd) {
+    static const char NEWLINE = '\n';
+    IovecWriter writer(fd);
+    SharedRowPlan plan;
+    if (plan.build(pattern, n)) {
+        for (uint64_t row = 1; row <= n; ++row) {
+            const char* data;
+            size_t length;
+            plan.window(row, data, length);
+            writer.add(data, length);
+            if (!plan.rowsIncludeNewline()) writer.add(&NEWLINE, 1);
+        }
+        writer.add(&NEWLINE, 1);
+        return writer.flush();
+    }
+    // Rows differ: render each row into one reusable buffer (O(row) memory)
+    string rowBuffer;
+    for (uint64_t row = 1; row <= n; ++row) {
+        rowBuffer.resize(row_bytes(pattern, n, row));
+        render_row(pattern, n, row, &rowBuffer[0]);
+        writer.add(rowBuffer.data(), rowBuffer.size());
+        if (!writer.flush()) return false;
+    }
+    writer.add(&NEWLINE, 1);
+    return writer.flush();
+}
+
+// Render a whole pattern into out (pattern_bytes(pattern, n) bytes) by copying shared rows:
+// repeated rows are doubled with memcpy, windows are copied one per row
+char* render_pattern_reusing(Pattern pattern, uint64_t n, char* out) {
+    SharedRowPlan plan;
+    if (!plan.build(pattern, n)) return render_pattern(pattern, n, out);
+    if (plan.rowsIncludeNewline() && n > 0) {
+        const char* row;
+        size_t rowLength;
+        plan.window(1, row, rowLength);
+        uint64_t total = rowLength * n;
+        memcpy(out, row, rowLength);
+        uint64_t copied = rowLength;
+        while (copied < total) {
+            uint64_t step = min(copied, total - copied);
+            memcpy(out + copied, out, step);
+            copied += step;
+        }
+        out += total;
+    } else {
+        for (uint64_t row = 1; row <= n; ++row) {
+            const char* data;
+            size_t length;
+            plan.window(row, data, length);
+            memcpy(out, data, length);
+            out += length;
+            *out++ = '\n';
+        }
+    }
+    *out++ = '\n';
+    return out;
+}
+
+// -------------------------------------------------
+// 3. RUN-LENGTH TRIANGLES
+// -------------------------------------------------
+
+/*
+ * A pattern stored as runs of identical cells
+ *
+ * Row r is runs[rowStarts[r] .. rowStarts[r + 1]), each run being `count` copies of cells[cell].
+ * The star triangles need at most two runs per row ("  " then "* " or the reverse) and
+ * left_triangle_numbers needs one ("i " repeated i times), so memory is O(n) instead of O(n^2).
+ */
+class RunLengthPattern {
+private:
+    struct Run {
+        uint32_t cell;
+        uint32_t count;
+    };
+
+    vector<string> cells;
+    vector<Run> runs;
+    vector<uint32_t> rowStarts;
+    uint64_t expandedBytes;
+
+    void addRun(uint32_t cell, uint64_t count) {
+        if (count == 0) return;
+        Run run = {cell, uint32_t(count)};
+        runs.push_back(run);
+        expandedBytes += cells[cell].size() * count;
+    }
+
+    void endRow() {
+        rowStarts.push_back(uint32_t(runs.size()));
+        expandedBytes += 1;
+    }
+
+public:
+    // Returns: false if the pattern is not one of the triangle shapes
+    bool build(Pattern pattern, uint64_t n) {
+        cells.clear();
+        runs.clear();
+        rowStarts.assign(1, 0);
+        expandedBytes = 1;   // blank line after the pattern
+        const uint32_t BLANK = 0, STAR = 1;
+        switch (pattern) {
+            case Pattern::LEFT_TRIANGLE_STARS:
+                cells = {"  ", "* "};
+                for (uint64_t row = 1; row <= n; ++row) {
+                    addRun(STAR, row);
+                    endRow();
+                }
+                return true;
+            case Pattern::DIAGONAL_STARS:
+            case Pattern::RIGHT_TRIANGLE_STARS:
+                cells = {"  ", "* "};
+                for (uint64_t row = 1; row <= n; ++row) {
+                    addRun(BLANK, n - row);
+                    addRun(STAR, row);
+                    endRow();
+                }
+                return true;
+            case Pattern::V_SHAPE_STARS:
+                cells = {"  ", "* "};
+                for (uint64_t row = 1; row <= n; ++row) {
+                    addRun(BLANK, row - 1);
+                    addRun(STAR, n - row + 1);
+                    endRow();
+                }
+                return true;
+            case Pattern::LEFT_TRIANGLE_NUMBERS:
+                for (uint64_t row = 1; row <= n; ++row) {
+                    cells.push_back(to_string(row) + " ");
+                    addRun(uint32_t(row - 1), row);
+                    endRow();
+                }
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    size_t rows() const { return rowStarts.size() - 1; }
+    uint64_t expandedSize() const { return expandedBytes; }
+
+    uint64_t sizeInBytes() const {
+        uint64_t bytes = runs.capacity() * sizeof(Run) + rowStarts.capacity() * sizeof(uint32_t);
+        for (const string& cell : cells) bytes += sizeof(string) + cell.capacity();
+        return bytes;
+    }
+
+    // Expand every row (and the blank line) into out; out must hold expandedSize() bytes
+    char* expand(char* out) const {
+        for (size_t r = 0; r < rows(); ++r) {
+            for (uint32_t k = rowStarts[r]; k < rowStarts[r + 1]; ++k) {
+                const string& cell = cells[runs[k].cell];
+                for (uint32_t c = 0; c < runs[k].count; ++c) {
+                    memcpy(out, cell.data(), cell.size());
+                    out += cell.size();
+                }
+            }
+            *out++ = '\n';
+        }
+        *out++ = '\n';
+        return out;
+    }
+
+    // Write the pattern through writev. Runs of two-byte cells point into one repeated-cell buffer
+    // per cell, so the star triangles are written without expanding anything.
+    bool writeTo(int fd) const {
+        static const char NEWLINE = '\n';
+        uint64_t longestRun = 0;
+        for (const Run& run : runs) longestRun = max<uint64_t>(longestRun, run.count);
+        bool shareCells = cells.size() <= 2;
+        vector<string> repeated;
+        if (shareCells) {
+            for (const string& cell : cells) {
+                string text;
+                text.reserve(cell.size() * longestRun);
+                for (uint64_t c = 0; c < longestRun; ++c) text += cell;
+                repeated.push_back(move(text));
+            }
+        }
+
+        IovecWriter writer(fd);
+        string rowBuffer;
+        for (size_t r = 0; r < rows(); ++r) {
+            if (shareCells) {
+                for (uint32_t k = rowStarts[r]; k < rowStarts[r + 1]; ++k) {
+                    writer.add(repeated[runs[k].cell].data(), cells[runs[k].cell].size() * runs[k].count);
+                }
+                writer.add(&NEWLINE, 1);
+            } else {   // many distinct cells: expand one row at a time
+                rowBuffer.clear();
+                for (uint32_t k = rowStarts[r]; k < rowStarts[r + 1]; ++k) {
+                    for (uint32_t c = 0; c < runs[k].count; ++c) rowBuffer += cells[runs[k].cell];
+                }
+                rowBuffer += '\n';
+                writer.add(rowBuffer.data(), rowBuffer.size());
+                if (!writer.flush()) return false;
+            }
+        }
+        writer.add(&NEWLINE, 1);
+        return writer.flush();
+    }
+};
+
+// -------------------------------------------------
+// 4. VERIFICATION AND BENCHMARK
+// -------------------------------------------------
+
+using Clock = chrono::steady_clock;
+
+double elapsedSeconds(Clock::time_point start) {
+    return chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Capture what a writer function sends to a file descriptor
+template <typename WriteFunction>
+string capture(WriteFunction writeTo) {
+    FILE* file = tmpfile();
+    if (!file) return string();
+    int fd = fileno(file);
+    writeTo(fd);
+    string text(size_t(lseek(fd, 0, SEEK_END)), '\0');
+    lseek(fd, 0, SEEK_SET);
+    size_t done = 0;
+    while (done < text.size()) {
+        ssize_t count = read(fd, &text[done], text.size() - done);
+        if (count <= 0) break;
+        done += size_t(count);
+    }
+    fclose(file);
+    return text;
+}
+
+// Compare every reuse path with the reference renderer for several n
+bool verifyAgainstEngine() {
+    for (uint64_t n : {0, 1, 2, 7, 12, 101}) {
+        for (int p = 0; p < PATTERN_COUNT; ++p) {
+            Pattern pattern = pattern_at(p);
+            string expected(pattern_bytes(pattern, n), '\0');
+            render_pattern(pattern, n, &expected[0]);
+
+            string copied(expected.size(), '\0');
+            render_pattern_reusing(pattern, n, &copied[0]);
+            string viaWritev = capture([&](int fd) { write_pattern_shared(pattern, n, fd); });
+            bool ok = copied == expected && viaWritev == expected;
+
+            RunLengthPattern runLength;
+            if (runLength.build(pattern, n)) {
+                string expanded(runLength.expandedSize(), '\0');
+                runLength.expand(&expanded[0]);
+                string written = capture([&](int fd) { runLength.writeTo(fd); });
+                ok = ok && expanded == expected && written == expected;
+            }
+            if (!ok) {
+                cerr << "Mismatch between implementations! (" << pattern_name(pattern) << ", n = " << n << ")" << endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Returns: false if the output cannot be opened or written (reported through perror)
+bool runBenchmark(uint64_t n, const char* path) {
+    cout << "\n=== BENCHMARK: n = " << n << ", output " << path << " ===" << endl;
+    int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        perror(path);
+        return false;
+    }
+    // The full buffer is only needed for the patterns compared below, i.e. those with a reuse form
+    uint64_t largest = 0;
+    for (int p = 0; p < PATTERN_COUNT; ++p) {
+        Pattern pattern = pattern_at(p);
+        SharedRowPlan plan;
+        RunLengthPattern runLength;
+        if (plan.build(pattern, n) || runLength.build(pattern, n)) largest = max(largest, pattern_bytes(pattern, n));
+    }
+    unique_ptr<char[]> buffer(new char[largest]);
+
+    cout << "Pattern (times in ms)           MB    render+write  memcpy reuse  writev shared  shared KB"
+         << "  RLE write  RLE KB" << endl;
+    bool written = true;
+    for (int p = 0; written && p < PATTERN_COUNT; ++p) {
+        Pattern pattern = pattern_at(p);
+        SharedRowPlan plan;
+        RunLengthPattern runLength;
+        bool hasPlan = plan.build(pattern, n);
+        bool hasRuns = runLength.build(pattern, n);
+        if (!hasPlan && !hasRuns) continue;
+
+        auto start = Clock::now();
+        uint64_t bytes = uint64_t(render_pattern(pattern, n, buffer.get()) - buffer.get());
+        written = write_fully(fd, buffer.get(), bytes);
+        double fullMs = elapsedSeconds(start) * 1000;
+
+        start = Clock::now();
+        render_pattern_reusing(pattern, n, buffer.get());
+        written = written && write_fully(fd, buffer.get(), bytes);
+        double copyMs = elapsedSeconds(start) * 1000;
+
+        start = Clock::now();
+        written = written && write_pattern_shared(pattern, n, fd);
+        double sharedMs = elapsedSeconds(start) * 1000;
+
+        cout << pattern_name(pattern) << "  " << bytes / 1e6 << "  " << fullMs << "  " << copyMs << "  " << sharedMs;
+        if (hasPlan) {
+            cout << "  " << plan.sharedBytes() / 1e3;
+        } else {
+            cout << "  - (row by row)";
+        }
+        if (hasRuns) {
+            start = Clock::now();
+            written = written && runLength.writeTo(fd);
+            double runMs = elapsedSeconds(start) * 1000;
+            cout << "  " << runMs << "  " << runLength.sizeInBytes() / 1e3;
+        } else {
+            cout << "  -  -";
+        }
+        cout << endl;
+    }
+    if (!written) perror("write");
+    close(fd);
+    return written;
+}
+
+int main(int argc, char* argv[]) {
+    // Shared-row view of a small pattern
+    SharedRowPlan plan;
+    plan.build(Pattern::DIAGONAL_STARS, 4);
+    cout << "diagonal_stars for n = 4 as windows over one shared row:" << endl;
+    for (uint64_t row = 1; row <= 4; ++row) {
+        const char* data;
+        size_t length;
+        plan.window(row, data, length);
+        cout << string(data, length) << endl;
+    }
+
+    // Run-length view of a triangle
+    RunLengthPattern triangle;
+    triangle.build(Pattern::LEFT_TRIANGLE_NUMBERS, 5);
+    string text(triangle.expandedSize(), '\0');
+    triangle.expand(&text[0]);
+    cout << "\nleft_triangle_numbers for n = 5 expanded from " << triangle.rows() << " run-length rows:" << endl;
+    cout << text;
+
+    bool verified = verifyAgainstEngine();
+    cout << "Verification against pattern_engine.h: " << (verified ? "all identical" : "FAILED") << endl;
+    if (!verified) return 1;
+
+    uint64_t n = (argc > 1) ? strtoull(argv[1], nullptr, 10) : 2000;
+    const char* path = (argc > 2) ? argv[2] : "/dev/null";
+    if (!runBenchmark(n, path)) return 1;
+
+    return 0;
+}
@@ -0,0 +1,109 @@
+# RunBenchmarks.cmake - runs every benchmark registered with ds_add_benchmark()
+#
+# Invoked by the bench target:
+#   cmake -DBENCH_LIST=<bench_list.cmake> -DOUTPUT_DIR=<dir> -DSOURCE_DIR=<repo> -P RunBenchmarks.cmake
+#
+# Each benchmark runs in OUTPUT_DIR; its stdout goes to <name>.txt and stderr to <name>.err.
+# Every benchmark exits non-zero when one of its correctness checks fails, and prints the one
+# marker "Mismatch between implementations!" (optionally followed by details) to stderr.
+# The run is summarized in results.tsv (one row per benchmark) and results.json:
+#   name, exit code, wall seconds, and whether stderr contained the marker
+# clean_code_bench.txt is itself a TSV that clean_code_bench --compare accepts as a baseline.
+# The script fails (non-zero exit) when any benchmark exits non-zero; the marker alone also
+# counts as a failure, so a check that forgets its exit code is still caught.
+cmake_minimum_required(VERSION 3.23)
+
+foreach(required BENCH_LIST OUTPUT_DIR SOURCE_DIR)
+    if(NOT DEFINED ${required})
+        message(FATAL_ERROR "RunBenchmarks.cmake needs -D${required}=...")
+    endif()
+endforeach()
+
+include("${BENCH_LIST}")
+file(MAKE_DIRECTORY "${OUTPUT_DIR}")
+
+execute_process(COMMAND git rev-parse --short HEAD
+                WORKING_DIRECTORY "${SOURCE_DIR}"
+                OUTPUT_VARIABLE commit OUTPUT_STRIP_TRAILING_WHITESPACE
+                ERROR_QUIET RESULT_VARIABLE git_result)
+if(NOT git_result EQUAL 0)
+    set(commit "unknown")
+endif()
+string(TIMESTAMP started "%Y-%m-%dT%H:%M:%SZ" UTC)
+
+# Microseconds since the epoch
+function(now_us out)
+    string(TIMESTAMP seconds "%s" UTC)
+    string(TIMESTAMP micros "%f" UTC)
+    math(EXPR value "${seconds} * 1000000 + ${micros}")
+    set(${out} ${value} PARENT_SCOPE)
+endfunction()
+
+set(tsv "name\texit_code\twall_seconds\tmismatch\targuments\n")
+set(json_rows "")
+set(failures 0)
+
+foreach(name IN LISTS BENCHMARKS)
+    set(command ${BENCHMARK_COMMAND_${name}})
+    set(arguments ${command})
+    list(POP_FRONT arguments)
+    list(JOIN arguments " " argument_text)
+    message(STATUS "bench: ${name} ${argument_text}")
+
+    now_us(start)
+    execute_process(COMMAND ${command}
+                    WORKING_DIRECTORY "${OUTPUT_DIR}"
+                    OUTPUT_FILE "${OUTPUT_DIR}/${name}.txt"
+                    ERROR_FILE "${OUTPUT_DIR}/${name}.err"
+                    RESULT_VARIABLE exit_code)
+    now_us(stop)
+
+    math(EXPR elapsed_ms "(${stop} - ${start}) / 1000")
+    math(EXPR whole "${elapsed_ms} / 1000")
+    math(EXPR fraction "${elapsed_ms} % 1000")
+    string(LENGTH "${fraction}" digits)
+    if(digits EQUAL 1)
+        set(fraction "00${fraction}")
+    elseif(digits EQUAL 2)
+        set(fraction "0${fraction}")
+    endif()
+    set(seconds "${whole}.${fraction}")
+
+    file(READ "${OUTPUT_DIR}/${name}.err" errors)
+    string(FIND "${errors}" "Mismatch between implementations" found)
+    if(found GREATER_EQUAL 0)
+        set(mismatch true)
+    else()
+        set(mismatch false)
+    endif()
+
+    if(NOT exit_code STREQUAL "0" OR mismatch)
+        math(EXPR failures "${failures} + 1")
+        message(STATUS "bench: ${name} FAILED (exit ${exit_code}, mismatch ${mismatch})")
+    else()
+        message(STATUS "bench: ${name} ${seconds} s")
+    endif()
+
+    string(APPEND tsv "${name}\t${exit_code}\t${seconds}\t${mismatch}\t${argument_text}\n")
+    if(json_rows)
+        string(APPEND json_rows ",\n")
+    endif()
+    string(REPLACE "\"" "\\\"" json_arguments "${argument_text}")
+    if(exit_code MATCHES "^-?[0-9]+$")
+        set(json_exit "${exit_code}")
+    else()
+        set(json_exit "\"${exit_code}\"")   # e.g. "Segmentation fault"
+    endif()
+    string(APPEND json_rows "    {\"name\": \"${name}\", \"arguments\": \"${json_arguments}\", "
+                            "\"exit_code\": ${json_exit}, \"wall_seconds\": ${seconds}, "
+                            "\"mismatch\": ${mismatch}, \"stdout\": \"${name}.txt\"}")
+endforeach()
+
+file(WRITE "${OUTPUT_DIR}/results.tsv" "${tsv}")
+file(WRITE "${OUTPUT_DIR}/results.json"
+     "{\n  \"commit\": \"${commit}\",\n  \"started\": \"${started}\",\n  \"benchmarks\": [\n${json_rows}\n  ]\n}\n")
+message(STATUS "bench: results in ${OUTPUT_DIR}/results.tsv and results.json")
+
+if(failures GREATER 0)
+    message(FATAL_ERROR "${failures} benchmark(s) failed or reported a mismatch")
+endif()